@@ -0,0 +1,176 @@
+// Host benchmark for gauge load time: flattens large synthetic gauges with
+// the batch tessellator, serially and across a thread pool, next to a
+// reference that evaluates every sample with the Bernstein polynomial and
+// grows its vectors point by point, as load_gauge() used to.
+//
+// Usage: tessellation_bench [paths] [cubics_per_path] [workers]
+
+#include "digidash/gauge_scene.h"
+#include "digidash/path_tessellator.h"
+#include "digidash/task_executor.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace digidash;
+
+namespace {
+
+constexpr float kTolerance = 0.2f;
+constexpr int kRepeats = 5;
+
+PathCommand command(PathCommand::Type type, float x1 = 0, float y1 = 0, float x2 = 0, float y2 = 0,
+                    float x3 = 0, float y3 = 0) {
+    PathCommand cmd;
+    cmd.type = type;
+    cmd.x1 = x1; cmd.y1 = y1;
+    cmd.x2 = x2; cmd.y2 = y2;
+    cmd.x3 = x3; cmd.y3 = y3;
+    return cmd;
+}
+
+// Concentric wavy rings of cubics on a 2000-unit canvas
+BinaryGaugeLoader::GaugeAsset make_asset(int path_count, int cubics_per_path) {
+    BinaryGaugeLoader::GaugeAsset asset;
+    asset.name = "bench";
+    asset.width = 2000;
+    asset.height = 2000;
+    for (int p = 0; p < path_count; ++p) {
+        Path path;
+        path.id = "path_" + std::to_string(p);
+        path.stroke = {2.0f, {200, 200, 200, 255}, StrokeLineCap::Butt};
+        path.fill = {(p % 2) == 0, {40, 40, 60, 255}};
+        const float radius = 100.0f + 880.0f * static_cast<float>(p) / static_cast<float>(path_count);
+        const float sweep = 6.2831853f / static_cast<float>(cubics_per_path);
+        const float k = 4.0f / 3.0f * std::tan(sweep / 4.0f);
+        auto r_at = [&](int i) { return radius * (1.0f + 0.05f * ((i % 2) ? 1.0f : -1.0f)); };
+        path.commands.push_back(command(PathCommand::Type::MoveTo, 1000.0f + r_at(0), 1000.0f));
+        for (int i = 0; i < cubics_per_path; ++i) {
+            const float a0 = sweep * i, a1 = a0 + sweep;
+            const float r0 = r_at(i), r1 = r_at(i + 1);
+            path.commands.push_back(command(PathCommand::Type::CubicTo,
+                1000.0f + r0 * (std::cos(a0) - k * std::sin(a0)), 1000.0f + r0 * (std::sin(a0) + k * std::cos(a0)),
+                1000.0f + r1 * (std::cos(a1) + k * std::sin(a1)), 1000.0f + r1 * (std::sin(a1) - k * std::cos(a1)),
+                1000.0f + r1 * std::cos(a1), 1000.0f + r1 * std::sin(a1)));
+        }
+        path.commands.push_back(command(PathCommand::Type::Close));
+        asset.paths.push_back(std::move(path));
+    }
+    return asset;
+}
+
+// The pre-batch approach: Bernstein per sample, one growing vector per path
+size_t bernstein_reference(const BinaryGaugeLoader::GaugeAsset& asset, const TessellationTransform& transform,
+                           std::vector<std::vector<VectorRenderer::Point>>& out) {
+    size_t total = 0;
+    out.clear();
+    for (const auto& path : asset.paths) {
+        std::vector<VectorRenderer::Point> points;
+        VectorRenderer::Point current = transform.apply(0.0f, 0.0f);
+        VectorRenderer::Point first = current;
+        for (const auto& cmd : path.commands) {
+            if (cmd.type == PathCommand::Type::MoveTo || cmd.type == PathCommand::Type::LineTo) {
+                current = transform.apply(cmd.x1, cmd.y1);
+                if (cmd.type == PathCommand::Type::MoveTo) {
+                    first = current;
+                }
+                points.push_back(current);
+            } else if (cmd.type == PathCommand::Type::CubicTo) {
+                const VectorRenderer::Point p0 = current;
+                const VectorRenderer::Point p1 = transform.apply(cmd.x1, cmd.y1);
+                const VectorRenderer::Point p2 = transform.apply(cmd.x2, cmd.y2);
+                const VectorRenderer::Point p3 = transform.apply(cmd.x3, cmd.y3);
+                const int segments = cubic_segment_count(p0, p1, p2, p3, kTolerance);
+                for (int s = 1; s <= segments; ++s) {
+                    const float t = static_cast<float>(s) / static_cast<float>(segments);
+                    const float mt = 1.0f - t;
+                    points.push_back({mt * mt * mt * p0.x + 3.0f * mt * mt * t * p1.x + 3.0f * mt * t * t * p2.x + t * t * t * p3.x,
+                                      mt * mt * mt * p0.y + 3.0f * mt * mt * t * p1.y + 3.0f * mt * t * t * p2.y + t * t * t * p3.y});
+                }
+                current = p3;
+            } else if (!points.empty()) {
+                points.push_back(first);
+                current = first;
+            }
+        }
+        total += points.size();
+        out.push_back(std::move(points));
+    }
+    return total;
+}
+
+template <typename Fn>
+double best_ms(Fn&& fn) {
+    double best = 1e30;
+    for (int i = 0; i < kRepeats; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        const auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int path_count = (argc > 1) ? std::atoi(argv[1]) : 2000;
+    const int cubics_per_path = (argc > 2) ? std::atoi(argv[2]) : 16;
+    const size_t workers = (argc > 3) ? static_cast<size_t>(std::atoi(argv[3])) : 0;
+
+    const auto asset = make_asset(path_count, cubics_per_path);
+    ThreadPoolTaskExecutor pool(workers);
+
+    // Flatten for a 480 px display, as the firmware does
+    TessellationTransform transform;
+    transform.scale = 480.0f / 2000.0f;
+
+    std::vector<PathCommand> commands;
+    std::vector<TessellationRange> ranges;
+    for (const auto& path : asset.paths) {
+        ranges.push_back({static_cast<uint32_t>(commands.size()), static_cast<uint32_t>(path.commands.size()),
+                          0, 0, 0, 0});
+        commands.insert(commands.end(), path.commands.begin(), path.commands.end());
+    }
+
+    std::vector<std::vector<VectorRenderer::Point>> reference;
+    std::vector<VectorRenderer::Point> points;
+    std::vector<uint32_t> contours;
+    size_t reference_points = 0;
+
+    const double reference_ms = best_ms([&] { reference_points = bernstein_reference(asset, transform, reference); });
+    const double serial_ms = best_ms([&] {
+        tessellate_paths(commands.data(), ranges.data(), ranges.size(), transform, kTolerance, points, contours);
+    });
+    const double parallel_ms = best_ms([&] {
+        tessellate_paths(commands.data(), ranges.data(), ranges.size(), transform, kTolerance, points, contours,
+                         &pool);
+    });
+
+    // Whole-scene load for the same gauge, where flattening is one part.
+    // The viewport is set first, as the renderers do, so it flattens once.
+    const double load_serial_ms = best_ms([&] {
+        GaugeScene scene;
+        scene.set_viewport(480, 480);
+        scene.load_gauge(asset);
+    });
+    const double load_parallel_ms = best_ms([&] {
+        GaugeScene scene;
+        scene.set_task_executor(&pool);
+        scene.set_viewport(480, 480);
+        scene.load_gauge(asset);
+    });
+
+    std::printf("%d paths x %d cubics, %zu points (reference %zu), %zu workers\n", path_count, cubics_per_path,
+                points.size(), reference_points, pool.worker_count());
+    std::printf("  bernstein reference   %8.2f ms\n", reference_ms);
+    std::printf("  batch, 1 thread       %8.2f ms\n", serial_ms);
+    std::printf("  batch, thread pool    %8.2f ms\n", parallel_ms);
+    std::printf("  scene load, 1 thread  %8.2f ms\n", load_serial_ms);
+    std::printf("  scene load, pool      %8.2f ms\n", load_parallel_ms);
+    return 0;
+}
@@ -1,8 +1,12 @@
 #pragma once
 
+#include "gauge_format.h"
+#include "mapped_file.h"
 #include "types.h"
+#include "vector_renderer.h"
 #include <vector>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <cstdint>
 
@@ -48,6 +52,80 @@ struct PathAnimationBinding {
     std::string pid_name;
 };
 
+/**
+ * @brief Static (non-animated) layer pre-rendered at one display size
+ *
+ * Written by svg_preprocessor: the gauge's static paths rendered over
+ * black, converted to RGB565 and compressed with rle565_encode().
+ */
+struct StaticLayer {
+    uint16_t width;
+    uint16_t height;
+    std::vector<uint8_t> rle565;
+};
+
+/**
+ * @brief One path's run of pre-flattened points and contours in a GaugeView
+ */
+struct FlattenedPathRange {
+    uint32_t point_offset;      // Into GaugeView::flattened_points
+    uint32_t point_count;
+    uint32_t contour_offset;    // Into GaugeView::flattened_contours
+    uint32_t contour_count;
+};
+
+/**
+ * @brief Read-only view of a sectioned (v3) gauge over its file bytes
+ *
+ * Arrays point straight into the buffer given to
+ * BinaryGaugeLoader::map_view(), which has checked every offset, count and
+ * string reference, so nothing here is copied or needs checking again.
+ * Valid while that buffer is.
+ *
+ * Views written by svg_preprocessor --embed also carry the paths already
+ * flattened to flattened_width x flattened_height display pixels; gauge
+ * files leave those arrays null.
+ */
+struct GaugeView {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    const gauge_format::PathRecord* paths = nullptr;
+    size_t path_count = 0;
+    const PathCommand* commands = nullptr;
+    size_t command_count = 0;
+    const gauge_format::AnimationRecord* animations = nullptr;
+    size_t animation_count = 0;
+    const char* strings = nullptr;
+    size_t strings_size = 0;
+    const gauge_format::StaticLayerRecord* static_layers = nullptr;
+    size_t static_layer_count = 0;
+    const uint8_t* static_layer_data = nullptr;
+    size_t static_layer_data_size = 0;
+    uint32_t flattened_width = 0;
+    uint32_t flattened_height = 0;
+    const FlattenedPathRange* flattened_paths = nullptr;    // One per path
+    const VectorRenderer::Point* flattened_points = nullptr;
+    size_t flattened_point_count = 0;
+    const uint32_t* flattened_contours = nullptr;           // Contour starts, relative to each path
+    size_t flattened_contour_count = 0;
+
+    std::string_view string(const gauge_format::StringRef& ref) const {
+        return std::string_view(strings + ref.offset, ref.length);
+    }
+
+    /**
+     * @brief Pre-rendered static layer for exactly @p width x @p height, or null
+     */
+    const gauge_format::StaticLayerRecord* find_static_layer(uint32_t width, uint32_t height) const {
+        for (size_t i = 0; i < static_layer_count; ++i) {
+            if (static_layers[i].width == width && static_layers[i].height == height) {
+                return &static_layers[i];
+            }
+        }
+        return nullptr;
+    }
+};
+
 /**
  * @brief Loads binary gauge asset files
  * 
@@ -56,6 +134,7 @@ struct PathAnimationBinding {
  * - Animation definitions
  * - PID bindings
  * - Metadata
+ * - Optionally, the static layer pre-rendered at one or more display sizes
  */
 class BinaryGaugeLoader {
 public:
@@ -67,6 +146,7 @@ public:
         std::vector<PathAnimationBinding> path_animations;
         std::vector<uint8_t> animation_data;
         std::vector<uint8_t> pid_binding_data;
+        std::vector<StaticLayer> static_layers;
     };
 
     BinaryGaugeLoader();
@@ -74,19 +154,53 @@ public:
 
     /**
      * @brief Load a gauge from a binary file
+     *
+     * The file is mapped rather than read into a buffer; see map_file()
+     * to keep using it in place.
      */
     bool load_from_file(const std::string& filepath, GaugeAsset& asset_out);
 
+    /**
+     * @brief Map a v3 gauge file and view it without copying
+     *
+     * The host counterpart of a flash-mapped gauge partition. @p view_out
+     * stays valid while @p file_out holds the mapping.
+     */
+    bool map_file(const std::string& filepath, MappedFile& file_out, GaugeView& view_out);
+
     /**
      * @brief Load a gauge from memory buffer
+     *
+     * Reads every format version; v3 files are copied out of a GaugeView.
      */
     bool load_from_buffer(const uint8_t* buffer, size_t buffer_size, 
                           GaugeAsset& asset_out);
 
+    /**
+     * @brief Map a v3 gauge without copying it
+     *
+     * @p buffer must be 4-byte aligned, as heap and mapped flash are.
+     * Fails for v1/v2 files, which load_from_buffer() still reads.
+     */
+    bool map_view(const uint8_t* buffer, size_t buffer_size, GaugeView& view_out);
+
+    /**
+     * @brief Check every string, command, static layer and flattened range of @p view
+     *
+     * Only counts and sizes are used, so a view whose bulk sections are not
+     * resident yet (see GaugeStreamReader) can be checked too.
+     */
+    static bool validate_view(const GaugeView& view);
+
     /**
      * @brief Validate gauge asset integrity
      */
     bool validate_asset(const GaugeAsset& asset);
+
+    /**
+     * @brief Pre-rendered static layer baked for exactly @p width x @p height, or null
+     */
+    static const StaticLayer* find_static_layer(const GaugeAsset& asset, uint32_t width, uint32_t height);
 };
 
 } // namespace digidash
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "types.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace digidash {
+
+/**
+ * @brief Works out which pixels of a recycled back buffer must be redrawn
+ *
+ * With buffer_count framebuffers in rotation, the buffer handed out for a
+ * frame still shows the frame drawn buffer_count frames earlier. It is
+ * therefore missing the scene damage of this frame and the previous
+ * buffer_count - 1 frames, and still carries whatever overlay was drawn on
+ * top of it back then. The tracker keeps that history and produces a small
+ * set of disjoint rectangles covering all of it.
+ */
+class DamageTracker {
+public:
+    explicit DamageTracker(uint32_t buffer_count = 2);
+
+    /**
+     * @brief Forget all history for a width x height frame
+     *
+     * The next buffer_count frames are damaged in full, since the contents
+     * of every buffer are unknown.
+     */
+    void reset(int width, int height);
+
+    /**
+     * @brief Start a frame from the scene damage since the previous frame
+     *
+     * Computes rects() for @p buffer, the back buffer about to be drawn. If
+     * it is not the buffer drawn buffer_count frames ago (the display skipped
+     * or repeated a swap), the history does not describe it and the whole
+     * frame is damaged.
+     */
+    void begin_frame(const std::vector<PixelRect>& scene_damage, const void* buffer = nullptr);
+
+    /**
+     * @brief Record a region drawn over the current frame after compositing
+     */
+    void add_overlay(const PixelRect& rect);
+
+    /**
+     * @brief Disjoint rectangles to redraw this frame
+     */
+    const std::vector<PixelRect>& rects() const { return rects_; }
+
+    /**
+     * @brief Append this frame's rectangles clipped to rows [y, y + height)
+     */
+    void rects_in_band(int y, int height, std::vector<PixelRect>& out) const;
+
+    /**
+     * @brief Number of pixels to redraw this frame
+     */
+    uint32_t area() const;
+
+private:
+    struct FrameRecord {
+        std::vector<PixelRect> damage;
+        std::vector<PixelRect> overlay;
+        const void* buffer = nullptr;
+    };
+
+    void add_clipped(const PixelRect& rect);
+    void merge_rects();
+
+    uint32_t buffer_count_;
+    int width_;
+    int height_;
+    std::vector<FrameRecord> history_;   // Ring of the last buffer_count frames
+    size_t current_;                      // Slot of the frame being drawn
+    std::vector<PixelRect> rects_;
+};
+
+} // namespace digidash
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace digidash {
+
+/**
+ * @brief Bump allocator for data that lives for exactly one frame
+ *
+ * Allocations are carved out of one block and released all at once by
+ * reset(). A frame that needs more than the block holds is served from
+ * overflow blocks; the next reset() folds them into a block big enough for
+ * that frame, so a scene with a stable working set stops touching the heap
+ * after its first frames.
+ */
+class FrameArena {
+public:
+    explicit FrameArena(size_t capacity_bytes = 0);
+
+    /**
+     * @brief Make room for @p bytes per frame; drops all allocations
+     */
+    void reserve(size_t bytes);
+
+    /**
+     * @brief Release every allocation made since the previous reset
+     */
+    void reset();
+
+    /**
+     * @brief Uninitialized storage for @p count objects of trivial type T
+     */
+    template <typename T>
+    T* allocate(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena never runs destructors");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported");
+        return static_cast<T*>(allocate_bytes(count * sizeof(T), alignof(T)));
+    }
+
+    size_t capacity() const { return block_.size() * sizeof(std::max_align_t); }
+    size_t used() const { return used_ + overflow_bytes_; }
+
+private:
+    void* allocate_bytes(size_t bytes, size_t alignment);
+
+    std::vector<std::max_align_t> block_;
+    size_t used_;
+    std::vector<std::unique_ptr<std::max_align_t[]>> overflow_;
+    size_t overflow_bytes_;
+};
+
+} // namespace digidash
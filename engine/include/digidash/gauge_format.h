@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+
+namespace digidash {
+
+/**
+ * @brief On-disk layout of sectioned (v3) gauge files
+ *
+ * A FileHeader, a table of SectionEntry, then the sections. Every section
+ * starts on an 8-byte boundary and is a flat array of the records below,
+ * so a loader can point straight into the file bytes (see GaugeView).
+ * Strings live in one table and are referenced by StringRef. All values
+ * are little-endian; readers skip sections they do not know.
+ *
+ * This header only uses fixed-width integers so the svg_preprocessor can
+ * write the format without pulling in engine types.
+ */
+namespace gauge_format {
+
+constexpr uint32_t kMagic = 0x45474744;     // "DGGE", shared with v1/v2
+constexpr uint16_t kSectionedVersion = 3;
+constexpr uint32_t kSectionAlignment = 8;
+
+enum class SectionId : uint32_t {
+    Paths = 1,              // PathRecord[]
+    Commands = 2,           // CommandRecord[], each path's run contiguous
+    Animations = 3,         // AnimationRecord[]
+    Strings = 4,            // UTF-8 bytes, not terminated
+    StaticLayers = 5,       // StaticLayerRecord[]
+    StaticLayerData = 6     // RLE RGB565 streams (rle565_encode)
+};
+
+struct FileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t section_count;
+    uint32_t width;
+    uint32_t height;
+};
+
+struct SectionEntry {
+    uint32_t id;            // SectionId
+    uint32_t offset;        // From the start of the file, kSectionAlignment aligned
+    uint32_t size;          // Bytes
+    uint32_t reserved;
+};
+
+struct StringRef {
+    uint32_t offset;        // Into the Strings section
+    uint32_t length;
+};
+
+struct PathRecord {
+    StringRef id;
+    uint32_t command_offset;    // Into the Commands section, in records
+    uint32_t command_count;
+    float stroke_width;
+    uint8_t stroke_rgba[4];
+    uint8_t fill_rgba[4];
+    uint8_t stroke_cap;         // StrokeLineCap
+    uint8_t fill_enabled;
+    uint8_t reserved[2];
+};
+
+/**
+ * @brief One path command; the same layout as the engine's PathCommand
+ */
+struct CommandRecord {
+    uint8_t type;           // PathCommand::Type
+    uint8_t reserved[3];
+    float x1, y1;
+    float x2, y2;
+    float x3, y3;
+};
+
+struct AnimationRecord {
+    StringRef path_id;
+    StringRef pid_name;
+    uint8_t type;           // PathAnimationBinding::Type
+    uint8_t reserved[3];
+    float min_value;
+    float max_value;
+};
+
+struct StaticLayerRecord {
+    uint16_t width;
+    uint16_t height;
+    uint32_t data_offset;   // Into the StaticLayerData section
+    uint32_t data_size;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(FileHeader) == 16, "FileHeader layout");
+static_assert(sizeof(SectionEntry) == 16, "SectionEntry layout");
+static_assert(sizeof(PathRecord) == 32, "PathRecord layout");
+static_assert(sizeof(CommandRecord) == 28, "CommandRecord layout");
+static_assert(sizeof(AnimationRecord) == 28, "AnimationRecord layout");
+static_assert(sizeof(StaticLayerRecord) == 16, "StaticLayerRecord layout");
+
+} // namespace gauge_format
+} // namespace digidash
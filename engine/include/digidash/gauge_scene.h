@@ -4,15 +4,23 @@
 #include "binary_gauge_loader.h"
 #include "animation_engine.h"
 #include "pid_binding_system.h"
+#include "spatial_grid.h"
+#include "frame_arena.h"
+#include "path_tessellator.h"
+#include "task_executor.h"
 
+#include <algorithm>
 #include <memory>
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 
 namespace digidash {
 
+class GaugeStreamReader;
+
 /**
  * @brief Main gauge scene manager
  * 
@@ -21,14 +29,89 @@ namespace digidash {
  */
 class GaugeScene {
 public:
+    /**
+     * @brief Per-thread scratch state for rendering
+     *
+     * The render calls that take a context only read scene state, so several
+     * threads may render disjoint tiles at once provided each uses its own
+     * context. update(), set_viewport() and load_gauge() must not run
+     * concurrently with them.
+     */
+    struct RenderContext {
+        VectorRenderer renderer;
+        std::vector<uint32_t> visible_paths;
+        std::vector<uint8_t> sweep_coverage;    // One row of swept coverage
+    };
+
+    /**
+     * @brief How trim-sweep animations are drawn
+     */
+    enum class SweepRenderMode : uint8_t {
+        Geometry = 0,       // Trim the polyline and rasterize it every frame
+        ParameterMap = 1    // Mask cached coverage by a per-pixel arc parameter
+    };
+
+    /**
+     * @brief How display-space points are stored
+     */
+    enum class PointEncoding : uint8_t {
+        Float32 = 0,        // Exact viewport coordinates
+        Fixed12_4 = 1       // int16 with 1/16 pixel steps, half the memory
+    };
+
+    /**
+     * @brief Where a loaded GaugeView's path commands are read from
+     */
+    enum class CommandStorage : uint8_t {
+        Copy = 0,           // Copied into the scene; the view may go away
+        Borrow = 1          // Read in place; the view must outlive the scene
+    };
+
     GaugeScene();
+
+    /**
+     * @brief Scene over a gauge compiled into the program
+     *
+     * For the constexpr view written by svg_preprocessor --embed: its arrays
+     * live as long as the program, so they are borrowed as they are. The
+     * viewport starts at the size the view was flattened for, where its
+     * flattened points are drawn straight from the view with nothing
+     * flattened or copied; another viewport flattens its commands as usual.
+     */
+    explicit GaugeScene(const GaugeView& embedded);
+
     ~GaugeScene();
 
     /**
      * @brief Load a gauge asset and initialize the scene
+     *
+     * Paths are flattened here only if a viewport is already set. Otherwise
+     * set_viewport() flattens them, or failing that the first update() does
+     * at the gauge's own units; nothing is drawn until then. The same holds
+     * for every load_gauge() overload, so set the viewport first to have the
+     * load itself flatten once, straight at the display size.
      */
     bool load_gauge(const BinaryGaugeLoader::GaugeAsset& asset);
 
+    /**
+     * @brief Load a mapped v3 gauge
+     *
+     * By default path commands are copied once, in bulk, into the scene's
+     * own pool, so the view's bytes may be released afterwards. Borrowing
+     * suits bytes mapped for the program's lifetime, such as a flash
+     * partition: the commands then take no RAM at all.
+     */
+    bool load_gauge(const GaugeView& view, CommandStorage storage = CommandStorage::Copy);
+
+    /**
+     * @brief Load a v3 gauge from an opened stream
+     *
+     * Commands are read from @p reader straight into the scene's pool, so
+     * the file is never buffered. Static layers are left unread for the
+     * caller. On a short read the scene is left empty.
+     */
+    bool load_gauge(GaugeStreamReader& reader);
+
     /**
      * @brief Update scene state (animations, data bindings)
      */
@@ -41,24 +124,65 @@ public:
      * @param height Height of the target buffer (tile height)
      * @param stride Byte stride of the target buffer
      * @param y_offset Y offset in the full gauge coordinate space (for tiled rendering)
+     * @param format Pixel layout of the target buffer
      */
-    void render(uint8_t* target_buffer, int width, int height, int stride, int y_offset = 0);
+    void render(uint8_t* target_buffer, int width, int height, int stride, int y_offset = 0,
+                PixelFormat format = PixelFormat::RGBA8888);
 
     /**
      * @brief Render only static (non-animated) paths
      */
-    void render_static(uint8_t* target_buffer, int width, int height, int stride, int y_offset = 0);
+    void render_static(uint8_t* target_buffer, int width, int height, int stride, int y_offset = 0,
+                       PixelFormat format = PixelFormat::RGBA8888);
 
     /**
      * @brief Render only dynamic (animated) paths
      */
-    void render_dynamic(uint8_t* target_buffer, int width, int height, int stride, int y_offset = 0);
+    void render_dynamic(uint8_t* target_buffer, int width, int height, int stride, int y_offset = 0,
+                        PixelFormat format = PixelFormat::RGBA8888);
+
+    /**
+     * @brief Thread-safe variants of render(), render_static() and render_dynamic()
+     *
+     * Identical output, but all scratch state lives in @p context.
+     */
+    void render(RenderContext& context, uint8_t* target_buffer, int width, int height, int stride,
+                int y_offset = 0, PixelFormat format = PixelFormat::RGBA8888) const;
+    void render_static(RenderContext& context, uint8_t* target_buffer, int width, int height, int stride,
+                       int y_offset = 0, PixelFormat format = PixelFormat::RGBA8888) const;
+    void render_dynamic(RenderContext& context, uint8_t* target_buffer, int width, int height, int stride,
+                        int y_offset = 0, PixelFormat format = PixelFormat::RGBA8888) const;
+
+    /**
+     * @brief Render dynamic paths into one rectangle of a tile
+     *
+     * Buffer arguments are as for render_dynamic(); only pixels inside
+     * @p rect (viewport coordinates) are written, and they come out exactly
+     * as a full render_dynamic() would produce them.
+     */
+    void render_dynamic_rect(RenderContext& context, const PixelRect& rect, uint8_t* target_buffer,
+                             int width, int height, int stride, int y_offset = 0,
+                             PixelFormat format = PixelFormat::RGBA8888) const;
+
+    /**
+     * @brief Append the regions changed since the previous call to @p out
+     *
+     * A trim sweep contributes the bounds of the arc between its old and new
+     * cut, or the union of its old and new bounds after a large jump; loading,
+     * a new viewport or a new quality tier damage everything affected. Rectangles are in viewport pixels and may overlap.
+     */
+    void take_damage(std::vector<PixelRect>& out);
 
     /**
      * @brief Return whether any dynamic (animated) paths intersect the given region
      */
     bool has_dynamic_in_region(int y_offset, int height) const;
 
+    /**
+     * @brief Return whether any dynamic paths intersect the given rectangle
+     */
+    bool has_dynamic_in_rect(int x, int y, int width, int height) const;
+
     /**
      * @brief Set PID data value
      */
@@ -66,14 +190,124 @@ public:
 
     /**
      * @brief Set renderer quality level for adaptive performance tuning
+     *
+     * Takes a RenderQuality tier. Supersampling applies to dynamic paths
+     * only; static paths are capped at Analytic.
      */
     void set_render_quality(int quality_level);
 
+    /**
+     * @brief Current render quality tier
+     */
+    int get_render_quality() const { return render_quality_; }
+
+    /**
+     * @brief Select how trim-sweep animations are drawn
+     *
+     * ParameterMap rasterizes each full sweep once per viewport into cached
+     * coverage plus a 16-bit arc parameter per pixel; a frame then only
+     * compares that parameter against the current ratio. The moving end is
+     * cut square with a one-pixel anti-aliased edge instead of the path's
+     * cap, and coverage keeps the quality tier it was baked at.
+     */
+    void set_sweep_render_mode(SweepRenderMode mode);
+
+    SweepRenderMode get_sweep_render_mode() const { return sweep_render_mode_; }
+
+    /**
+     * @brief Select the storage of display-space points
+     *
+     * Fixed12_4 snaps every point to 1/16 pixel. A viewport whose paths do
+     * not fit +-2047 pixels keeps Float32 storage whatever is selected.
+     */
+    void set_point_encoding(PointEncoding encoding);
+
+    PointEncoding get_point_encoding() const { return point_encoding_; }
+
+    /**
+     * @brief Largest distance simplification may move a path, in viewport pixels
+     *
+     * Flattened paths are simplified once per viewport: collinear runs and
+     * sub-pixel jitter are dropped, keeping contour ends and closure. Adds
+     * to the 0.2 pixel flattening error; 0 keeps every flattened point.
+     * Takes effect at the next load_gauge() or set_viewport().
+     */
+    void set_simplify_tolerance(float pixels) { simplify_tolerance_ = std::max(pixels, 0.0f); }
+
+    float get_simplify_tolerance() const { return simplify_tolerance_; }
+
+    /**
+     * @brief Skip flattening static paths, which the caller draws from a baked layer
+     *
+     * For a display seeded from a StaticLayer of the asset. The fit to the
+     * viewport still covers every path, so dynamic paths line up with the
+     * baked pixels; render_static() then draws nothing. Takes effect at the
+     * next load_gauge() or set_viewport().
+     */
+    void set_static_layer_baked(bool baked) { static_layer_baked_ = baked; }
+
+    bool get_static_layer_baked() const { return static_layer_baked_; }
+
+    /**
+     * @brief Spread curve flattening across @p executor's workers
+     *
+     * Used by load_gauge() and set_viewport(); null flattens on the calling
+     * thread. The executor must outlive the scene or be reset first.
+     */
+    void set_task_executor(TaskExecutor* executor) { executor_ = executor; }
+
+    /**
+     * @brief Offer flattened paths saved by save_tessellation(), usually on an earlier boot
+     *
+     * Whenever the paths would be flattened (load_gauge(), set_viewport(),
+     * set_point_encoding()) the blob's key is checked first: a hash of the
+     * loaded paths and animations, the viewport, the point encoding, the
+     * flattening and simplification tolerances, the static layer flag and
+     * the engine's cache version. On a match the points, contours and
+     * bounds are copied from the blob; otherwise, or if it is damaged, the
+     * paths are flattened as usual. @p data must stay valid while offered;
+     * pass null to withdraw it.
+     */
+    void set_tessellation_cache(const uint8_t* data, size_t size) {
+        tessellation_cache_ = data;
+        tessellation_cache_size_ = data ? size : 0;
+    }
+
+    /**
+     * @brief Whether the current flattened paths were copied from the offered cache
+     */
+    bool is_tessellation_cached() const { return tessellation_cached_; }
+
+    /**
+     * @brief Write the current flattened paths, with their key, to @p out
+     *
+     * @return false if no gauge is loaded or its geometry is borrowed
+     */
+    bool save_tessellation(std::vector<uint8_t>& out) const;
+
     /**
      * @brief Set target viewport used to fit the gauge onto the display
+     *
+     * Curves are flattened after the fit, to within 0.2 pixel of the
+     * viewport, so the point count follows the display size rather than the
+     * units the gauge was authored in.
      */
     void set_viewport(uint32_t viewport_width, uint32_t viewport_height);
 
+    /**
+     * @brief Number of points the paths are flattened to at this viewport
+     */
+    size_t get_point_count() const { return display_points_.size() + display_fixed_points_.size(); }
+
+    /**
+     * @brief Whether the paths are drawn from a borrowed view's pre-flattened points
+     *
+     * Then no points are held (get_point_count() is 0), point encoding and
+     * simplify tolerance do not apply, and save_tessellation() has nothing
+     * to save.
+     */
+    bool is_geometry_borrowed() const { return geometry_borrowed_; }
+
     /**
      * @brief Get current width of the gauge
      */
@@ -85,6 +319,18 @@ public:
     uint32_t get_height() const { return height_; }
 
 private:
+    /**
+     * @brief Style of one path; its geometry is the matching path_ranges_ entry
+     */
+    struct PathRecord {
+        uint32_t color;
+        float stroke_width;
+        bool is_filled;
+        StrokeLineCap stroke_cap;
+        FillRule fill_rule;
+        uint32_t source_index;  // Index in the loaded gauge; paths without points are dropped
+    };
+
     struct RuntimePathAnimation {
         size_t path_index;
         float min_value;
@@ -95,39 +341,130 @@ private:
         bool reverse;
     };
 
-    std::unique_ptr<VectorRenderer> renderer_;
+    /**
+     * @brief Trim-sweep geometry of an animated path, built once per viewport
+     *
+     * Points are cleaned of the closing duplicate and zero-length segments
+     * and ordered in sweep direction; distance holds the cumulative arc
+     * length at each point.
+     */
+    struct SweepPolyline {
+        std::vector<VectorRenderer::Point> points;
+        std::vector<float> distance;
+    };
+
+    /**
+     * @brief This frame's trim of a sweep, stored in the frame arena
+     */
+    struct PreparedSweep {
+        const VectorRenderer::Point* points = nullptr;
+        size_t count = 0;
+    };
+
+    /**
+     * @brief Horizontal run of pixels covered by a full sweep
+     */
+    struct SweepRun {
+        int16_t x;
+        uint16_t length;
+        uint16_t t_min;     // Smallest arc parameter in the run
+        uint32_t offset;    // Into SweepMap::coverage / SweepMap::t
+    };
+
+    /**
+     * @brief Cached coverage and arc parameter of a full sweep
+     */
+    struct SweepMap {
+        int y0 = 0;
+        std::vector<uint32_t> row_runs;     // First run of each row from y0, plus an end marker
+        std::vector<SweepRun> runs;
+        std::vector<uint8_t> coverage;
+        std::vector<uint16_t> t;            // Arc length / total, scaled to 0..65535
+        float length = 0.0f;                // Total arc length in pixels
+    };
+
+    std::unique_ptr<RenderContext> default_context_;
     std::unique_ptr<AnimationEngine> animation_engine_;
     std::unique_ptr<PIDBindingSystem> pid_system_;
 
-    BinaryGaugeLoader::GaugeAsset current_asset_;
-    std::vector<std::string> path_ids_;
     std::vector<RuntimePathAnimation> runtime_animations_;
     std::unordered_map<std::string, uint32_t> pid_name_to_id_;
     std::unordered_set<uint32_t> seen_pid_ids_;
-    std::vector<VectorRenderer::BezierPath> paths_;
-    std::vector<VectorRenderer::BezierPath> transformed_paths_;
-    std::vector<VectorRenderer::BezierPath> prepared_paths_;
+    std::vector<PathRecord> path_records_;
+    std::vector<TessellationRange> path_ranges_;                // Into the pools below, refilled per viewport
+    std::vector<PathCommand> source_commands_;                  // Asset coordinates, unless borrowed
+    const PathCommand* commands_ = nullptr;                     // source_commands_ or a borrowed view
+    std::vector<uint32_t> contour_starts_;
+    std::vector<VectorRenderer::Point> display_points_;         // Viewport coordinates, Float32
+    std::vector<VectorRenderer::FixedPoint> display_fixed_points_;  // Viewport coordinates, Fixed12_4
     std::vector<int> animation_index_by_path_;
-    std::vector<float> transformed_min_y_;
-    std::vector<float> transformed_max_y_;
-    std::vector<float> prepared_min_y_;
-    std::vector<float> prepared_max_y_;
+    std::vector<PathBounds> transformed_bounds_;
+    std::vector<PathBounds> prepared_bounds_;
+    std::vector<SweepPolyline> sweep_polylines_;    // Empty for paths without a trim sweep
+    std::vector<PreparedSweep> prepared_sweeps_;    // Valid until the next prepare_frame_paths()
+    FrameArena frame_arena_;                        // Backs prepared_sweeps_
+    std::vector<SweepMap> sweep_maps_;              // ParameterMap mode only
+    SweepRenderMode sweep_render_mode_;
+    PointEncoding point_encoding_;
+    TaskExecutor* executor_;
+    float simplify_tolerance_;
+    bool static_layer_baked_;
+    const uint8_t* tessellation_cache_ = nullptr;  // Offered by set_tessellation_cache()
+    size_t tessellation_cache_size_ = 0;
+    bool tessellation_cached_ = false;
+    uint64_t gauge_hash_ = 0;                   // Of what the flattened paths depend on
+    const FlattenedPathRange* borrowed_ranges_ = nullptr;   // Pre-flattened geometry of a borrowed view
+    const VectorRenderer::Point* borrowed_points_ = nullptr;
+    const uint32_t* borrowed_contours_ = nullptr;
+    uint32_t borrowed_width_ = 0;               // Viewport the borrowed geometry is flattened for
+    uint32_t borrowed_height_ = 0;
+    bool geometry_borrowed_ = false;            // display_view() reads the borrowed arrays
+    bool geometry_pending_ = false;             // Loaded without a viewport, nothing flattened yet
+    std::vector<float> prepared_ratios_;   // Trim ratio behind each prepared path (NaN = none yet)
+    std::vector<PixelRect> damage_;
+    SpatialGrid path_index_;
+    int render_quality_;
     uint32_t animation_time_ms_;
     uint32_t width_;
     uint32_t height_;
     uint32_t viewport_width_;
     uint32_t viewport_height_;
 
+    void begin_load(uint32_t width, uint32_t height, size_t path_count, size_t command_count);
+    bool add_path(size_t source_index, const StrokeStyle& stroke, const FillStyle& fill, size_t command_offset,
+                  size_t command_count);
+    void add_view_paths(const GaugeView& view);
+    void bind_trim_sweep(const std::vector<std::string_view>& path_ids, std::string_view path_id,
+                         float min_value, float max_value, std::string_view pid_name);
+    void add_runtime_animation(size_t path_index, float min_value, float max_value, std::string_view pid_name);
+    void finish_load();
     void rebuild_transformed_paths();
+    bool bind_flattened_geometry();
+    void flatten_paths();
+    uint64_t hash_gauge() const;
+    bool restore_tessellation();
     void rebuild_animation_lookup();
     void prepare_frame_paths();
-    void compute_path_y_bounds(const std::vector<VectorRenderer::BezierPath>& paths,
-                               std::vector<float>& min_y,
-                               std::vector<float>& max_y) const;
-    void render_path_set(uint8_t* target_buffer, int width, int height, int stride,
-                         int y_offset, bool render_static_paths, bool render_dynamic_paths);
+    void rebuild_path_index();
+    VectorRenderer::PathView display_view(size_t index) const;
+    PathBounds compute_path_bounds(const VectorRenderer::PathView& path) const;
+    bool is_dynamic_path(size_t index) const;
+    void render_path_set(RenderContext& context, uint8_t* target_buffer, int width, int height,
+                         int stride, int y_offset, int x_begin, int x_end,
+                         bool render_static_paths, bool render_dynamic_paths,
+                         PixelFormat format) const;
+    int damage_extent_x() const;
+    int damage_extent_y() const;
+    void add_damage(const PathBounds& bounds);
+    void add_damage(const PixelRect& rect);
     float get_runtime_animation_value(const RuntimePathAnimation& animation) const;
-    VectorRenderer::BezierPath trim_path_by_ratio(const VectorRenderer::BezierPath& path, float ratio, bool reverse = false) const;
+    void rebuild_sweep_polylines();
+    void rebuild_sweep_maps();
+    void build_sweep_map(size_t index, SweepMap& map) const;
+    bool uses_sweep_map(size_t index) const;
+    void render_sweep_map(RenderContext& context, size_t index, uint8_t* target_buffer, int height,
+                          int stride, int y_offset, int x_begin, int x_end, PixelFormat format) const;
+    PathBounds compute_sweep_delta_bounds(size_t index, float old_ratio, float new_ratio) const;
 };
 
 } // namespace digidash
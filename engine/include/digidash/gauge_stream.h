@@ -0,0 +1,130 @@
+#pragma once
+
+#include "binary_gauge_loader.h"
+#include <cstdint>
+#include <cstdio>
+#include <istream>
+#include <vector>
+
+namespace digidash {
+
+/**
+ * @brief Sequential source of gauge file bytes
+ *
+ * Only forward reads are needed, so a FILE* on SPIFFS, a std::istream on
+ * the host or a socket all fit.
+ */
+class ByteSource {
+public:
+    virtual ~ByteSource() = default;
+
+    /**
+     * @brief Read up to @p size bytes into @p dst
+     *
+     * @return Bytes read, which may be fewer than @p size; 0 at the end
+     *         or on error
+     */
+    virtual size_t read(void* dst, size_t size) = 0;
+};
+
+/**
+ * @brief Reads an open FILE*, which stays owned by the caller
+ */
+class FileByteSource : public ByteSource {
+public:
+    explicit FileByteSource(FILE* file) : file_(file) {}
+
+    size_t read(void* dst, size_t size) override { return std::fread(dst, 1, size, file_); }
+
+private:
+    FILE* file_;
+};
+
+/**
+ * @brief Reads a std::istream, which stays owned by the caller
+ */
+class StreamByteSource : public ByteSource {
+public:
+    explicit StreamByteSource(std::istream& stream) : stream_(stream) {}
+
+    size_t read(void* dst, size_t size) override {
+        stream_.read(static_cast<char*>(dst), static_cast<std::streamsize>(size));
+        return static_cast<size_t>(stream_.gcount());
+    }
+
+private:
+    std::istream& stream_;
+};
+
+/**
+ * @brief Pull parser for v3 gauges read front to back from a ByteSource
+ *
+ * open() reads the header, the section table and the small sections
+ * (paths, animations, strings, static layer records) into metadata().
+ * The bulk sections are then pulled by the caller straight into their
+ * final storage: read_commands() for GaugeScene's command pool and
+ * read_static_layer() for one baked layer. Apart from those destinations
+ * and the metadata, only a kWindowSize read-ahead buffer is held, so the
+ * file is never resident as a whole.
+ *
+ * The stream is never rewound: the small sections must precede Commands,
+ * which must precede StaticLayerData, as svg_preprocessor writes them.
+ * Other files fail open(); BinaryGaugeLoader still reads them from a buffer.
+ */
+class GaugeStreamReader {
+public:
+    static constexpr size_t kWindowSize = 512;
+
+    explicit GaugeStreamReader(ByteSource& source);
+
+    /**
+     * @brief Read and check everything up to the first bulk section
+     */
+    bool open();
+
+    /**
+     * @brief Gauge described by the small sections
+     *
+     * Counts, sizes and references are checked as by map_view(), but
+     * commands and static_layer_data are null: pull them instead.
+     */
+    const GaugeView& metadata() const { return view_; }
+
+    /**
+     * @brief Pull the next @p count records of the Commands section into @p out
+     *
+     * @return false on a short read or past the end of the section
+     */
+    bool read_commands(PathCommand* out, size_t count);
+
+    /**
+     * @brief Read the encoded bytes of one of metadata()'s static layers
+     *
+     * Skips the commands not yet read. Layers must be read in file order.
+     */
+    bool read_static_layer(const gauge_format::StaticLayerRecord& record, std::vector<uint8_t>& out);
+
+private:
+    bool read_exact(void* dst, size_t size);
+    bool skip_to(size_t offset);
+    template <typename T>
+    bool read_records(const gauge_format::SectionEntry& entry, std::vector<T>& records);
+
+    ByteSource& source_;
+    uint8_t window_[kWindowSize];
+    size_t window_begin_;
+    size_t window_end_;
+    size_t position_;           // File offset of the next unread byte
+
+    std::vector<gauge_format::PathRecord> paths_;
+    std::vector<gauge_format::AnimationRecord> animations_;
+    std::vector<char> strings_;
+    std::vector<gauge_format::StaticLayerRecord> static_layers_;
+    GaugeView view_;
+
+    size_t commands_offset_;    // Section file offsets, 0 if absent
+    size_t commands_read_;
+    size_t static_layer_data_offset_;
+};
+
+} // namespace digidash
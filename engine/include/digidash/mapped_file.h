@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace digidash {
+
+/**
+ * @brief Read-only view of a whole file
+ *
+ * Where the platform has mmap the file is mapped, so its pages are shared
+ * with the page cache rather than copied, as a gauge partition is on the
+ * device. Elsewhere it is read into a buffer. data() is 4-byte aligned in
+ * both cases, as BinaryGaugeLoader::map_view() needs.
+ */
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Map @p path, replacing any file mapped before
+     *
+     * @return false if the file cannot be opened or is empty
+     */
+    bool open(const std::string& path);
+    void close();
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool is_mapped() const { return mapped_; }      // false when read into a buffer
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    bool mapped_;
+    std::vector<uint32_t> buffer_;
+};
+
+} // namespace digidash
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "binary_gauge_loader.h"
+#include "task_executor.h"
+#include "vector_renderer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace digidash {
+
+/**
+ * @brief Uniform scale and offset applied to path coordinates before flattening
+ */
+struct TessellationTransform {
+    float min_x = 0.0f;
+    float min_y = 0.0f;
+    float scale = 1.0f;
+    float offset_x = 0.0f;
+    float offset_y = 0.0f;
+
+    VectorRenderer::Point apply(float x, float y) const {
+        return {(x - min_x) * scale + offset_x, (y - min_y) * scale + offset_y};
+    }
+};
+
+/**
+ * @brief One path of a tessellation batch
+ *
+ * The command range is input. The point and contour ranges are filled in
+ * by tessellate_paths(); contour entries count from the path's first point.
+ */
+struct TessellationRange {
+    uint32_t command_offset;
+    uint32_t command_count;
+    uint32_t point_offset;
+    uint32_t point_count;
+    uint32_t contour_offset;
+    uint32_t contour_count;
+};
+
+/**
+ * @brief Chords that keep a cubic within @p tolerance of the curve
+ *
+ * Wang's formula over the control points, clamped to [1, 256].
+ */
+int cubic_segment_count(const VectorRenderer::Point& p0, const VectorRenderer::Point& p1,
+                        const VectorRenderer::Point& p2, const VectorRenderer::Point& p3,
+                        float tolerance);
+
+/**
+ * @brief Flatten a batch of paths into shared point and contour pools
+ *
+ * A first pass counts every path's points and contours so the pools are
+ * resized exactly once; a second writes each path into its own slice,
+ * stepping cubics by forward differencing. Paths are independent, so both
+ * passes are split across @p executor's workers when one is given. Output
+ * matches the serial result whatever the worker count.
+ *
+ * Each contour closed by a Close command repeats its first point, and
+ * points drawn before the first MoveTo form a contour of their own.
+ */
+void tessellate_paths(const PathCommand* commands, TessellationRange* ranges, size_t range_count,
+                      const TessellationTransform& transform, float tolerance,
+                      std::vector<VectorRenderer::Point>& points, std::vector<uint32_t>& contours,
+                      TaskExecutor* executor = nullptr);
+
+/**
+ * @brief As above, storing points in 12.4 fixed point
+ *
+ * The caller guarantees every point fits VectorRenderer::FixedPoint::kLimit.
+ */
+void tessellate_paths(const PathCommand* commands, TessellationRange* ranges, size_t range_count,
+                      const TessellationTransform& transform, float tolerance,
+                      std::vector<VectorRenderer::FixedPoint>& points, std::vector<uint32_t>& contours,
+                      TaskExecutor* executor = nullptr);
+
+/**
+ * @brief Drop points that stray less than @p tolerance from their neighbours' chord
+ *
+ * Douglas-Peucker over every contour of every path, run after
+ * tessellate_paths() on the same ranges and pools: collinear runs collapse
+ * to their ends and sub-pixel jitter disappears, while each contour keeps
+ * its first and last point, so open ends stay put and closed contours stay
+ * closed. The pools shrink in place and the ranges are updated.
+ */
+void simplify_paths(TessellationRange* ranges, size_t range_count, float tolerance,
+                    std::vector<VectorRenderer::Point>& points, std::vector<uint32_t>& contours,
+                    TaskExecutor* executor = nullptr);
+
+/**
+ * @brief As above, for 12.4 fixed-point pools
+ */
+void simplify_paths(TessellationRange* ranges, size_t range_count, float tolerance,
+                    std::vector<VectorRenderer::FixedPoint>& points, std::vector<uint32_t>& contours,
+                    TaskExecutor* executor = nullptr);
+
+/**
+ * @brief Write the first @p ratio of an open polyline's arc length to @p out
+ *
+ * @p distance holds the cumulative arc length at each of the @p count
+ * points, starting at 0, and is binary searched for the cut: the points
+ * before it are copied and one is interpolated on the cut segment. A
+ * ratio of 1 copies every point; a cut within half a pixel of the start
+ * writes none. @p out must hold @p count points.
+ *
+ * @return Number of points written
+ */
+size_t trim_polyline(const VectorRenderer::Point* points, const float* distance, size_t count, float ratio,
+                     VectorRenderer::Point* out);
+
+} // namespace digidash
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "types.h"
+#include <cstdint>
+
+namespace digidash {
+
+/**
+ * @brief Closed-loop controller picking a quality tier from frame time
+ *
+ * Feed the measured duration of every frame; the governor keeps an
+ * exponential moving average and steps one tier down as soon as it exceeds
+ * the budget, and one tier up only after a sustained run well under it.
+ * An upgrade that is quickly undone doubles the wait before the next attempt
+ * at that tier, so the level does not oscillate around the budget.
+ */
+class RenderQualityGovernor {
+public:
+    struct Config {
+        float target_frame_ms = 33.0f;
+        float upgrade_ratio = 0.6f;          // Average must stay below budget * ratio to upgrade
+        float smoothing = 0.25f;             // EMA weight of the newest sample
+        uint32_t settle_frames = 4;          // Frames ignored after a tier change
+        uint32_t upgrade_hold_frames = 30;   // Calm frames required before an upgrade
+        uint32_t max_upgrade_hold_frames = 480;
+        int min_level = static_cast<int>(RenderQuality::NoAA);
+        int max_level = static_cast<int>(RenderQuality::Supersampled);
+        int initial_level = static_cast<int>(RenderQuality::Analytic);
+    };
+
+    RenderQualityGovernor();
+    explicit RenderQualityGovernor(const Config& config);
+
+    /**
+     * @brief Record the duration of the frame just rendered
+     * @return Quality level to use for the next frame
+     */
+    int submit_frame_time(float frame_ms);
+
+    /**
+     * @brief Quality level to use for the next frame
+     */
+    int level() const { return level_; }
+
+    /**
+     * @brief Smoothed frame time in milliseconds
+     */
+    float average_frame_ms() const { return average_ms_; }
+
+    /**
+     * @brief Restart from the initial level with no history
+     */
+    void reset();
+
+    const Config& config() const { return config_; }
+
+private:
+    void change_level(int new_level);
+
+    Config config_;
+    int level_;
+    float average_ms_;
+    bool has_average_;
+    uint32_t settle_remaining_;
+    uint32_t calm_frames_;
+    uint32_t frames_since_upgrade_;
+    uint32_t upgrade_hold_[4];
+};
+
+} // namespace digidash
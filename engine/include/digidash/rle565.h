@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace digidash {
+
+/**
+ * @brief Run-length encode RGB565 pixels
+ *
+ * The stream is a sequence of packets. A header byte's top bit selects a
+ * run (one pixel repeated) or literal pixels; bit 6 set means one more
+ * byte of count follows. The count field holds length - 1, so a packet
+ * covers 1 to 16384 pixels. Pixels are little-endian 16-bit values. Flat
+ * backgrounds and anti-aliased edges of a static gauge layer typically
+ * shrink to a few percent of the raw frame.
+ *
+ * @param out Replaced with the encoded stream
+ */
+void rle565_encode(const uint16_t* pixels, size_t pixel_count, std::vector<uint8_t>& out);
+
+/**
+ * @brief Decode a stream written by rle565_encode()
+ *
+ * @return false if the stream is malformed or does not hold exactly
+ *         @p pixel_count pixels; @p pixels is then partly written
+ */
+bool rle565_decode(const uint8_t* data, size_t size, uint16_t* pixels, size_t pixel_count);
+
+} // namespace digidash
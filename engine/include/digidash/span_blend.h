@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace digidash {
+
+/**
+ * @brief Kernels available for span blending
+ */
+enum class SpanBlendKernel : uint8_t {
+    Scalar = 0,
+    SSE2 = 1,
+    AVX2 = 2,
+    NEON = 3,
+    PIE = 4     // ESP32-S3 PIE vector extension (registered by firmware)
+};
+
+/**
+ * @brief Span kernel signature: blend @p count RGBA8888 pixels at @p dst with a
+ *        constant non-premultiplied color, scaled by a per-pixel coverage byte
+ */
+using SpanBlendFn = void (*)(uint8_t* dst, const uint8_t* coverage, size_t count,
+                             uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+
+/**
+ * @brief Source-over blend a run of RGBA8888 pixels with a constant color
+ *
+ * Effective source alpha for pixel i is a * coverage[i] / 255. Destination
+ * pixels are non-premultiplied. Uses the fastest kernel detected at runtime;
+ * results match per-pixel scalar blending within +/-1 LSB.
+ */
+void blend_span_rgba(uint8_t* dst, const uint8_t* coverage, size_t count,
+                     uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+
+/**
+ * @brief Source-over blend a run of opaque RGB565 pixels with a constant color
+ *
+ * Blends directly in 565 space with 1/32 alpha steps, so a display back
+ * buffer can be drawn into without an RGBA intermediate.
+ */
+void blend_span_rgb565(uint16_t* dst, const uint8_t* coverage, size_t count,
+                       uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+
+/**
+ * @brief Kernel currently used by blend_span_rgba
+ */
+SpanBlendKernel active_span_blend_kernel();
+
+/**
+ * @brief Whether a kernel can run on this CPU/build
+ */
+bool span_blend_kernel_supported(SpanBlendKernel kernel);
+
+/**
+ * @brief Force a specific kernel (tests/benchmarks)
+ * @return false if the kernel is not supported; the active kernel is unchanged
+ */
+bool set_span_blend_kernel(SpanBlendKernel kernel);
+
+/**
+ * @brief Register an ESP32-S3 PIE implementation
+ *
+ * The engine carries no PIE assembly itself; firmware that provides one
+ * registers it here and it becomes the active kernel. Passing nullptr
+ * falls back to runtime detection.
+ */
+void register_span_blend_pie_kernel(SpanBlendFn kernel);
+
+} // namespace digidash
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace digidash {
+
+/**
+ * @brief Axis-aligned bounding box in viewport pixels (inclusive)
+ */
+struct PathBounds {
+    float min_x;
+    float min_y;
+    float max_x;
+    float max_y;
+
+    bool intersects(const PathBounds& other) const {
+        return !(max_x < other.min_x || min_x > other.max_x ||
+                 max_y < other.min_y || min_y > other.max_y);
+    }
+};
+
+/**
+ * @brief Uniform grid index over path bounds
+ *
+ * Items live in one of two layers so static and dynamic paths can be
+ * queried separately. Updating an item only touches grid cells when the
+ * range of cells it covers changes, which keeps per-frame refresh of
+ * animated paths cheap.
+ */
+class SpatialGrid {
+public:
+    enum class Layer : uint8_t {
+        Static = 0,
+        Dynamic = 1
+    };
+
+    static constexpr uint8_t kStaticMask = 1u << static_cast<uint8_t>(Layer::Static);
+    static constexpr uint8_t kDynamicMask = 1u << static_cast<uint8_t>(Layer::Dynamic);
+    static constexpr uint8_t kAllLayers = kStaticMask | kDynamicMask;
+
+    /**
+     * @brief Clear all items and size the grid to cover width x height
+     */
+    void reset(float width, float height, float cell_size = 32.0f);
+
+    /**
+     * @brief Add or replace item @p id
+     */
+    void insert(uint32_t id, const PathBounds& bounds, Layer layer);
+
+    /**
+     * @brief Move an existing item to new bounds, keeping its layer
+     */
+    void update(uint32_t id, const PathBounds& bounds);
+
+    /**
+     * @brief Remove item @p id if present
+     */
+    void remove(uint32_t id);
+
+    /**
+     * @brief Collect ids in @p layer_mask whose bounds intersect @p region
+     *
+     * @p out is cleared first and returned in ascending id order, so paths
+     * keep their paint order.
+     */
+    void query(const PathBounds& region, uint8_t layer_mask, std::vector<uint32_t>& out) const;
+
+    /**
+     * @brief Whether any item of @p layer intersects @p region
+     */
+    bool any(const PathBounds& region, Layer layer) const;
+
+    size_t size() const { return live_items_; }
+
+private:
+    struct CellRange {
+        int x0, y0, x1, y1;
+
+        bool operator==(const CellRange& other) const {
+            return x0 == other.x0 && y0 == other.y0 && x1 == other.x1 && y1 == other.y1;
+        }
+    };
+
+    struct Item {
+        PathBounds bounds;
+        CellRange cells;
+        Layer layer;
+        bool live;
+    };
+
+    CellRange cell_range(const PathBounds& bounds) const;
+    std::vector<uint32_t>& cell(Layer layer, int cx, int cy);
+    const std::vector<uint32_t>& cell(Layer layer, int cx, int cy) const;
+    void link(uint32_t id, const Item& item);
+    void unlink(uint32_t id, const Item& item);
+
+    int columns_ = 0;
+    int rows_ = 0;
+    float inv_cell_size_ = 1.0f;
+    size_t live_items_ = 0;
+    std::vector<Item> items_;
+    // Cell buckets: [layer][row * columns_ + column]
+    std::vector<std::vector<uint32_t>> cells_[2];
+};
+
+} // namespace digidash
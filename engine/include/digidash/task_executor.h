@@ -0,0 +1,96 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace digidash {
+
+/**
+ * @brief Runs batches of independent tasks, possibly in parallel
+ *
+ * Tasks receive the index of the worker running them so callers can keep
+ * per-worker scratch state (tile buffers, rasterizer contexts) without
+ * locking. Worker 0 is always the calling thread.
+ */
+class TaskExecutor {
+public:
+    using TaskFn = std::function<void(size_t task_index, size_t worker_index)>;
+
+    virtual ~TaskExecutor() = default;
+
+    /**
+     * @brief Number of workers, including the calling thread
+     */
+    virtual size_t worker_count() const = 0;
+
+    /**
+     * @brief Run @p fn for every task index in [0, task_count) and wait
+     *
+     * Tasks may run in any order and concurrently; returns once all have
+     * finished.
+     */
+    virtual void parallel_for(size_t task_count, const TaskFn& fn) = 0;
+};
+
+/**
+ * @brief Executor that runs every task on the calling thread
+ */
+class InlineTaskExecutor : public TaskExecutor {
+public:
+    size_t worker_count() const override { return 1; }
+    void parallel_for(size_t task_count, const TaskFn& fn) override;
+};
+
+/**
+ * @brief std::thread pool with per-worker queues and work stealing
+ *
+ * Tasks are dealt round-robin into per-worker queues; a worker drains its
+ * own queue from the front and steals from the back of the others once it
+ * runs dry. Intended for the host build and the simulator.
+ */
+class ThreadPoolTaskExecutor : public TaskExecutor {
+public:
+    /**
+     * @param worker_count Total workers including the caller; 0 picks the
+     *        hardware concurrency
+     */
+    explicit ThreadPoolTaskExecutor(size_t worker_count = 0);
+    ~ThreadPoolTaskExecutor() override;
+
+    ThreadPoolTaskExecutor(const ThreadPoolTaskExecutor&) = delete;
+    ThreadPoolTaskExecutor& operator=(const ThreadPoolTaskExecutor&) = delete;
+
+    size_t worker_count() const override { return queues_.size(); }
+    void parallel_for(size_t task_count, const TaskFn& fn) override;
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    void worker_loop(size_t worker);
+    void run_tasks(size_t worker, const TaskFn& fn);
+    bool pop_task(size_t worker, size_t& task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> threads_;
+
+    std::mutex dispatch_mutex_;     // Serializes parallel_for callers
+    std::mutex state_mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    const TaskFn* job_;
+    uint64_t generation_;
+    size_t busy_workers_;
+    bool stopping_;
+};
+
+} // namespace digidash
@@ -10,8 +10,42 @@ enum class StrokeLineCap : uint8_t {
     Square = 2
 };
 
+enum class FillRule : uint8_t {
+    NonZero = 0,
+    EvenOdd = 1
+};
+
+/**
+ * @brief Pixel layout of a render target
+ */
+enum class PixelFormat : uint8_t {
+    RGBA8888 = 0,   // 4 bytes per pixel, non-premultiplied
+    RGB565 = 1,     // 2 bytes per pixel, opaque (display back buffer)
+    Alpha8 = 2      // 1 byte per pixel, geometric coverage only (cached masks)
+};
+
+/**
+ * @brief Rasterization quality tiers understood by VectorRenderer
+ */
+enum class RenderQuality : int {
+    NoAA = 0,           // Binary coverage, one sample per pixel
+    EdgeAA = 1,         // 2 sub-scanlines for fills; strokes as Analytic
+    Analytic = 2,       // Full analytic coverage, 4 sub-scanlines
+    Supersampled = 3    // 4x the samples of Analytic; applied to the dynamic layer
+};
+
 struct Color {
     uint8_t r, g, b, a;
 };
 
+/**
+ * @brief Integer pixel rectangle, half-open: [x0, x1) x [y0, y1)
+ */
+struct PixelRect {
+    int x0, y0, x1, y1;
+
+    bool empty() const { return x1 <= x0 || y1 <= y0; }
+    uint32_t area() const { return empty() ? 0u : static_cast<uint32_t>(x1 - x0) * static_cast<uint32_t>(y1 - y0); }
+};
+
 } // namespace digidash
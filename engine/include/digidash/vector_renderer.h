@@ -22,12 +22,63 @@ public:
 
     struct BezierPath {
         std::vector<Point> control_points;
+        // Index of the first point of each contour (one entry per MoveTo).
+        // Empty means control_points form a single contour.
+        std::vector<uint32_t> contour_starts;
         uint32_t color;
         float stroke_width;
         bool is_filled;
         StrokeLineCap stroke_cap;
+        FillRule fill_rule = FillRule::NonZero;
     };
 
+    /**
+     * @brief Display-space point in signed 12.4 fixed point
+     *
+     * 1/16 pixel steps over +-2048 pixels, half the size of a Point.
+     */
+    struct FixedPoint {
+        int16_t x;
+        int16_t y;
+
+        static constexpr float kScale = 16.0f;
+        static constexpr float kLimit = 2047.0f;    // Largest magnitude that encodes
+    };
+
+    /**
+     * @brief Non-owning view of a path's geometry and style
+     *
+     * Points come from @c points, or from @c fixed_points when that is set,
+     * so paths can live in shared pools instead of owning their storage.
+     * contour_starts index the first point of each contour; none means the
+     * points form a single contour.
+     */
+    struct PathView {
+        const Point* points = nullptr;
+        const FixedPoint* fixed_points = nullptr;
+        uint32_t point_count = 0;
+        const uint32_t* contour_starts = nullptr;
+        uint32_t contour_count = 0;
+        uint32_t color = 0;
+        float stroke_width = 0.0f;
+        bool is_filled = false;
+        StrokeLineCap stroke_cap = StrokeLineCap::Butt;
+        FillRule fill_rule = FillRule::NonZero;
+
+        Point point(size_t index) const {
+            if (fixed_points) {
+                return Point{fixed_points[index].x / FixedPoint::kScale,
+                             fixed_points[index].y / FixedPoint::kScale};
+            }
+            return points[index];
+        }
+    };
+
+    /**
+     * @brief View of a BezierPath, valid while the path is unchanged
+     */
+    static PathView view(const BezierPath& path);
+
     VectorRenderer();
     ~VectorRenderer();
 
@@ -39,9 +90,29 @@ public:
      * @param height Height of the target buffer (tile height)
      * @param stride Byte stride of the target buffer
      * @param y_offset Y offset in the full coordinate space (for tiled rendering)
+     * @param format Pixel layout of the target buffer
      */
     void render_path(const BezierPath& path, uint8_t* target_buffer, 
-                     int width, int height, int stride, int y_offset = 0);
+                     int width, int height, int stride, int y_offset = 0,
+                     PixelFormat format = PixelFormat::RGBA8888);
+
+    /**
+     * @brief Render a path held in external storage, as render_path() above
+     */
+    void render_path(const PathView& path, uint8_t* target_buffer,
+                     int width, int height, int stride, int y_offset = 0,
+                     PixelFormat format = PixelFormat::RGBA8888);
+
+    /**
+     * @brief Blend a run of precomputed coverage in a path's color
+     *
+     * Pixels are written exactly as render_path() would write a span with
+     * the same coverage, so cached coverage can stand in for rasterizing.
+     * @param row Start of the target row
+     * @param x First pixel of the run within the row
+     */
+    void blend_coverage(const PathView& path, uint8_t* row, int x, const uint8_t* coverage,
+                        size_t count, PixelFormat format = PixelFormat::RGBA8888) const;
 
     /**
      * @brief Render multiple paths in sequence
@@ -51,40 +122,128 @@ public:
 
     /**
      * @brief Set rendering quality (affects performance)
+     * @param quality_level A RenderQuality tier, 0 (no AA) .. 3 (supersampled)
      */
     void set_quality(int quality_level);
 
+    /**
+     * @brief Restrict rasterization to target columns [x_begin, x_end)
+     *
+     * Pixels inside the clip come out exactly as in an unclipped render;
+     * pixels outside it are left untouched.
+     */
+    void set_clip_x(int x_begin, int x_end);
+
+    /**
+     * @brief Remove the column clip
+     */
+    void reset_clip_x();
+
 private:
+    /**
+     * @brief Polygon edge in the sorted edge table (y_top < y_bottom)
+     */
+    struct Edge {
+        float x_top;
+        float dxdy;
+        float y_top;
+        float y_bottom;
+        int winding;
+    };
+
+    struct Crossing {
+        float x;
+        int winding;
+    };
+
+    /**
+     * @brief How the distance field ends at a stroke segment endpoint
+     */
+    enum class SegmentEnd : uint8_t {
+        Join = 0,   // Shared with a neighbouring segment (round join)
+        Butt = 1,
+        Round = 2,
+        Square = 3
+    };
+
+    struct StrokeSegment {
+        float x0, y0;
+        float dx, dy;
+        float len;
+        float inv_len_sq;
+        float min_y;
+        float max_y;
+        SegmentEnd start_end;
+        SegmentEnd end_end;
+        // Cap planes of the contour ends this segment lies close to (-1 = none)
+        int16_t start_plane;
+        int16_t end_plane;
+    };
+
+    /**
+     * @brief Butt/square cap half-plane at an open contour end
+     *
+     * Joins on short tessellated segments near an open end would otherwise
+     * bulge past the cap.
+     */
+    struct CapPlane {
+        float x, y;
+        float ux, uy;   // Unit direction pointing into the stroke
+        SegmentEnd kind;
+    };
+
     int quality_level_;
-    
+    int clip_x_begin_;
+    int clip_x_end_;
+
+    // Scratch storage reused across paths so filling never allocates per scanline
+    std::vector<Edge> edges_;
+    std::vector<uint32_t> active_edges_;
+    std::vector<Crossing> crossings_;
+    std::vector<int32_t> coverage_delta_;
+    std::vector<StrokeSegment> segments_;
+    std::vector<CapPlane> cap_planes_;
+    std::vector<uint32_t> active_segments_;
+    std::vector<float> distance_row_;
+    std::vector<uint8_t> coverage_row_;
+
     /**
-     * @brief Draw a filled polygon using scanline algorithm
+     * @brief Fill all contours of a path with an active edge list rasterizer
+     *
+     * Each pixel row is sampled at several sub-scanlines; span ends get exact
+     * horizontal coverage, interior pixels are accumulated through a
+     * difference row so cost is O(edges + covered pixels). The quality tier
+     * selects the number of sub-scanlines. @p Format is the target pixel
+     * policy that blends each resolved coverage span.
      */
-    void draw_filled_path(const std::vector<Point>& points, uint8_t* buffer,
+    template <typename Format>
+    void draw_filled_path(const PathView& path, uint8_t* buffer,
                          int width, int height, int stride, uint8_t r, uint8_t g,
                          uint8_t b, uint8_t a, int y_offset = 0);
+
+    void build_edge_table(const PathView& path, float clip_min_y, float clip_max_y);
+
+    void accumulate_span(float x_start, float x_end, int weight, int x_min, int x_max,
+                         int& touched_min_x, int& touched_max_x);
     
     /**
-     * @brief Draw path outline with strokes
-     */
-    void draw_stroked_path(const std::vector<Point>& points, uint8_t* buffer,
-                          int width, int height, int stride, uint8_t r, uint8_t g,
-                          uint8_t b, uint8_t a, float stroke_width, StrokeLineCap cap,
-                          int y_offset = 0);
-    
-    /**
-     * @brief Draw a round cap at a point
+     * @brief Stroke all contours of a path in a single coverage pass
+     *
+     * Segments are kept in an active list per pixel row; each covered pixel
+     * takes the minimum cap-aware distance over nearby segments and is
+     * blended exactly once. Joins are round. The quality tier selects the
+     * number of distance samples per pixel and the coverage filter.
      */
-    void draw_round_cap(float x, float y, uint8_t* buffer, int width, int height,
-                       int stride, uint8_t r, uint8_t g, uint8_t b, uint8_t a,
-                       float radius, int y_offset = 0);
-    
+    template <typename Format>
+    void draw_stroked_path(const PathView& path, uint8_t* buffer, int width, int height, int stride,
+                          uint8_t r, uint8_t g, uint8_t b, uint8_t a, int y_offset = 0);
+
     /**
-     * @brief Draw a single line with thickness
+     * @brief Cap-aware squared distance from (px, py) to a stroke segment
      */
-    void draw_line(float x0, float y0, float x1, float y1, uint8_t* buffer,
-                  int width, int height, int stride, uint8_t r, uint8_t g,
-                  uint8_t b, uint8_t a, float stroke_width, int y_offset = 0);
+    float segment_distance_sq(const StrokeSegment& seg, float px, float py, float radius) const;
+
+    void build_segment_table(const PathView& path, float reach);
 };
 
 } // namespace digidash
@@ -1,28 +1,139 @@
 #include "digidash/binary_gauge_loader.h"
+#include <cstddef>
 #include <cstring>
-#include <fstream>
 
 namespace digidash {
 
+namespace {
+
+// Optional chunk after the animation section; older loaders ignore it
+constexpr uint32_t kStaticLayerTag = 0x35363553;  // "S565"
+
+bool parse_static_layers(const uint8_t* buffer, size_t buffer_size, size_t offset,
+                         std::vector<StaticLayer>& layers_out) {
+    uint32_t tag;
+    std::memcpy(&tag, buffer + offset, sizeof(uint32_t));
+    offset += sizeof(uint32_t);
+    if (tag != kStaticLayerTag || offset >= buffer_size) {
+        return false;
+    }
+
+    const uint8_t layer_count = buffer[offset++];
+    for (uint8_t i = 0; i < layer_count; ++i) {
+        if (offset + 8 > buffer_size) {
+            return false;
+        }
+        StaticLayer layer;
+        uint32_t encoded_size;
+        std::memcpy(&layer.width, buffer + offset, sizeof(uint16_t));
+        offset += sizeof(uint16_t);
+        std::memcpy(&layer.height, buffer + offset, sizeof(uint16_t));
+        offset += sizeof(uint16_t);
+        std::memcpy(&encoded_size, buffer + offset, sizeof(uint32_t));
+        offset += sizeof(uint32_t);
+        if (encoded_size > buffer_size - offset) {
+            return false;
+        }
+        layer.rle565.assign(buffer + offset, buffer + offset + encoded_size);
+        offset += encoded_size;
+        layers_out.push_back(std::move(layer));
+    }
+    return true;
+}
+
+// v3 command records are handed out as PathCommand without conversion
+static_assert(sizeof(PathCommand) == sizeof(gauge_format::CommandRecord) &&
+              offsetof(PathCommand, x1) == offsetof(gauge_format::CommandRecord, x1) &&
+              offsetof(PathCommand, y3) == offsetof(gauge_format::CommandRecord, y3),
+              "PathCommand must match gauge_format::CommandRecord");
+static_assert(gauge_format::kSectionAlignment % alignof(PathCommand) == 0, "Sections must align commands");
+
+bool string_fits(const gauge_format::StringRef& ref, size_t strings_size) {
+    return ref.offset <= strings_size && ref.length <= strings_size - ref.offset;
+}
+
+bool range_fits(uint32_t offset, uint32_t count, size_t size) {
+    return offset <= size && count <= size - offset;
+}
+
+// Point @p records at a section holding whole records of T
+template <typename T>
+bool map_records(const uint8_t* section, uint32_t size, const T*& records, size_t& count) {
+    if (size % sizeof(T) != 0) {
+        return false;
+    }
+    records = reinterpret_cast<const T*>(section);
+    count = size / sizeof(T);
+    return true;
+}
+
+Color to_color(const uint8_t rgba[4]) {
+    return Color{rgba[0], rgba[1], rgba[2], rgba[3]};
+}
+
+void copy_view(const GaugeView& view, BinaryGaugeLoader::GaugeAsset& asset_out) {
+    asset_out.width = view.width;
+    asset_out.height = view.height;
+    asset_out.paths.clear();
+    asset_out.path_animations.clear();
+    asset_out.static_layers.clear();
+
+    asset_out.paths.reserve(view.path_count);
+    for (size_t i = 0; i < view.path_count; ++i) {
+        const gauge_format::PathRecord& record = view.paths[i];
+        Path path;
+        path.id = std::string(view.string(record.id));
+        path.stroke = {record.stroke_width, to_color(record.stroke_rgba),
+                       static_cast<StrokeLineCap>(record.stroke_cap)};
+        path.fill = {record.fill_enabled != 0, to_color(record.fill_rgba)};
+        path.commands.assign(view.commands + record.command_offset,
+                             view.commands + record.command_offset + record.command_count);
+        asset_out.paths.push_back(std::move(path));
+    }
+
+    for (size_t i = 0; i < view.animation_count; ++i) {
+        const gauge_format::AnimationRecord& record = view.animations[i];
+        PathAnimationBinding binding;
+        binding.path_id = std::string(view.string(record.path_id));
+        binding.type = static_cast<PathAnimationBinding::Type>(record.type);
+        binding.min_value = record.min_value;
+        binding.max_value = record.max_value;
+        binding.pid_name = std::string(view.string(record.pid_name));
+        asset_out.path_animations.push_back(std::move(binding));
+    }
+
+    for (size_t i = 0; i < view.static_layer_count; ++i) {
+        const gauge_format::StaticLayerRecord& record = view.static_layers[i];
+        const uint8_t* data = view.static_layer_data + record.data_offset;
+        asset_out.static_layers.push_back({record.width, record.height,
+                                           std::vector<uint8_t>(data, data + record.data_size)});
+    }
+}
+
+} // namespace
+
 BinaryGaugeLoader::BinaryGaugeLoader() {}
 
 BinaryGaugeLoader::~BinaryGaugeLoader() {}
 
 bool BinaryGaugeLoader::load_from_file(const std::string& filepath,
                                        GaugeAsset& asset_out) {
-    std::ifstream file(filepath, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
+    MappedFile file;
+    if (!file.open(filepath)) {
         return false;
     }
-    
-    size_t file_size = file.tellg();
-    file.seekg(0, std::ios::beg);
-    
-    std::vector<uint8_t> buffer(file_size);
-    file.read(reinterpret_cast<char*>(buffer.data()), file_size);
-    file.close();
-    
-    return load_from_buffer(buffer.data(), buffer.size(), asset_out);
+    return load_from_buffer(file.data(), file.size(), asset_out);
+}
+
+bool BinaryGaugeLoader::map_file(const std::string& filepath, MappedFile& file_out, GaugeView& view_out) {
+    if (!file_out.open(filepath)) {
+        return false;
+    }
+    if (!map_view(file_out.data(), file_out.size(), view_out)) {
+        file_out.close();
+        return false;
+    }
+    return true;
 }
 
 bool BinaryGaugeLoader::load_from_buffer(const uint8_t* buffer,
@@ -46,6 +157,25 @@ bool BinaryGaugeLoader::load_from_buffer(const uint8_t* buffer,
     uint16_t version;
     std::memcpy(&version, buffer + offset, sizeof(uint16_t));
     offset += sizeof(uint16_t);
+
+    if (version == gauge_format::kSectionedVersion) {
+        GaugeView view;
+        if (reinterpret_cast<uintptr_t>(buffer) % alignof(PathCommand) == 0) {
+            if (!map_view(buffer, buffer_size, view)) {
+                return false;
+            }
+            copy_view(view, asset_out);
+        } else {
+            // Records cannot be mapped in place; map an aligned copy
+            std::vector<uint32_t> aligned((buffer_size + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+            std::memcpy(aligned.data(), buffer, buffer_size);
+            if (!map_view(reinterpret_cast<const uint8_t*>(aligned.data()), buffer_size, view)) {
+                return false;
+            }
+            copy_view(view, asset_out);
+        }
+        return validate_asset(asset_out);
+    }
     
     if (version != 1 && version != 2) {
         return false;
@@ -70,6 +200,7 @@ bool BinaryGaugeLoader::load_from_buffer(const uint8_t* buffer,
     
     asset_out.paths.clear();
     asset_out.path_animations.clear();
+    asset_out.static_layers.clear();
 
     // Parse each path
     for (uint16_t i = 0; i < path_count; ++i) {
@@ -171,13 +302,133 @@ bool BinaryGaugeLoader::load_from_buffer(const uint8_t* buffer,
 
             asset_out.path_animations.push_back(std::move(binding));
         }
+
+        // A damaged chunk only costs the pre-rendered layers; paths still load
+        if (offset + sizeof(uint32_t) <= buffer_size &&
+            !parse_static_layers(buffer, buffer_size, offset, asset_out.static_layers)) {
+            asset_out.static_layers.clear();
+        }
     }
     
     return validate_asset(asset_out);
 }
 
+bool BinaryGaugeLoader::map_view(const uint8_t* buffer, size_t buffer_size, GaugeView& view_out) {
+    using namespace gauge_format;
+
+    if (!buffer || buffer_size < sizeof(FileHeader) ||
+        reinterpret_cast<uintptr_t>(buffer) % alignof(PathCommand) != 0) {
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, buffer, sizeof(FileHeader));
+    if (header.magic != kMagic || header.version != kSectionedVersion) {
+        return false;
+    }
+    if (header.section_count > (buffer_size - sizeof(FileHeader)) / sizeof(SectionEntry)) {
+        return false;
+    }
+
+    GaugeView view;
+    view.width = header.width;
+    view.height = header.height;
+
+    const auto* sections = reinterpret_cast<const SectionEntry*>(buffer + sizeof(FileHeader));
+    for (uint16_t i = 0; i < header.section_count; ++i) {
+        const SectionEntry& entry = sections[i];
+        if (entry.offset % kSectionAlignment != 0 || !range_fits(entry.offset, entry.size, buffer_size)) {
+            return false;
+        }
+
+        const uint8_t* section = buffer + entry.offset;
+        bool ok = true;
+        switch (static_cast<SectionId>(entry.id)) {
+            case SectionId::Paths:
+                ok = map_records(section, entry.size, view.paths, view.path_count);
+                break;
+            case SectionId::Commands:
+                ok = map_records(section, entry.size, view.commands, view.command_count);
+                break;
+            case SectionId::Animations:
+                ok = map_records(section, entry.size, view.animations, view.animation_count);
+                break;
+            case SectionId::Strings:
+                view.strings = reinterpret_cast<const char*>(section);
+                view.strings_size = entry.size;
+                break;
+            case SectionId::StaticLayers:
+                ok = map_records(section, entry.size, view.static_layers, view.static_layer_count);
+                break;
+            case SectionId::StaticLayerData:
+                view.static_layer_data = section;
+                view.static_layer_data_size = entry.size;
+                break;
+            default:
+                break;  // Newer section, not needed here
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+
+    // Check every reference once so users of the view need not
+    if (!validate_view(view)) {
+        return false;
+    }
+    view_out = view;
+    return true;
+}
+
+bool BinaryGaugeLoader::validate_view(const GaugeView& view) {
+    using namespace gauge_format;
+
+    for (size_t i = 0; i < view.path_count; ++i) {
+        const PathRecord& record = view.paths[i];
+        if (!string_fits(record.id, view.strings_size) ||
+            !range_fits(record.command_offset, record.command_count, view.command_count)) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < view.animation_count; ++i) {
+        const AnimationRecord& record = view.animations[i];
+        if (!string_fits(record.path_id, view.strings_size) || !string_fits(record.pid_name, view.strings_size)) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < view.static_layer_count; ++i) {
+        const StaticLayerRecord& record = view.static_layers[i];
+        if (!range_fits(record.data_offset, record.data_size, view.static_layer_data_size)) {
+            return false;
+        }
+    }
+    if (view.flattened_paths) {
+        if (view.flattened_width == 0 || view.flattened_height == 0) {
+            return false;
+        }
+        for (size_t i = 0; i < view.path_count; ++i) {
+            const FlattenedPathRange& range = view.flattened_paths[i];
+            if (!range_fits(range.point_offset, range.point_count, view.flattened_point_count) ||
+                !range_fits(range.contour_offset, range.contour_count, view.flattened_contour_count)) {
+                return false;
+            }
+        }
+    }
+    return view.width != 0 && view.height != 0 && view.path_count != 0;
+}
+
 bool BinaryGaugeLoader::validate_asset(const GaugeAsset& asset) {
     return asset.width > 0 && asset.height > 0 && !asset.paths.empty();
 }
 
+const StaticLayer* BinaryGaugeLoader::find_static_layer(const GaugeAsset& asset, uint32_t width,
+                                                        uint32_t height) {
+    for (const auto& layer : asset.static_layers) {
+        if (layer.width == width && layer.height == height) {
+            return &layer;
+        }
+    }
+    return nullptr;
+}
+
 } // namespace digidash
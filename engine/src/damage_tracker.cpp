@@ -0,0 +1,132 @@
+#include "digidash/damage_tracker.h"
+#include <algorithm>
+
+namespace digidash {
+
+namespace {
+
+// Beyond this many rectangles the per-rectangle overhead outweighs the
+// pixels saved; everything collapses into one bounding box
+constexpr size_t kMaxRects = 16;
+
+bool touches(const PixelRect& a, const PixelRect& b) {
+    return a.x0 <= b.x1 && b.x0 <= a.x1 && a.y0 <= b.y1 && b.y0 <= a.y1;
+}
+
+PixelRect bounding_box(const PixelRect& a, const PixelRect& b) {
+    return PixelRect{std::min(a.x0, b.x0), std::min(a.y0, b.y0),
+                     std::max(a.x1, b.x1), std::max(a.y1, b.y1)};
+}
+
+} // namespace
+
+DamageTracker::DamageTracker(uint32_t buffer_count)
+    : buffer_count_(std::max<uint32_t>(1, buffer_count))
+    , width_(0)
+    , height_(0)
+    , history_(buffer_count_)
+    , current_(0) {
+}
+
+void DamageTracker::reset(int width, int height) {
+    width_ = std::max(0, width);
+    height_ = std::max(0, height);
+    const PixelRect full{0, 0, width_, height_};
+    for (auto& record : history_) {
+        record.damage.assign(1, full);
+        record.overlay.assign(1, full);
+        record.buffer = nullptr;
+    }
+    current_ = 0;
+    rects_.clear();
+}
+
+void DamageTracker::begin_frame(const std::vector<PixelRect>& scene_damage, const void* buffer) {
+    // The slot about to be reused holds the frame this back buffer last showed
+    current_ = (current_ + 1) % buffer_count_;
+
+    rects_.clear();
+    if (history_[current_].buffer != buffer) {
+        add_clipped(PixelRect{0, 0, width_, height_});
+    }
+    for (const auto& rect : scene_damage) {
+        add_clipped(rect);
+    }
+    for (uint32_t age = 1; age < buffer_count_; ++age) {
+        const FrameRecord& record = history_[(current_ + buffer_count_ - age) % buffer_count_];
+        for (const auto& rect : record.damage) {
+            add_clipped(rect);
+        }
+    }
+    for (const auto& rect : history_[current_].overlay) {
+        add_clipped(rect);
+    }
+    merge_rects();
+
+    FrameRecord& record = history_[current_];
+    record.damage.assign(scene_damage.begin(), scene_damage.end());
+    record.overlay.clear();
+    record.buffer = buffer;
+}
+
+void DamageTracker::add_overlay(const PixelRect& rect) {
+    if (!rect.empty()) {
+        history_[current_].overlay.push_back(rect);
+    }
+}
+
+void DamageTracker::rects_in_band(int y, int height, std::vector<PixelRect>& out) const {
+    const int y_end = y + height;
+    for (const auto& rect : rects_) {
+        const PixelRect clipped{rect.x0, std::max(rect.y0, y), rect.x1, std::min(rect.y1, y_end)};
+        if (!clipped.empty()) {
+            out.push_back(clipped);
+        }
+    }
+}
+
+uint32_t DamageTracker::area() const {
+    uint32_t total = 0;
+    for (const auto& rect : rects_) {
+        total += rect.area();
+    }
+    return total;
+}
+
+void DamageTracker::add_clipped(const PixelRect& rect) {
+    const PixelRect clipped{std::max(rect.x0, 0), std::max(rect.y0, 0),
+                            std::min(rect.x1, width_), std::min(rect.y1, height_)};
+    if (!clipped.empty()) {
+        rects_.push_back(clipped);
+    }
+}
+
+void DamageTracker::merge_rects() {
+    // Replace touching pairs by their bounding box until none are left, which
+    // also leaves the survivors disjoint
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (size_t i = 0; i < rects_.size() && !merged; ++i) {
+            for (size_t j = i + 1; j < rects_.size(); ++j) {
+                if (touches(rects_[i], rects_[j])) {
+                    rects_[i] = bounding_box(rects_[i], rects_[j]);
+                    rects_[j] = rects_.back();
+                    rects_.pop_back();
+                    merged = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (rects_.size() > kMaxRects) {
+        PixelRect box = rects_[0];
+        for (const auto& rect : rects_) {
+            box = bounding_box(box, rect);
+        }
+        rects_.assign(1, box);
+    }
+}
+
+} // namespace digidash
@@ -0,0 +1,50 @@
+#include "digidash/frame_arena.h"
+
+namespace digidash {
+
+namespace {
+
+size_t blocks_for(size_t bytes) {
+    return (bytes + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+}
+
+} // namespace
+
+FrameArena::FrameArena(size_t capacity_bytes)
+    : block_(blocks_for(capacity_bytes))
+    , used_(0)
+    , overflow_bytes_(0) {
+}
+
+void FrameArena::reserve(size_t bytes) {
+    reset();
+    if (bytes > capacity()) {
+        block_.assign(blocks_for(bytes), std::max_align_t{});
+    }
+}
+
+void FrameArena::reset() {
+    if (overflow_bytes_ > 0) {
+        // Grow to what the last frame needed so the next one fits in one block
+        const size_t high_water = used_ + overflow_bytes_;
+        overflow_.clear();
+        block_.assign(blocks_for(high_water), std::max_align_t{});
+    }
+    used_ = 0;
+    overflow_bytes_ = 0;
+}
+
+void* FrameArena::allocate_bytes(size_t bytes, size_t alignment) {
+    const size_t offset = (used_ + alignment - 1) & ~(alignment - 1);
+    if (offset + bytes <= capacity()) {
+        used_ = offset + bytes;
+        return reinterpret_cast<uint8_t*>(block_.data()) + offset;
+    }
+
+    const size_t block_count = blocks_for(bytes);
+    overflow_.push_back(std::make_unique<std::max_align_t[]>(block_count));
+    overflow_bytes_ += block_count * sizeof(std::max_align_t);
+    return overflow_.back().get();
+}
+
+} // namespace digidash
@@ -1,14 +1,16 @@
 #include "digidash/gauge_scene.h"
+#include "digidash/gauge_stream.h"
 #include <cstring>
 #include <algorithm>
 #include <cmath>
 #include <unordered_set>
+#include <limits>
 
 namespace digidash {
 
 namespace {
 
-uint32_t pid_id_for_name(const std::string& pid_name) {
+uint32_t pid_id_for_name(std::string_view pid_name) {
     if (pid_name == "engine_rpm") {
         return 0;
     }
@@ -24,377 +26,847 @@ uint32_t pid_id_for_name(const std::string& pid_name) {
     return UINT32_MAX;
 }
 
-bool should_reverse_for_pid(const std::string& pid_name) {
+bool should_reverse_for_pid(std::string_view pid_name) {
     (void)pid_name;
     return false;
 }
 
-float distance_to_line(float px, float py, float x0, float y0, float x1, float y1) {
-    const float dx = x1 - x0;
-    const float dy = y1 - y0;
-    const float len_sq = dx * dx + dy * dy;
-    if (len_sq < 1e-6f) {
-        const float ddx = px - x0;
-        const float ddy = py - y0;
-        return std::sqrt(ddx * ddx + ddy * ddy);
+// Largest distance a flattened cubic may stray from the true curve, in
+// viewport pixels
+constexpr float kFlattenTolerance = 0.2f;
+
+// Default for set_simplify_tolerance(), in viewport pixels
+constexpr float kDefaultSimplifyTolerance = 0.1f;
+
+// Widen [lo, hi] to the extrema of a cubic along one axis
+void include_cubic_extrema(float p0, float p1, float p2, float p3, float& lo, float& hi) {
+    // Roots of the derivative a t^2 + b t + c in (0, 1)
+    const float a = -p0 + 3.0f * p1 - 3.0f * p2 + p3;
+    const float b = 2.0f * (p0 - 2.0f * p1 + p2);
+    const float c = p1 - p0;
+    float roots[2];
+    int root_count = 0;
+    if (std::fabs(a) < 1e-6f) {
+        if (std::fabs(b) > 1e-6f) {
+            roots[root_count++] = -c / b;
+        }
+    } else {
+        const float discriminant = b * b - 4.0f * a * c;
+        if (discriminant >= 0.0f) {
+            const float root = std::sqrt(discriminant);
+            roots[root_count++] = (-b + root) / (2.0f * a);
+            roots[root_count++] = (-b - root) / (2.0f * a);
+        }
     }
 
-    const float t = ((px - x0) * dx + (py - y0) * dy) / len_sq;
-    const float proj_x = x0 + t * dx;
-    const float proj_y = y0 + t * dy;
-    const float ddx = px - proj_x;
-    const float ddy = py - proj_y;
-    return std::sqrt(ddx * ddx + ddy * ddy);
+    for (int i = 0; i < root_count; ++i) {
+        const float t = roots[i];
+        if (t <= 0.0f || t >= 1.0f) {
+            continue;
+        }
+        const float mt = 1.0f - t;
+        const float value = mt * mt * mt * p0 + 3.0f * mt * mt * t * p1 + 3.0f * mt * t * t * p2 + t * t * t * p3;
+        lo = std::min(lo, value);
+        hi = std::max(hi, value);
+    }
 }
 
-int estimate_cubic_segments(float x0, float y0,
-                            float x1, float y1,
-                            float x2, float y2,
-                            float x3, float y3) {
-    const float chord = std::hypot(x3 - x0, y3 - y0);
-    const float control_net = std::hypot(x1 - x0, y1 - y0)
-                            + std::hypot(x2 - x1, y2 - y1)
-                            + std::hypot(x3 - x2, y3 - y2);
+// Widen bounds to everything a path's commands draw, curve extrema included
+void include_command_bounds(const PathCommand* commands, size_t count, PathBounds& bounds) {
+    auto include = [&bounds](float x, float y) {
+        bounds.min_x = std::min(bounds.min_x, x);
+        bounds.min_y = std::min(bounds.min_y, y);
+        bounds.max_x = std::max(bounds.max_x, x);
+        bounds.max_y = std::max(bounds.max_y, y);
+    };
+
+    float current_x = 0.0f, current_y = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        const PathCommand& cmd = commands[i];
+        switch (cmd.type) {
+            case PathCommand::Type::MoveTo:
+            case PathCommand::Type::LineTo:
+                current_x = cmd.x1;
+                current_y = cmd.y1;
+                include(current_x, current_y);
+                break;
 
-    const float flatness = std::max(
-        distance_to_line(x1, y1, x0, y0, x3, y3),
-        distance_to_line(x2, y2, x0, y0, x3, y3)
-    );
+            case PathCommand::Type::CubicTo:
+                include_cubic_extrema(current_x, cmd.x1, cmd.x2, cmd.x3, bounds.min_x, bounds.max_x);
+                include_cubic_extrema(current_y, cmd.y1, cmd.y2, cmd.y3, bounds.min_y, bounds.max_y);
+                current_x = cmd.x3;
+                current_y = cmd.y3;
+                include(current_x, current_y);
+                break;
 
-    const float by_length = std::max(chord, control_net) / 4.0f;
-    const float by_flatness = flatness * 1.5f;
-    const int segments = static_cast<int>(std::ceil(std::max(by_length, by_flatness)));
-    return std::clamp(segments, 12, 128);
+            case PathCommand::Type::Close:
+                break;
+        }
+    }
 }
 
+// Pending damage rectangles kept before they are folded into one
+constexpr size_t kMaxPendingDamage = 256;
+
+// A trim sweep moving further than this share of its arc in one frame is
+// damaged as a whole instead of by the swept span
+constexpr float kMaxIncrementalSweep = 0.5f;
+
+// How far rasterized pixels may reach beyond a path's points
+float path_margin(const VectorRenderer::PathView& path) {
+    if (path.is_filled) {
+        return 1.0f;
+    }
+    // Stroke radius + antialiasing fringe. Square caps reach further along
+    // the diagonal.
+    const float radius = path.stroke_width * 0.5f;
+    return ((path.stroke_cap == StrokeLineCap::Square) ? radius * 1.4143f : radius) + 2.0f;
+}
+
+PathBounds points_bounds(const VectorRenderer::PathView& path, float margin) {
+    if (path.point_count == 0) {
+        // Inverted box: intersects nothing and occupies no grid cells
+        constexpr float kInf = std::numeric_limits<float>::infinity();
+        return {kInf, kInf, -kInf, -kInf};
+    }
+
+    const VectorRenderer::Point first = path.point(0);
+    PathBounds bounds{first.x, first.y, first.x, first.y};
+    for (size_t i = 1; i < path.point_count; ++i) {
+        const VectorRenderer::Point point = path.point(i);
+        bounds.min_x = std::min(bounds.min_x, point.x);
+        bounds.min_y = std::min(bounds.min_y, point.y);
+        bounds.max_x = std::max(bounds.max_x, point.x);
+        bounds.max_y = std::max(bounds.max_y, point.y);
+    }
+
+    // Expand so tile culling does not miss edge pixels near tile boundaries
+    bounds.min_x -= margin;
+    bounds.min_y -= margin;
+    bounds.max_x += margin;
+    bounds.max_y += margin;
+    return bounds;
+}
+
+// Arc length at which a trim ratio cuts a polyline of total length
+// total_length; 0 when the trimmed path is empty
+float trim_length(float total_length, float ratio) {
+    if (ratio >= 1.0f) {
+        return total_length;
+    }
+    const float target = total_length * std::max(ratio, 0.0f);
+    return (target <= 0.5f) ? 0.0f : target;
+}
+
+// @p path's style drawn over a single contour held elsewhere
+VectorRenderer::PathView with_points(VectorRenderer::PathView path, const VectorRenderer::Point* points,
+                                     size_t count) {
+    path.points = points;
+    path.fixed_points = nullptr;
+    path.point_count = static_cast<uint32_t>(count);
+    path.contour_starts = nullptr;
+    path.contour_count = 0;
+    return path;
+}
+
+// Blob written by save_tessellation(): a TessellationCacheHeader, then
+// TessellationRange[path_count], PathBounds[path_count],
+// uint32_t[contour_count] and the points. Bump the version whenever
+// flattening or simplification would produce other points, so blobs from
+// an older engine are ignored.
+constexpr uint32_t kTessellationCacheMagic = 0x43544744;   // "DGTC"
+constexpr uint16_t kTessellationCacheVersion = 1;
+
+struct TessellationCacheHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t point_encoding;         // Requested GaugeScene::PointEncoding
+    uint8_t static_layer_baked;
+    uint64_t gauge_hash;
+    uint32_t viewport_width;
+    uint32_t viewport_height;
+    float flatten_tolerance;
+    float simplify_tolerance;
+    uint32_t path_count;
+    uint32_t contour_count;
+    uint32_t point_count;
+    uint8_t fixed_points;           // Points stored as FixedPoint
+    uint8_t reserved[3];
+    uint64_t payload_hash;          // Of everything after the header
+};
+
+static_assert(sizeof(TessellationCacheHeader) == 56, "TessellationCacheHeader layout");
+
+// FNV-1a over 32-bit words
+class WordHash {
+public:
+    void add(uint32_t word) { value_ = (value_ ^ word) * 0x100000001b3ull; }
+
+    void add(float value) {
+        uint32_t word;
+        std::memcpy(&word, &value, sizeof(word));
+        add(word);
+    }
+
+    // @p size is a multiple of 4
+    void add(const uint8_t* data, size_t size) {
+        for (size_t i = 0; i < size; i += sizeof(uint32_t)) {
+            uint32_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            add(word);
+        }
+    }
+
+    uint64_t value() const { return value_; }
+
+private:
+    uint64_t value_ = 0xcbf29ce484222325ull;
+};
+
 } // namespace
 
 GaugeScene::GaugeScene()
-    : renderer_(std::make_unique<VectorRenderer>()),
+    : default_context_(std::make_unique<RenderContext>()),
     animation_engine_(std::make_unique<AnimationEngine>()),
     pid_system_(std::make_unique<PIDBindingSystem>()),
+        sweep_render_mode_(SweepRenderMode::Geometry),
+        point_encoding_(PointEncoding::Float32),
+        executor_(nullptr),
+        simplify_tolerance_(kDefaultSimplifyTolerance),
+        static_layer_baked_(false),
+        render_quality_(static_cast<int>(RenderQuality::Analytic)),
         animation_time_ms_(0),
     width_(0),
         height_(0),
         viewport_width_(0),
         viewport_height_(0) {
-    if (renderer_) renderer_->set_quality(2);
+    default_context_->renderer.set_quality(render_quality_);
+    damage_.reserve(kMaxPendingDamage);
+}
+
+GaugeScene::GaugeScene(const GaugeView& embedded) : GaugeScene() {
+    viewport_width_ = embedded.flattened_width;
+    viewport_height_ = embedded.flattened_height;
+    load_gauge(embedded, CommandStorage::Borrow);
 }
 
 GaugeScene::~GaugeScene() {}
 
 bool GaugeScene::load_gauge(const BinaryGaugeLoader::GaugeAsset& asset) {
-    current_asset_ = asset;
-    width_ = asset.width;
-    height_ = asset.height;
-    pid_name_to_id_.clear();
-    seen_pid_ids_.clear();
-    
-    // Convert Path structure to BezierPath for rendering
-    paths_.clear();
-    path_ids_.clear();
-    runtime_animations_.clear();
-    
+    size_t command_count = 0;
+    for (const auto& path : asset.paths) {
+        command_count += path.commands.size();
+    }
+    begin_load(asset.width, asset.height, asset.paths.size(), command_count);
+
+    // Ids are only needed to bind animations, so they are borrowed
+    std::vector<std::string_view> path_ids;
+    path_ids.reserve(asset.paths.size());
     for (size_t i = 0; i < asset.paths.size(); ++i) {
         const auto& path = asset.paths[i];
-        VectorRenderer::BezierPath bezier_path;
-        
-        // Convert color from Color struct to uint32
-        uint32_t color = (path.stroke.color.a << 24) |
-                        (path.stroke.color.r << 16) |
-                        (path.stroke.color.g << 8) |
-                        path.stroke.color.b;
-        
-        bezier_path.color = color;
-        bezier_path.stroke_width = path.stroke.width;
-        bezier_path.is_filled = path.fill.enabled;
-        bezier_path.stroke_cap = path.stroke.cap;
-        
-        // If filled, use fill color instead
-        if (path.fill.enabled) {
-            bezier_path.color = (path.fill.color.a << 24) |
-                               (path.fill.color.r << 16) |
-                               (path.fill.color.g << 8) |
-                               path.fill.color.b;
-        }
-        
-        // Flatten PathCommands to points for rendering
-        float current_x = 0.0f, current_y = 0.0f;
-        
-        for (const auto& cmd : path.commands) {
-            switch (cmd.type) {
-                case PathCommand::Type::MoveTo: {
-                    current_x = cmd.x1;
-                    current_y = cmd.y1;
-                    bezier_path.control_points.push_back({current_x, current_y});
-                }
-                break;
-                    
-                case PathCommand::Type::LineTo: {
-                    current_x = cmd.x1;
-                    current_y = cmd.y1;
-                    bezier_path.control_points.push_back({current_x, current_y});
-                }
-                break;
-                    
-                case PathCommand::Type::CubicTo:
-                    // Tessellate cubic bezier into line segments
-                    {
-                        float start_x = current_x;
-                        float start_y = current_y;
-                        const int segments = estimate_cubic_segments(
-                            start_x, start_y,
-                            cmd.x1, cmd.y1,
-                            cmd.x2, cmd.y2,
-                            cmd.x3, cmd.y3
-                        );
-                        
-                        for (int i = 1; i <= segments; ++i) {
-                            float t = i / (float)segments;
-                            float t2 = t * t;
-                            float t3 = t2 * t;
-                            float mt = 1.0f - t;
-                            float mt2 = mt * mt;
-                            float mt3 = mt2 * mt;
-                            
-                            float x = mt3 * start_x + 
-                                     3.0f * mt2 * t * cmd.x1 +
-                                     3.0f * mt * t2 * cmd.x2 +
-                                     t3 * cmd.x3;
-                            float y = mt3 * start_y +
-                                     3.0f * mt2 * t * cmd.y1 +
-                                     3.0f * mt * t2 * cmd.y2 +
-                                     t3 * cmd.y3;
-                            
-                            bezier_path.control_points.push_back({x, y});
-                        }
-                        
-                        current_x = cmd.x3;
-                        current_y = cmd.y3;
-                    }
-                    break;
-                    
-                case PathCommand::Type::Close:
-                    // Close path by adding first point again if needed
-                    if (!bezier_path.control_points.empty()) {
-                        const auto& first = bezier_path.control_points[0];
-                        bezier_path.control_points.push_back(first);
-                    }
-                    break;
-            }
+        const size_t command_offset = source_commands_.size();
+        source_commands_.insert(source_commands_.end(), path.commands.begin(), path.commands.end());
+        commands_ = source_commands_.data();
+        if (add_path(i, path.stroke, path.fill, command_offset, path.commands.size())) {
+            path_ids.push_back(path.id);
+        } else {
+            source_commands_.resize(command_offset);
         }
-        
-        if (!bezier_path.control_points.empty()) {
-            path_ids_.push_back(path.id);
-            paths_.push_back(bezier_path);
+    }
+
+    for (const auto& path_animation : asset.path_animations) {
+        if (path_animation.type == PathAnimationBinding::Type::TrimSweep) {
+            bind_trim_sweep(path_ids, path_animation.path_id, path_animation.min_value, path_animation.max_value,
+                            path_animation.pid_name);
         }
     }
 
-    std::unordered_set<size_t> animated_path_indices;
+    finish_load();
+    return true;
+}
 
-    for (const auto& path_animation : asset.path_animations) {
-        if (path_animation.type != PathAnimationBinding::Type::TrimSweep) {
-            continue;
+bool GaugeScene::load_gauge(const GaugeView& view, CommandStorage storage) {
+    if (storage == CommandStorage::Borrow) {
+        begin_load(view.width, view.height, view.path_count, 0);
+        commands_ = view.commands;
+        if (view.flattened_paths) {
+            borrowed_ranges_ = view.flattened_paths;
+            borrowed_points_ = view.flattened_points;
+            borrowed_contours_ = view.flattened_contours;
+            borrowed_width_ = view.flattened_width;
+            borrowed_height_ = view.flattened_height;
         }
+    } else {
+        begin_load(view.width, view.height, view.path_count, view.command_count);
+        source_commands_.assign(view.commands, view.commands + view.command_count);
+        commands_ = source_commands_.data();
+    }
+    add_view_paths(view);
+    finish_load();
+    return true;
+}
 
-        bool assigned = false;
-        for (size_t index = 0; index < path_ids_.size(); ++index) {
-            if (path_ids_[index] == path_animation.path_id) {
-                RuntimePathAnimation runtime_animation;
-                runtime_animation.path_index = index;
-                runtime_animation.min_value = path_animation.min_value;
-                runtime_animation.max_value = path_animation.max_value;
-                runtime_animation.pid_name = path_animation.pid_name;
-                runtime_animation.pid_id = pid_id_for_name(path_animation.pid_name);
-                runtime_animation.uses_pid = (runtime_animation.pid_id != UINT32_MAX);
-                runtime_animation.reverse = should_reverse_for_pid(path_animation.pid_name);
-
-                if (runtime_animation.uses_pid) {
-                    pid_name_to_id_[runtime_animation.pid_name] = runtime_animation.pid_id;
-                    PIDBindingSystem::PIDBinding binding{};
-                    binding.pid_id = runtime_animation.pid_id;
-                    binding.type = PIDBindingSystem::PIDType::CUSTOM;
-                    binding.unit = "raw";
-                    binding.min_value = runtime_animation.min_value;
-                    binding.max_value = runtime_animation.max_value;
-                    binding.scale = 1.0f;
-                    binding.offset = 0.0f;
-                    pid_system_->register_binding(binding);
-                }
+bool GaugeScene::load_gauge(GaugeStreamReader& reader) {
+    const GaugeView& view = reader.metadata();
+    begin_load(view.width, view.height, view.path_count, view.command_count);
+
+    // Commands arrive straight in the pool; nothing else holds them
+    source_commands_.resize(view.command_count);
+    commands_ = source_commands_.data();
+    if (!reader.read_commands(source_commands_.data(), source_commands_.size())) {
+        source_commands_.clear();
+        commands_ = nullptr;
+        finish_load();
+        return false;
+    }
+    add_view_paths(view);
+    finish_load();
+    return true;
+}
 
-                runtime_animations_.push_back(std::move(runtime_animation));
-                animated_path_indices.insert(index);
-                assigned = true;
-                break;
-            }
+void GaugeScene::add_view_paths(const GaugeView& view) {
+    std::vector<std::string_view> path_ids;
+    path_ids.reserve(view.path_count);
+    for (size_t i = 0; i < view.path_count; ++i) {
+        const gauge_format::PathRecord& record = view.paths[i];
+        const StrokeStyle stroke{record.stroke_width,
+                                 {record.stroke_rgba[0], record.stroke_rgba[1], record.stroke_rgba[2],
+                                  record.stroke_rgba[3]},
+                                 static_cast<StrokeLineCap>(record.stroke_cap)};
+        const FillStyle fill{record.fill_enabled != 0,
+                             {record.fill_rgba[0], record.fill_rgba[1], record.fill_rgba[2], record.fill_rgba[3]}};
+        if (add_path(i, stroke, fill, record.command_offset, record.command_count)) {
+            path_ids.push_back(view.string(record.id));
         }
+    }
 
-        if (assigned) {
-            continue;
+    for (size_t i = 0; i < view.animation_count; ++i) {
+        const gauge_format::AnimationRecord& record = view.animations[i];
+        if (static_cast<PathAnimationBinding::Type>(record.type) == PathAnimationBinding::Type::TrimSweep) {
+            bind_trim_sweep(path_ids, view.string(record.path_id), record.min_value, record.max_value,
+                            view.string(record.pid_name));
         }
+    }
+}
 
-        // Fallback: bind in order to stroked paths when IDs from sidecar JSON
-        // don't match serialized ThorVG path IDs (e.g. path_0/path_1/...)
-        auto select_color_match = [&](const std::string& pid_name) -> size_t {
-            for (size_t index = 0; index < paths_.size(); ++index) {
-                if (animated_path_indices.find(index) != animated_path_indices.end()) {
-                    continue;
-                }
-                if (paths_[index].is_filled) {
-                    continue;
-                }
+void GaugeScene::begin_load(uint32_t width, uint32_t height, size_t path_count, size_t command_count) {
+    width_ = width;
+    height_ = height;
+    pid_name_to_id_.clear();
+    seen_pid_ids_.clear();
+    runtime_animations_.clear();
 
-                const uint32_t color = paths_[index].color;
-                const uint8_t red = static_cast<uint8_t>((color >> 16) & 0xFF);
-                const uint8_t green = static_cast<uint8_t>((color >> 8) & 0xFF);
-                const uint8_t blue = static_cast<uint8_t>(color & 0xFF);
+    // Keep every path's commands so each viewport can flatten them afresh.
+    // They live as long as the gauge, so the pools are sized once.
+    path_records_.clear();
+    path_ranges_.clear();
+    std::vector<PathCommand>().swap(source_commands_);
+    commands_ = nullptr;
+    borrowed_ranges_ = nullptr;
+    borrowed_points_ = nullptr;
+    borrowed_contours_ = nullptr;
+    borrowed_width_ = borrowed_height_ = 0;
+    path_records_.reserve(path_count);
+    path_ranges_.reserve(path_count);
+    source_commands_.reserve(command_count);
+}
 
-                if (pid_name == "engine_rpm") {
-                    if (red > blue && red > green) {
-                        return index;
-                    }
-                } else if (pid_name == "coolant_temp") {
-                    if (blue > red && blue > green) {
-                        return index;
-                    }
-                }
+bool GaugeScene::add_path(size_t source_index, const StrokeStyle& stroke, const FillStyle& fill,
+                          size_t command_offset, size_t command_count) {
+    // A path of nothing but Close commands draws no points
+    const PathCommand* commands = commands_ + command_offset;
+    const bool has_points = std::any_of(commands, commands + command_count,
+                                        [](const PathCommand& cmd) {
+                                            return cmd.type != PathCommand::Type::Close;
+                                        });
+    if (!has_points) {
+        return false;
+    }
+
+    TessellationRange range{};
+    range.command_offset = static_cast<uint32_t>(command_offset);
+    range.command_count = static_cast<uint32_t>(command_count);
+
+    // Convert color from Color struct to uint32
+    PathRecord record{};
+    uint32_t color = (stroke.color.a << 24) |
+                    (stroke.color.r << 16) |
+                    (stroke.color.g << 8) |
+                    stroke.color.b;
+
+    record.color = color;
+    record.stroke_width = stroke.width;
+    record.is_filled = fill.enabled;
+    record.stroke_cap = stroke.cap;
+    record.fill_rule = FillRule::NonZero;
+    record.source_index = static_cast<uint32_t>(source_index);
+
+    // If filled, use fill color instead
+    if (fill.enabled) {
+        record.color = (fill.color.a << 24) |
+                       (fill.color.r << 16) |
+                       (fill.color.g << 8) |
+                       fill.color.b;
+    }
+
+    path_records_.push_back(record);
+    path_ranges_.push_back(range);
+    return true;
+}
+
+void GaugeScene::bind_trim_sweep(const std::vector<std::string_view>& path_ids, std::string_view path_id,
+                                 float min_value, float max_value, std::string_view pid_name) {
+    for (size_t index = 0; index < path_ids.size(); ++index) {
+        if (path_ids[index] == path_id) {
+            add_runtime_animation(index, min_value, max_value, pid_name);
+            return;
+        }
+    }
+
+    // Fallback: bind in order to stroked paths when IDs from sidecar JSON
+    // don't match serialized ThorVG path IDs (e.g. path_0/path_1/...)
+    auto is_available = [&](size_t index) {
+        if (path_records_[index].is_filled) {
+            return false;
+        }
+        return std::none_of(runtime_animations_.begin(), runtime_animations_.end(),
+                            [index](const RuntimePathAnimation& animation) {
+                                return animation.path_index == index;
+                            });
+    };
+
+    auto select_color_match = [&]() -> size_t {
+        for (size_t index = 0; index < path_records_.size(); ++index) {
+            if (!is_available(index)) {
+                continue;
             }
-            return SIZE_MAX;
-        };
 
-        size_t matched_index = select_color_match(path_animation.pid_name);
+            const uint32_t color = path_records_[index].color;
+            const uint8_t red = static_cast<uint8_t>((color >> 16) & 0xFF);
+            const uint8_t green = static_cast<uint8_t>((color >> 8) & 0xFF);
+            const uint8_t blue = static_cast<uint8_t>(color & 0xFF);
 
-        if (matched_index == SIZE_MAX) {
-            for (size_t index = 0; index < paths_.size(); ++index) {
-                if (animated_path_indices.find(index) != animated_path_indices.end()) {
-                    continue;
+            if (pid_name == "engine_rpm") {
+                if (red > blue && red > green) {
+                    return index;
                 }
-                if (paths_[index].is_filled) {
-                    continue;
+            } else if (pid_name == "coolant_temp") {
+                if (blue > red && blue > green) {
+                    return index;
                 }
+            }
+        }
+        return SIZE_MAX;
+    };
+
+    size_t matched_index = select_color_match();
+
+    if (matched_index == SIZE_MAX) {
+        for (size_t index = 0; index < path_records_.size(); ++index) {
+            if (is_available(index)) {
                 matched_index = index;
                 break;
             }
         }
+    }
 
-        if (matched_index != SIZE_MAX) {
-            RuntimePathAnimation runtime_animation;
-            runtime_animation.path_index = matched_index;
-            runtime_animation.min_value = path_animation.min_value;
-            runtime_animation.max_value = path_animation.max_value;
-            runtime_animation.pid_name = path_animation.pid_name;
-            runtime_animation.pid_id = pid_id_for_name(path_animation.pid_name);
-            runtime_animation.uses_pid = (runtime_animation.pid_id != UINT32_MAX);
-            runtime_animation.reverse = should_reverse_for_pid(path_animation.pid_name);
-
-            if (runtime_animation.uses_pid) {
-                pid_name_to_id_[runtime_animation.pid_name] = runtime_animation.pid_id;
-                PIDBindingSystem::PIDBinding binding{};
-                binding.pid_id = runtime_animation.pid_id;
-                binding.type = PIDBindingSystem::PIDType::CUSTOM;
-                binding.unit = "raw";
-                binding.min_value = runtime_animation.min_value;
-                binding.max_value = runtime_animation.max_value;
-                binding.scale = 1.0f;
-                binding.offset = 0.0f;
-                pid_system_->register_binding(binding);
-            }
+    if (matched_index != SIZE_MAX) {
+        add_runtime_animation(matched_index, min_value, max_value, pid_name);
+    }
+}
 
-            runtime_animations_.push_back(std::move(runtime_animation));
-            animated_path_indices.insert(matched_index);
-        }
+void GaugeScene::add_runtime_animation(size_t path_index, float min_value, float max_value,
+                                       std::string_view pid_name) {
+    RuntimePathAnimation runtime_animation;
+    runtime_animation.path_index = path_index;
+    runtime_animation.min_value = min_value;
+    runtime_animation.max_value = max_value;
+    runtime_animation.pid_name = std::string(pid_name);
+    runtime_animation.pid_id = pid_id_for_name(pid_name);
+    runtime_animation.uses_pid = (runtime_animation.pid_id != UINT32_MAX);
+    runtime_animation.reverse = should_reverse_for_pid(pid_name);
+
+    if (runtime_animation.uses_pid) {
+        pid_name_to_id_[runtime_animation.pid_name] = runtime_animation.pid_id;
+        PIDBindingSystem::PIDBinding binding{};
+        binding.pid_id = runtime_animation.pid_id;
+        binding.type = PIDBindingSystem::PIDType::CUSTOM;
+        binding.unit = "raw";
+        binding.min_value = runtime_animation.min_value;
+        binding.max_value = runtime_animation.max_value;
+        binding.scale = 1.0f;
+        binding.offset = 0.0f;
+        pid_system_->register_binding(binding);
     }
 
+    runtime_animations_.push_back(std::move(runtime_animation));
+}
+
+void GaugeScene::finish_load() {
     rebuild_animation_lookup();
+    gauge_hash_ = hash_gauge();
+
+    // Without a viewport the fit is still to come; flattening at the gauge's
+    // units now would only be thrown away by set_viewport()
+    geometry_pending_ = viewport_width_ == 0 || viewport_height_ == 0;
     rebuild_transformed_paths();
     prepare_frame_paths();
-    
-    return true;
 }
 
 void GaugeScene::set_viewport(uint32_t viewport_width, uint32_t viewport_height) {
     viewport_width_ = viewport_width;
     viewport_height_ = viewport_height;
+    geometry_pending_ = false;
     rebuild_transformed_paths();
     prepare_frame_paths();
 }
 
-void GaugeScene::rebuild_transformed_paths() {
-    transformed_paths_.clear();
-    transformed_min_y_.clear();
-    transformed_max_y_.clear();
-    prepared_paths_.clear();
-    prepared_min_y_.clear();
-    prepared_max_y_.clear();
-
-    if (paths_.empty()) {
+void GaugeScene::set_point_encoding(PointEncoding encoding) {
+    if (encoding == point_encoding_) {
         return;
     }
+    point_encoding_ = encoding;
+    rebuild_transformed_paths();
+    prepare_frame_paths();
+}
 
-    if (width_ == 0 || height_ == 0 || viewport_width_ == 0 || viewport_height_ == 0) {
-        transformed_paths_ = paths_;
+void GaugeScene::rebuild_transformed_paths() {
+    transformed_bounds_.clear();
+    prepared_bounds_.clear();
+    prepared_ratios_.clear();
+    prepared_sweeps_.clear();
+    sweep_polylines_.clear();
+    path_index_.reset(0.0f, 0.0f);
+
+    geometry_borrowed_ = false;
+    if (path_records_.empty() || geometry_pending_) {
+        display_points_.clear();
+        display_fixed_points_.clear();
+        contour_starts_.clear();
+        tessellation_cached_ = false;
         return;
     }
 
-    float min_x = 0.0f;
-    float min_y = 0.0f;
-    float max_x = static_cast<float>(width_);
-    float max_y = static_cast<float>(height_);
-    bool has_points = false;
+    geometry_borrowed_ = bind_flattened_geometry();
+    tessellation_cached_ = !geometry_borrowed_ && restore_tessellation();
+    if (!geometry_borrowed_ && !tessellation_cached_) {
+        flatten_paths();
+    }
+    rebuild_path_index();
+    rebuild_sweep_polylines();
+}
+
+bool GaugeScene::bind_flattened_geometry() {
+    if (!borrowed_ranges_ || viewport_width_ != borrowed_width_ || viewport_height_ != borrowed_height_) {
+        return false;
+    }
+
+    // Points come straight from the view, so the pools give their storage back
+    std::vector<VectorRenderer::Point>().swap(display_points_);
+    std::vector<VectorRenderer::FixedPoint>().swap(display_fixed_points_);
+    std::vector<uint32_t>().swap(contour_starts_);
+    geometry_borrowed_ = true;
+
+    // Static paths keep empty ranges under a baked layer, as when flattened
+    transformed_bounds_.resize(path_records_.size());
+    for (size_t index = 0; index < path_records_.size(); ++index) {
+        TessellationRange& range = path_ranges_[index];
+        if (static_layer_baked_ && !is_dynamic_path(index)) {
+            range.point_offset = range.point_count = 0;
+            range.contour_offset = range.contour_count = 0;
+        } else {
+            // The view keeps a range for every path, dropped ones included
+            const FlattenedPathRange& flattened = borrowed_ranges_[path_records_[index].source_index];
+            range.point_offset = flattened.point_offset;
+            range.point_count = flattened.point_count;
+            range.contour_offset = flattened.contour_offset;
+            range.contour_count = flattened.contour_count;
+        }
+        transformed_bounds_[index] = compute_path_bounds(display_view(index));
+    }
+    return true;
+}
+
+void GaugeScene::flatten_paths() {
+    constexpr float kInf = std::numeric_limits<float>::infinity();
+    PathBounds source{kInf, kInf, -kInf, -kInf};
+    for (const auto& range : path_ranges_) {
+        include_command_bounds(commands_ + range.command_offset, range.command_count, source);
+    }
+
+    // Identity unless a viewport is set
+    TessellationTransform fit;
+    if (width_ != 0 && height_ != 0 && viewport_width_ != 0 && viewport_height_ != 0) {
+        const float source_width = std::max(1.0f, source.max_x - source.min_x);
+        const float source_height = std::max(1.0f, source.max_y - source.min_y);
+
+        const float scale_x = static_cast<float>(viewport_width_) / source_width;
+        const float scale_y = static_cast<float>(viewport_height_) / source_height;
+        fit.scale = std::min(scale_x, scale_y);
+
+        const float draw_width = source_width * fit.scale;
+        const float draw_height = source_height * fit.scale;
+        fit.min_x = source.min_x;
+        fit.min_y = source.min_y;
+        fit.offset_x = (static_cast<float>(viewport_width_) - draw_width) * 0.5f;
+        fit.offset_y = (static_cast<float>(viewport_height_) - draw_height) * 0.5f;
+    }
+
+    // Flattened points never leave the curves' bounds, so those decide
+    // whether fixed point can hold the viewport
+    bool fixed = (point_encoding_ == PointEncoding::Fixed12_4);
+    if (fixed) {
+        constexpr float kLimit = VectorRenderer::FixedPoint::kLimit;
+        const VectorRenderer::Point low = fit.apply(source.min_x, source.min_y);
+        const VectorRenderer::Point high = fit.apply(source.max_x, source.max_y);
+        fixed = std::max({std::fabs(low.x), std::fabs(low.y), std::fabs(high.x), std::fabs(high.y)}) <= kLimit;
+    }
+
+    // With a baked static layer only dynamic paths are flattened; static
+    // ones keep empty ranges
+    std::vector<TessellationRange> dynamic_ranges;
+    TessellationRange* ranges = path_ranges_.data();
+    size_t range_count = path_ranges_.size();
+    if (static_layer_baked_) {
+        for (size_t index = 0; index < path_ranges_.size(); ++index) {
+            if (is_dynamic_path(index)) {
+                dynamic_ranges.push_back(path_ranges_[index]);
+            }
+        }
+        ranges = dynamic_ranges.data();
+        range_count = dynamic_ranges.size();
+    }
 
-    for (const auto& path : paths_) {
-        for (const auto& point : path.control_points) {
-            if (!has_points) {
-                min_x = max_x = point.x;
-                min_y = max_y = point.y;
-                has_points = true;
+    // The unused pool gives its storage back
+    if (fixed) {
+        std::vector<VectorRenderer::Point>().swap(display_points_);
+        tessellate_paths(commands_, ranges, range_count, fit, kFlattenTolerance,
+                         display_fixed_points_, contour_starts_, executor_);
+        simplify_paths(ranges, range_count, simplify_tolerance_, display_fixed_points_, contour_starts_, executor_);
+    } else {
+        std::vector<VectorRenderer::FixedPoint>().swap(display_fixed_points_);
+        tessellate_paths(commands_, ranges, range_count, fit, kFlattenTolerance, display_points_,
+                         contour_starts_, executor_);
+        simplify_paths(ranges, range_count, simplify_tolerance_, display_points_, contour_starts_, executor_);
+    }
+
+    if (static_layer_baked_) {
+        size_t next = 0;
+        for (size_t index = 0; index < path_ranges_.size(); ++index) {
+            TessellationRange& range = path_ranges_[index];
+            if (is_dynamic_path(index)) {
+                range = dynamic_ranges[next++];
             } else {
-                min_x = std::min(min_x, point.x);
-                min_y = std::min(min_y, point.y);
-                max_x = std::max(max_x, point.x);
-                max_y = std::max(max_y, point.y);
+                range.point_offset = range.point_count = 0;
+                range.contour_offset = range.contour_count = 0;
             }
         }
     }
 
-    if (!has_points) {
-        transformed_paths_ = paths_;
-        return;
+    transformed_bounds_.resize(path_records_.size());
+    for (size_t index = 0; index < path_records_.size(); ++index) {
+        transformed_bounds_[index] = compute_path_bounds(display_view(index));
     }
+}
 
-    const float source_width = std::max(1.0f, max_x - min_x);
-    const float source_height = std::max(1.0f, max_y - min_y);
+uint64_t GaugeScene::hash_gauge() const {
+    // Everything the flattened points and their bounds follow from
+    WordHash hash;
+    hash.add(width_);
+    hash.add(height_);
+    hash.add(static_cast<uint32_t>(path_records_.size()));
+    for (size_t index = 0; index < path_records_.size(); ++index) {
+        const PathRecord& record = path_records_[index];
+        const TessellationRange& range = path_ranges_[index];
+        hash.add(record.color);
+        hash.add(record.stroke_width);
+        hash.add(static_cast<uint32_t>(record.is_filled) | static_cast<uint32_t>(record.stroke_cap) << 8 |
+                 static_cast<uint32_t>(record.fill_rule) << 16 | static_cast<uint32_t>(is_dynamic_path(index)) << 24);
+        hash.add(range.command_count);
+        for (uint32_t i = 0; i < range.command_count; ++i) {
+            const PathCommand& cmd = commands_[range.command_offset + i];
+            hash.add(static_cast<uint32_t>(cmd.type));
+            hash.add(cmd.x1);
+            hash.add(cmd.y1);
+            hash.add(cmd.x2);
+            hash.add(cmd.y2);
+            hash.add(cmd.x3);
+            hash.add(cmd.y3);
+        }
+    }
+    return hash.value();
+}
 
-    const float scale_x = static_cast<float>(viewport_width_) / source_width;
-    const float scale_y = static_cast<float>(viewport_height_) / source_height;
-    const float uniform_scale = std::min(scale_x, scale_y);
+bool GaugeScene::restore_tessellation() {
+    TessellationCacheHeader header;
+    if (!tessellation_cache_ || tessellation_cache_size_ < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, tessellation_cache_, sizeof(header));
+    if (header.magic != kTessellationCacheMagic || header.version != kTessellationCacheVersion ||
+        header.point_encoding != static_cast<uint8_t>(point_encoding_) ||
+        header.static_layer_baked != (static_layer_baked_ ? 1 : 0) || header.gauge_hash != gauge_hash_ ||
+        header.viewport_width != viewport_width_ || header.viewport_height != viewport_height_ ||
+        header.flatten_tolerance != kFlattenTolerance || header.simplify_tolerance != simplify_tolerance_ ||
+        header.path_count != path_records_.size()) {
+        return false;
+    }
 
-    const float draw_width = source_width * uniform_scale;
-    const float draw_height = source_height * uniform_scale;
-    const float offset_x = (static_cast<float>(viewport_width_) - draw_width) * 0.5f;
-    const float offset_y = (static_cast<float>(viewport_height_) - draw_height) * 0.5f;
+    // Sizes are checked in 64 bits so no count can wrap them
+    const size_t point_size = header.fixed_points ? sizeof(VectorRenderer::FixedPoint) : sizeof(VectorRenderer::Point);
+    const uint64_t expected_size = sizeof(header) +
+                                   uint64_t{header.path_count} * (sizeof(TessellationRange) + sizeof(PathBounds)) +
+                                   uint64_t{header.contour_count} * sizeof(uint32_t) +
+                                   uint64_t{header.point_count} * point_size;
+    if (expected_size != tessellation_cache_size_) {
+        return false;
+    }
+    const uint8_t* payload = tessellation_cache_ + sizeof(header);
+    WordHash payload_hash;
+    payload_hash.add(payload, tessellation_cache_size_ - sizeof(header));
+    if (payload_hash.value() != header.payload_hash) {
+        return false;
+    }
 
-    transformed_paths_.reserve(paths_.size());
-    for (const auto& path : paths_) {
-        VectorRenderer::BezierPath transformed = path;
-        for (auto& point : transformed.control_points) {
-            point.x = (point.x - min_x) * uniform_scale + offset_x;
-            point.y = (point.y - min_y) * uniform_scale + offset_y;
+    // Every range must stay inside the pools the renderer will index
+    std::vector<TessellationRange> ranges(header.path_count);
+    std::memcpy(ranges.data(), payload, ranges.size() * sizeof(TessellationRange));
+    const uint8_t* contours = payload + header.path_count * (sizeof(TessellationRange) + sizeof(PathBounds));
+    for (const TessellationRange& range : ranges) {
+        if (range.point_offset > header.point_count || range.point_count > header.point_count - range.point_offset ||
+            range.contour_offset > header.contour_count ||
+            range.contour_count > header.contour_count - range.contour_offset) {
+            return false;
+        }
+        uint32_t previous = 0;
+        for (uint32_t c = 0; c < range.contour_count; ++c) {
+            uint32_t start;
+            std::memcpy(&start, contours + (range.contour_offset + c) * sizeof(uint32_t), sizeof(start));
+            if (start < previous || start >= range.point_count) {
+                return false;
+            }
+            previous = start;
         }
-        transformed_paths_.push_back(std::move(transformed));
     }
 
-    compute_path_y_bounds(transformed_paths_, transformed_min_y_, transformed_max_y_);
+    for (size_t index = 0; index < ranges.size(); ++index) {
+        TessellationRange& range = path_ranges_[index];
+        range.point_offset = ranges[index].point_offset;
+        range.point_count = ranges[index].point_count;
+        range.contour_offset = ranges[index].contour_offset;
+        range.contour_count = ranges[index].contour_count;
+    }
+    transformed_bounds_.resize(header.path_count);
+    std::memcpy(transformed_bounds_.data(), payload + header.path_count * sizeof(TessellationRange),
+                transformed_bounds_.size() * sizeof(PathBounds));
+    contour_starts_.resize(header.contour_count);
+    std::memcpy(contour_starts_.data(), contours, contour_starts_.size() * sizeof(uint32_t));
+
+    const uint8_t* points = contours + header.contour_count * sizeof(uint32_t);
+    if (header.fixed_points) {
+        std::vector<VectorRenderer::Point>().swap(display_points_);
+        display_fixed_points_.resize(header.point_count);
+        std::memcpy(display_fixed_points_.data(), points, display_fixed_points_.size() * point_size);
+    } else {
+        std::vector<VectorRenderer::FixedPoint>().swap(display_fixed_points_);
+        display_points_.resize(header.point_count);
+        std::memcpy(display_points_.data(), points, display_points_.size() * point_size);
+    }
+    return true;
+}
+
+bool GaugeScene::save_tessellation(std::vector<uint8_t>& out) const {
+    if (path_records_.empty() || geometry_borrowed_ || geometry_pending_) {
+        return false;
+    }
+
+    const bool fixed = !display_fixed_points_.empty();
+    TessellationCacheHeader header{};
+    header.magic = kTessellationCacheMagic;
+    header.version = kTessellationCacheVersion;
+    header.point_encoding = static_cast<uint8_t>(point_encoding_);
+    header.static_layer_baked = static_layer_baked_ ? 1 : 0;
+    header.gauge_hash = gauge_hash_;
+    header.viewport_width = viewport_width_;
+    header.viewport_height = viewport_height_;
+    header.flatten_tolerance = kFlattenTolerance;
+    header.simplify_tolerance = simplify_tolerance_;
+    header.path_count = static_cast<uint32_t>(path_ranges_.size());
+    header.contour_count = static_cast<uint32_t>(contour_starts_.size());
+    header.point_count = static_cast<uint32_t>(fixed ? display_fixed_points_.size() : display_points_.size());
+    header.fixed_points = fixed ? 1 : 0;
+
+    out.clear();
+    out.resize(sizeof(header));
+    auto append = [&out](const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        out.insert(out.end(), bytes, bytes + size);
+    };
+    append(path_ranges_.data(), path_ranges_.size() * sizeof(TessellationRange));
+    append(transformed_bounds_.data(), transformed_bounds_.size() * sizeof(PathBounds));
+    append(contour_starts_.data(), contour_starts_.size() * sizeof(uint32_t));
+    if (fixed) {
+        append(display_fixed_points_.data(), display_fixed_points_.size() * sizeof(VectorRenderer::FixedPoint));
+    } else {
+        append(display_points_.data(), display_points_.size() * sizeof(VectorRenderer::Point));
+    }
+
+    WordHash payload_hash;
+    payload_hash.add(out.data() + sizeof(header), out.size() - sizeof(header));
+    header.payload_hash = payload_hash.value();
+    std::memcpy(out.data(), &header, sizeof(header));
+    return true;
+}
+
+VectorRenderer::PathView GaugeScene::display_view(size_t index) const {
+    const PathRecord& record = path_records_[index];
+    const TessellationRange& range = path_ranges_[index];
+    VectorRenderer::PathView view;
+    if (geometry_borrowed_) {
+        view.points = borrowed_points_ + range.point_offset;
+        view.contour_starts = borrowed_contours_ + range.contour_offset;
+    } else {
+        if (display_fixed_points_.empty()) {
+            view.points = display_points_.data() + range.point_offset;
+        } else {
+            view.fixed_points = display_fixed_points_.data() + range.point_offset;
+        }
+        view.contour_starts = contour_starts_.data() + range.contour_offset;
+    }
+    view.point_count = range.point_count;
+    view.contour_count = range.contour_count;
+    view.color = record.color;
+    view.stroke_width = record.stroke_width;
+    view.is_filled = record.is_filled;
+    view.stroke_cap = record.stroke_cap;
+    view.fill_rule = record.fill_rule;
+    return view;
+}
+
+void GaugeScene::rebuild_path_index() {
+    const float extent_x = static_cast<float>(viewport_width_ ? viewport_width_ : width_);
+    const float extent_y = static_cast<float>(viewport_height_ ? viewport_height_ : height_);
+    path_index_.reset(extent_x, extent_y);
+    for (size_t index = 0; index < path_records_.size(); ++index) {
+        const SpatialGrid::Layer layer = is_dynamic_path(index) ? SpatialGrid::Layer::Dynamic
+                                                                : SpatialGrid::Layer::Static;
+        path_index_.insert(static_cast<uint32_t>(index), transformed_bounds_[index], layer);
+    }
 }
 
 void GaugeScene::update(uint32_t delta_ms) {
+    // No viewport was ever set: draw at the gauge's own units after all
+    if (geometry_pending_) {
+        geometry_pending_ = false;
+        rebuild_transformed_paths();
+    }
     animation_engine_->update(delta_ms);
     animation_time_ms_ += delta_ms;
     prepare_frame_paths();
 }
 
 void GaugeScene::rebuild_animation_lookup() {
-    animation_index_by_path_.assign(paths_.size(), -1);
+    animation_index_by_path_.assign(path_records_.size(), -1);
     for (size_t index = 0; index < runtime_animations_.size(); ++index) {
         const size_t path_index = runtime_animations_[index].path_index;
         if (path_index < animation_index_by_path_.size()) {
@@ -403,52 +875,39 @@ void GaugeScene::rebuild_animation_lookup() {
     }
 }
 
-void GaugeScene::compute_path_y_bounds(const std::vector<VectorRenderer::BezierPath>& paths,
-                                       std::vector<float>& min_y,
-                                       std::vector<float>& max_y) const {
-    min_y.assign(paths.size(), 0.0f);
-    max_y.assign(paths.size(), 0.0f);
-
-    for (size_t index = 0; index < paths.size(); ++index) {
-        const auto& path = paths[index];
-        if (path.control_points.empty()) {
-            continue;
-        }
-
-        float p_min_y = path.control_points[0].y;
-        float p_max_y = path.control_points[0].y;
-        for (const auto& point : path.control_points) {
-            p_min_y = std::min(p_min_y, point.y);
-            p_max_y = std::max(p_max_y, point.y);
-        }
-
-        float margin = 0.0f;
-        if (!path.is_filled) {
-            // Expand bounds for stroke radius + antialiasing fringe so tile culling
-            // does not miss edge pixels near tile boundaries.
-            margin = (path.stroke_width * 0.5f) + 2.0f;
-        }
+PathBounds GaugeScene::compute_path_bounds(const VectorRenderer::PathView& path) const {
+    return points_bounds(path, path_margin(path));
+}
 
-        min_y[index] = p_min_y - margin;
-        max_y[index] = p_max_y + margin;
-    }
+bool GaugeScene::is_dynamic_path(size_t index) const {
+    return index < animation_index_by_path_.size() && animation_index_by_path_[index] >= 0;
 }
 
 void GaugeScene::prepare_frame_paths() {
-    if (transformed_paths_.empty()) {
-        prepared_paths_.clear();
-        prepared_min_y_.clear();
-        prepared_max_y_.clear();
+    // Last frame's trims are no longer referenced by anyone
+    frame_arena_.reset();
+    if (path_records_.empty() || geometry_pending_) {
+        prepared_bounds_.clear();
+        prepared_ratios_.clear();
+        prepared_sweeps_.clear();
         return;
     }
 
-    prepared_paths_.resize(transformed_paths_.size());
-    for (size_t index = 0; index < transformed_paths_.size(); ++index) {
-        const auto& path = transformed_paths_[index];
-        int animation_index = (index < animation_index_by_path_.size()) ? animation_index_by_path_[index] : -1;
+    const bool first_prepare = prepared_ratios_.size() != path_records_.size();
+    if (first_prepare) {
+        // New geometry: every pixel of the viewport may have changed
+        prepared_ratios_.assign(path_records_.size(), std::numeric_limits<float>::quiet_NaN());
+        prepared_bounds_ = transformed_bounds_;
+        prepared_sweeps_.assign(path_records_.size(), PreparedSweep{});
+        add_damage(PixelRect{0, 0, damage_extent_x(), damage_extent_y()});
+    }
 
-        if (animation_index < 0 || path.is_filled) {
-            prepared_paths_[index] = path;
+    // Static paths render straight from the display pool; only the trims
+    // of animated sweeps are rebuilt, into the frame arena
+    for (size_t index = 0; index < path_records_.size(); ++index) {
+        int animation_index = (index < animation_index_by_path_.size()) ? animation_index_by_path_[index] : -1;
+        if (animation_index < 0 || path_records_[index].is_filled) {
+            // Static geometry never changes between frames
             continue;
         }
 
@@ -456,10 +915,91 @@ void GaugeScene::prepare_frame_paths() {
         const float value = get_runtime_animation_value(animation);
         const float range = std::max(0.0001f, animation.max_value - animation.min_value);
         const float ratio = std::clamp((value - animation.min_value) / range, 0.0f, 1.0f);
-        prepared_paths_[index] = trim_path_by_ratio(path, ratio, animation.reverse);
+        const float old_ratio = prepared_ratios_[index];
+        const bool changed = ratio != old_ratio;
+        const PathBounds old_bounds = prepared_bounds_[index];
+        if (!uses_sweep_map(index)) {
+            const SweepPolyline& sweep = sweep_polylines_[index];
+            PreparedSweep& prepared = prepared_sweeps_[index];
+            auto* points = frame_arena_.allocate<VectorRenderer::Point>(sweep.points.size());
+            prepared.points = points;
+            prepared.count = trim_polyline(sweep.points.data(), sweep.distance.data(), sweep.points.size(), ratio,
+                                           points);
+
+            if (changed) {
+                // Incremental index refresh: only animated paths move
+                const VectorRenderer::PathView trimmed = with_points(display_view(index), prepared.points,
+                                                                     prepared.count);
+                prepared_bounds_[index] = points_bounds(trimmed, path_margin(trimmed));
+                path_index_.update(static_cast<uint32_t>(index), prepared_bounds_[index]);
+            }
+        }
+
+        if (!changed) {
+            continue;   // Same trim as last frame: pixels unchanged
+        }
+        prepared_ratios_[index] = ratio;
+        if (first_prepare) {
+            continue;
+        }
+        if (std::fabs(ratio - old_ratio) <= kMaxIncrementalSweep) {
+            // Only the arc between the old and new cut changes: the part
+            // newly drawn when growing, the part to erase when shrinking
+            add_damage(compute_sweep_delta_bounds(index, old_ratio, ratio));
+        } else {
+            // Pixels the path left and pixels it now covers
+            add_damage(old_bounds);
+            add_damage(prepared_bounds_[index]);
+        }
+    }
+}
+
+int GaugeScene::damage_extent_x() const {
+    return static_cast<int>(viewport_width_ ? viewport_width_ : width_);
+}
+
+int GaugeScene::damage_extent_y() const {
+    return static_cast<int>(viewport_height_ ? viewport_height_ : height_);
+}
+
+void GaugeScene::add_damage(const PathBounds& bounds) {
+    if (!(bounds.min_x <= bounds.max_x && bounds.min_y <= bounds.max_y)) {
+        return;
     }
+    // Bounds already include the anti-aliasing fringe; round outwards to
+    // whole pixels and clamp in float so huge coordinates cannot overflow
+    const float extent_x = static_cast<float>(damage_extent_x());
+    const float extent_y = static_cast<float>(damage_extent_y());
+    PixelRect rect;
+    rect.x0 = static_cast<int>(std::clamp(std::floor(bounds.min_x), 0.0f, extent_x));
+    rect.y0 = static_cast<int>(std::clamp(std::floor(bounds.min_y), 0.0f, extent_y));
+    rect.x1 = static_cast<int>(std::clamp(std::floor(bounds.max_x) + 1.0f, 0.0f, extent_x));
+    rect.y1 = static_cast<int>(std::clamp(std::floor(bounds.max_y) + 1.0f, 0.0f, extent_y));
+    add_damage(rect);
+}
 
-    compute_path_y_bounds(prepared_paths_, prepared_min_y_, prepared_max_y_);
+void GaugeScene::add_damage(const PixelRect& rect) {
+    if (rect.empty()) {
+        return;
+    }
+    if (damage_.size() >= kMaxPendingDamage) {
+        // Nobody is consuming damage; keep one bounding box instead of growing
+        PixelRect& box = damage_.front();
+        for (const auto& pending : damage_) {
+            box = PixelRect{std::min(box.x0, pending.x0), std::min(box.y0, pending.y0),
+                            std::max(box.x1, pending.x1), std::max(box.y1, pending.y1)};
+        }
+        box = PixelRect{std::min(box.x0, rect.x0), std::min(box.y0, rect.y0),
+                        std::max(box.x1, rect.x1), std::max(box.y1, rect.y1)};
+        damage_.resize(1);
+        return;
+    }
+    damage_.push_back(rect);
+}
+
+void GaugeScene::take_damage(std::vector<PixelRect>& out) {
+    out.insert(out.end(), damage_.begin(), damage_.end());
+    damage_.clear();
 }
 
 float GaugeScene::get_runtime_animation_value(const RuntimePathAnimation& animation) const {
@@ -479,185 +1019,425 @@ float GaugeScene::get_runtime_animation_value(const RuntimePathAnimation& animat
     return min_value + (max_value - min_value) * normalized;
 }
 
-VectorRenderer::BezierPath GaugeScene::trim_path_by_ratio(const VectorRenderer::BezierPath& path, float ratio, bool reverse) const {
-    VectorRenderer::BezierPath trimmed = path;
-    trimmed.control_points.clear();
-
-    std::vector<VectorRenderer::Point> points = path.control_points;
-
-    // For trim-sweep on stroked paths, treat closed polylines as open by
-    // removing the duplicated closing point. Otherwise trim can wrap onto the
-    // closing segment and create detached artifacts.
-    if (!path.is_filled && points.size() >= 3) {
-        const auto& first = points.front();
-        const auto& last = points.back();
-        const float dx = last.x - first.x;
-        const float dy = last.y - first.y;
-        if ((dx * dx + dy * dy) <= 1e-4f) {
-            points.pop_back();
-        }
-    }
-
-    // Drop consecutive duplicates to avoid zero-length segments that can
-    // become isolated round-cap dots during trimming.
-    if (!points.empty()) {
-        std::vector<VectorRenderer::Point> cleaned;
-        cleaned.reserve(points.size());
-        cleaned.push_back(points.front());
-        for (size_t i = 1; i < points.size(); ++i) {
-            const float dx = points[i].x - cleaned.back().x;
-            const float dy = points[i].y - cleaned.back().y;
-            if ((dx * dx + dy * dy) > 1e-6f) {
-                cleaned.push_back(points[i]);
+void GaugeScene::rebuild_sweep_polylines() {
+    sweep_polylines_.clear();
+    sweep_polylines_.resize(path_records_.size());
+
+    for (size_t index = 0; index < path_records_.size(); ++index) {
+        const VectorRenderer::PathView path = display_view(index);
+        const int animation_index = (index < animation_index_by_path_.size()) ? animation_index_by_path_[index] : -1;
+        if (animation_index < 0 || path.is_filled) {
+            continue;
+        }
+
+        SweepPolyline& sweep = sweep_polylines_[index];
+        std::vector<VectorRenderer::Point>& points = sweep.points;
+        points.reserve(path.point_count);
+
+        // For trim-sweep on stroked paths, treat closed polylines as open by
+        // removing the duplicated closing point. Otherwise trim can wrap onto the
+        // closing segment and create detached artifacts.
+        size_t point_count = path.point_count;
+        if (point_count >= 3) {
+            const VectorRenderer::Point first = path.point(0);
+            const VectorRenderer::Point last = path.point(point_count - 1);
+            const float dx = last.x - first.x;
+            const float dy = last.y - first.y;
+            if ((dx * dx + dy * dy) <= 1e-4f) {
+                --point_count;
             }
         }
-        points = std::move(cleaned);
-    }
 
-    if (reverse) {
-        std::reverse(points.begin(), points.end());
+        // Drop consecutive duplicates to avoid zero-length segments that can
+        // become isolated round-cap dots during trimming.
+        for (size_t i = 0; i < point_count; ++i) {
+            const VectorRenderer::Point point = path.point(i);
+            if (!points.empty()) {
+                const float dx = point.x - points.back().x;
+                const float dy = point.y - points.back().y;
+                if ((dx * dx + dy * dy) <= 1e-6f) {
+                    continue;
+                }
+            }
+            points.push_back(point);
+        }
+
+        if (runtime_animations_[static_cast<size_t>(animation_index)].reverse) {
+            std::reverse(points.begin(), points.end());
+        }
+
+        // Cumulative arc length at each point
+        sweep.distance.resize(points.size());
+        float accumulated = 0.0f;
+        for (size_t i = 0; i < points.size(); ++i) {
+            if (i > 0) {
+                const float dx = points[i].x - points[i - 1].x;
+                const float dy = points[i].y - points[i - 1].y;
+                accumulated += std::sqrt(dx * dx + dy * dy);
+            }
+            sweep.distance[i] = accumulated;
+        }
     }
 
-    if (points.empty()) {
-        return trimmed;
+    // Room for every sweep's trim, so frames never grow the arena
+    size_t arena_bytes = 0;
+    for (const auto& sweep : sweep_polylines_) {
+        arena_bytes += sweep.points.size() * sizeof(VectorRenderer::Point);
     }
+    frame_arena_.reserve(arena_bytes);
 
-    if (ratio <= 0.0f) {
-        return trimmed;
+    rebuild_sweep_maps();
+}
+
+void GaugeScene::set_sweep_render_mode(SweepRenderMode mode) {
+    if (mode == sweep_render_mode_) {
+        return;
     }
+    sweep_render_mode_ = mode;
+    rebuild_sweep_maps();
 
-    if (ratio >= 1.0f) {
-        trimmed.control_points = std::move(points);
-        return trimmed;
+    // Sweeps switch between trimmed and cached geometry: prepare from scratch
+    if (!path_records_.empty()) {
+        prepared_ratios_.clear();
+        prepare_frame_paths();
     }
+}
 
-    if (points.size() < 2) {
-        return trimmed;
+bool GaugeScene::uses_sweep_map(size_t index) const {
+    return index < sweep_maps_.size() && !sweep_maps_[index].runs.empty();
+}
+
+void GaugeScene::rebuild_sweep_maps() {
+    sweep_maps_.clear();
+    if (sweep_render_mode_ != SweepRenderMode::ParameterMap) {
+        return;
     }
 
-    float total_length = 0.0f;
-    for (size_t i = 1; i < points.size(); ++i) {
-        const float dx = points[i].x - points[i - 1].x;
-        const float dy = points[i].y - points[i - 1].y;
-        total_length += std::sqrt(dx * dx + dy * dy);
+    sweep_maps_.resize(sweep_polylines_.size());
+    for (size_t index = 0; index < sweep_polylines_.size(); ++index) {
+        build_sweep_map(index, sweep_maps_[index]);
     }
+}
 
-    if (total_length <= 0.0f) {
-        return trimmed;
+void GaugeScene::build_sweep_map(size_t index, SweepMap& map) const {
+    const SweepPolyline& sweep = sweep_polylines_[index];
+    const auto& points = sweep.points;
+    const auto& distance = sweep.distance;
+    if (points.size() < 2 || distance.back() <= 0.0f) {
+        return;
     }
 
-    const float target_length = total_length * std::clamp(ratio, 0.0f, 1.0f);
-    if (target_length <= 0.5f) {
-        return trimmed;
+    // The full sweep, exactly as a trim at ratio 1 draws it
+    const VectorRenderer::PathView full = with_points(display_view(index), points.data(), points.size());
+
+    const PathBounds bounds = compute_path_bounds(full);
+    const float extent_x = static_cast<float>(damage_extent_x());
+    const float extent_y = static_cast<float>(damage_extent_y());
+    const int x0 = static_cast<int>(std::clamp(std::floor(bounds.min_x), 0.0f, extent_x));
+    const int y0 = static_cast<int>(std::clamp(std::floor(bounds.min_y), 0.0f, extent_y));
+    const int x1 = static_cast<int>(std::clamp(std::floor(bounds.max_x) + 1.0f, 0.0f, extent_x));
+    const int y1 = static_cast<int>(std::clamp(std::floor(bounds.max_y) + 1.0f, 0.0f, extent_y));
+    if (x0 >= x1 || y0 >= y1) {
+        return;
     }
-    float accumulated = 0.0f;
-    trimmed.control_points.push_back(points.front());
 
-    for (size_t i = 1; i < points.size(); ++i) {
-        const auto& prev = points[i - 1];
-        const auto& curr = points[i];
-        const float dx = curr.x - prev.x;
-        const float dy = curr.y - prev.y;
-        const float seg_length = std::sqrt(dx * dx + dy * dy);
+    const float total_length = distance.back();
+    const float reach = path_margin(full);
+    map.y0 = y0;
+    map.length = total_length;
+    map.row_runs.reserve(static_cast<size_t>(y1 - y0) + 1);
+
+    // Coverage is rasterized a band of rows at a time to bound scratch memory
+    constexpr int kBandRows = 32;
+    std::vector<uint8_t> band(static_cast<size_t>(x1) * kBandRows);
+    std::vector<size_t> band_segments;
+    VectorRenderer renderer;
+    renderer.set_quality(render_quality_);
+
+    for (int band_y = y0; band_y < y1; band_y += kBandRows) {
+        const int band_h = std::min(kBandRows, y1 - band_y);
+        std::fill(band.begin(), band.end(), 0);
+        renderer.render_path(full, band.data(), x1, band_h, x1, band_y, PixelFormat::Alpha8);
+
+        // Segments able to own a pixel of this band
+        band_segments.clear();
+        for (size_t i = 0; i + 1 < points.size(); ++i) {
+            const float seg_min_y = std::min(points[i].y, points[i + 1].y) - reach;
+            const float seg_max_y = std::max(points[i].y, points[i + 1].y) + reach;
+            if (seg_max_y >= static_cast<float>(band_y) && seg_min_y <= static_cast<float>(band_y + band_h)) {
+                band_segments.push_back(i);
+            }
+        }
 
-        if (seg_length <= 0.0f) {
-            continue;
+        for (int y = band_y; y < band_y + band_h; ++y) {
+            map.row_runs.push_back(static_cast<uint32_t>(map.runs.size()));
+            const uint8_t* row = &band[static_cast<size_t>(y - band_y) * x1];
+            const float py = static_cast<float>(y) + 0.5f;
+
+            int x = x0;
+            while (x < x1) {
+                if (row[x] == 0) {
+                    ++x;
+                    continue;
+                }
+
+                SweepRun run{static_cast<int16_t>(x), 0, UINT16_MAX, static_cast<uint32_t>(map.coverage.size())};
+                for (; x < x1 && row[x] != 0; ++x) {
+                    // Arc parameter of the nearest point on the polyline
+                    const float px = static_cast<float>(x) + 0.5f;
+                    float best_distance_sq = std::numeric_limits<float>::max();
+                    float arc = 0.0f;
+                    for (size_t i : band_segments) {
+                        const float dx = points[i + 1].x - points[i].x;
+                        const float dy = points[i + 1].y - points[i].y;
+                        const float len_sq = dx * dx + dy * dy;
+                        const float u = std::clamp(((px - points[i].x) * dx + (py - points[i].y) * dy) / len_sq,
+                                                   0.0f, 1.0f);
+                        const float ex = points[i].x + dx * u - px;
+                        const float ey = points[i].y + dy * u - py;
+                        const float distance_sq = ex * ex + ey * ey;
+                        if (distance_sq < best_distance_sq) {
+                            best_distance_sq = distance_sq;
+                            arc = distance[i] + (distance[i + 1] - distance[i]) * u;
+                        }
+                    }
+
+                    const float t = std::clamp(arc / total_length, 0.0f, 1.0f);
+                    const uint16_t t16 = static_cast<uint16_t>(t * 65535.0f + 0.5f);
+                    map.coverage.push_back(row[x]);
+                    map.t.push_back(t16);
+                    run.t_min = std::min(run.t_min, t16);
+                    ++run.length;
+                }
+                map.runs.push_back(run);
+            }
         }
+    }
+    map.row_runs.push_back(static_cast<uint32_t>(map.runs.size()));
+}
 
-        if (accumulated + seg_length < target_length) {
-            trimmed.control_points.push_back(curr);
-            accumulated += seg_length;
-            continue;
+void GaugeScene::render_sweep_map(RenderContext& context, size_t index, uint8_t* target_buffer, int height,
+                                  int stride, int y_offset, int x_begin, int x_end, PixelFormat format) const {
+    const SweepMap& map = sweep_maps_[index];
+    const float ratio = prepared_ratios_[index];
+    const float visible_length = ratio * map.length;
+    // Same visibility rule as trimming
+    if (!(ratio > 0.0f) || (ratio < 1.0f && visible_length <= 0.5f)) {
+        return;
+    }
+
+    // Pixel weight falls from 1 to 0 over the pixel straddling the cut
+    const bool whole = ratio >= 1.0f;
+    const float scale = map.length / 65535.0f;
+    const float bias = visible_length + 0.5f;
+
+    const int row_count = static_cast<int>(map.row_runs.size()) - 1;
+    const int y_begin = std::max(y_offset, map.y0);
+    const int y_end = std::min(y_offset + height, map.y0 + row_count);
+    for (int y = y_begin; y < y_end; ++y) {
+        uint8_t* row = target_buffer + static_cast<size_t>(y - y_offset) * stride;
+        const uint32_t first = map.row_runs[static_cast<size_t>(y - map.y0)];
+        const uint32_t last = map.row_runs[static_cast<size_t>(y - map.y0) + 1];
+        for (uint32_t r = first; r < last; ++r) {
+            const SweepRun& run = map.runs[r];
+            if (!whole && static_cast<float>(run.t_min) * scale >= bias) {
+                continue;   // Run lies entirely past the cut
+            }
+
+            const int run_begin = std::max<int>(run.x, x_begin);
+            const int run_end = std::min<int>(run.x + run.length, x_end);
+            if (run_begin >= run_end) {
+                continue;
+            }
+
+            const size_t count = static_cast<size_t>(run_end - run_begin);
+            if (context.sweep_coverage.size() < count) {
+                context.sweep_coverage.resize(count);
+            }
+            const size_t offset = run.offset + static_cast<size_t>(run_begin - run.x);
+            const uint8_t* coverage = &map.coverage[offset];
+            const uint16_t* t = &map.t[offset];
+            uint8_t* out = context.sweep_coverage.data();
+            if (whole) {
+                std::memcpy(out, coverage, count);
+            } else {
+                for (size_t i = 0; i < count; ++i) {
+                    const float weight = std::clamp(bias - static_cast<float>(t[i]) * scale, 0.0f, 1.0f);
+                    out[i] = static_cast<uint8_t>(static_cast<float>(coverage[i]) * weight + 0.5f);
+                }
+            }
+            context.renderer.blend_coverage(display_view(index), row, run_begin, out, count, format);
         }
+    }
+}
+
+PathBounds GaugeScene::compute_sweep_delta_bounds(size_t index, float old_ratio, float new_ratio) const {
+    constexpr float kInf = std::numeric_limits<float>::infinity();
+    PathBounds bounds{kInf, kInf, -kInf, -kInf};
+
+    const SweepPolyline& sweep = sweep_polylines_[index];
+    const auto& points = sweep.points;
+    const auto& distance = sweep.distance;
+    const float total_length = distance.empty() ? 0.0f : distance.back();
+    if (total_length <= 0.0f) {
+        return bounds;
+    }
 
-        const float remain = target_length - accumulated;
-        const float t = std::clamp(remain / seg_length, 0.0f, 1.0f);
-        VectorRenderer::Point cut_point;
-        cut_point.x = prev.x + dx * t;
-        cut_point.y = prev.y + dy * t;
-        trimmed.control_points.push_back(cut_point);
-        break;
+    const float old_length = trim_length(total_length, old_ratio);
+    const float new_length = trim_length(total_length, new_ratio);
+    const float margin = path_margin(display_view(index));
+
+    // Start one margin before the shorter cut: the end cap, and cap planes
+    // clipping segments near the end, reach back along the arc that far
+    const float span_begin = std::max(0.0f, std::min(old_length, new_length) - margin);
+    const float span_end = std::max(old_length, new_length);
+
+    auto include = [&bounds](float x, float y) {
+        bounds.min_x = std::min(bounds.min_x, x);
+        bounds.min_y = std::min(bounds.min_y, y);
+        bounds.max_x = std::max(bounds.max_x, x);
+        bounds.max_y = std::max(bounds.max_y, y);
+    };
+    auto include_at = [&](float length) {
+        const size_t upper = static_cast<size_t>(
+            std::lower_bound(distance.begin(), distance.end(), length) - distance.begin());
+        if (upper == 0) {
+            include(points.front().x, points.front().y);
+            return;
+        }
+        if (upper >= points.size()) {
+            include(points.back().x, points.back().y);
+            return;
+        }
+        const float seg_length = distance[upper] - distance[upper - 1];
+        const float t = (seg_length > 0.0f) ? (length - distance[upper - 1]) / seg_length : 0.0f;
+        include(points[upper - 1].x + (points[upper].x - points[upper - 1].x) * t,
+                points[upper - 1].y + (points[upper].y - points[upper - 1].y) * t);
+    };
+
+    // Segments are straight, so their cut ends and interior vertices bound them
+    const size_t first = static_cast<size_t>(
+        std::upper_bound(distance.begin(), distance.end(), span_begin) - distance.begin());
+    include_at(span_begin);
+    for (size_t i = first; i < points.size() && distance[i] < span_end; ++i) {
+        include(points[i].x, points[i].y);
     }
+    include_at(span_end);
 
-    return trimmed;
+    bounds.min_x -= margin;
+    bounds.min_y -= margin;
+    bounds.max_x += margin;
+    bounds.max_y += margin;
+    return bounds;
 }
 
 void GaugeScene::render(uint8_t* target_buffer, int width, int height,
-                        int stride, int y_offset) {
-    render_path_set(target_buffer, width, height, stride, y_offset, true, true);
+                        int stride, int y_offset, PixelFormat format) {
+    render_path_set(*default_context_, target_buffer, width, height, stride, y_offset, 0, width, true, true, format);
 }
 
 void GaugeScene::render_static(uint8_t* target_buffer, int width, int height,
-                               int stride, int y_offset) {
-    render_path_set(target_buffer, width, height, stride, y_offset, true, false);
+                               int stride, int y_offset, PixelFormat format) {
+    render_path_set(*default_context_, target_buffer, width, height, stride, y_offset, 0, width, true, false, format);
 }
 
 void GaugeScene::render_dynamic(uint8_t* target_buffer, int width, int height,
-                                int stride, int y_offset) {
-    render_path_set(target_buffer, width, height, stride, y_offset, false, true);
+                                int stride, int y_offset, PixelFormat format) {
+    render_path_set(*default_context_, target_buffer, width, height, stride, y_offset, 0, width, false, true, format);
 }
 
-void GaugeScene::render_path_set(uint8_t* target_buffer, int width, int height,
-                                 int stride, int y_offset,
-                                 bool render_static_paths,
-                                 bool render_dynamic_paths) {
-    if (!renderer_ || transformed_paths_.empty()) return;
-    if (render_dynamic_paths && prepared_paths_.empty()) {
-        prepare_frame_paths();
-        if (prepared_paths_.empty()) {
-            return;
-        }
+void GaugeScene::render(RenderContext& context, uint8_t* target_buffer, int width, int height,
+                        int stride, int y_offset, PixelFormat format) const {
+    render_path_set(context, target_buffer, width, height, stride, y_offset, 0, width, true, true, format);
+}
+
+void GaugeScene::render_static(RenderContext& context, uint8_t* target_buffer, int width, int height,
+                               int stride, int y_offset, PixelFormat format) const {
+    render_path_set(context, target_buffer, width, height, stride, y_offset, 0, width, true, false, format);
+}
+
+void GaugeScene::render_dynamic(RenderContext& context, uint8_t* target_buffer, int width, int height,
+                                int stride, int y_offset, PixelFormat format) const {
+    render_path_set(context, target_buffer, width, height, stride, y_offset, 0, width, false, true, format);
+}
+
+void GaugeScene::render_dynamic_rect(RenderContext& context, const PixelRect& rect, uint8_t* target_buffer,
+                                     int width, int height, int stride, int y_offset,
+                                     PixelFormat format) const {
+    const int y_begin = std::max(rect.y0, y_offset);
+    const int y_end = std::min(rect.y1, y_offset + height);
+    const int x_begin = std::max(rect.x0, 0);
+    const int x_end = std::min(rect.x1, width);
+    if (y_begin >= y_end || x_begin >= x_end) {
+        return;
     }
 
-    const float tile_min_y = static_cast<float>(y_offset);
-    const float tile_max_y = static_cast<float>(y_offset + height - 1);
-    
-    // Render only paths intersecting current tile
-    for (size_t index = 0; index < prepared_paths_.size(); ++index) {
-        if (index < prepared_min_y_.size() && index < prepared_max_y_.size()) {
-            if (prepared_max_y_[index] < tile_min_y || prepared_min_y_[index] > tile_max_y) {
-                continue;
-            }
+    uint8_t* rows = target_buffer + static_cast<size_t>(y_begin - y_offset) * stride;
+    render_path_set(context, rows, width, y_end - y_begin, stride, y_begin, x_begin, x_end, false, true, format);
+}
+
+void GaugeScene::render_path_set(RenderContext& context, uint8_t* target_buffer, int width, int height,
+                                 int stride, int y_offset, int x_begin, int x_end,
+                                 bool render_static_paths,
+                                 bool render_dynamic_paths,
+                                 PixelFormat format) const {
+    // Prepared state is kept in step with the display pool by load_gauge(),
+    // set_viewport() and update(), so rendering never mutates the scene
+    if (path_records_.empty() || prepared_ratios_.size() != path_records_.size()) return;
+
+    const int dynamic_quality = render_quality_;
+    const int static_quality = std::min(render_quality_, static_cast<int>(RenderQuality::Analytic));
+
+    // Render only paths whose 2D bounds intersect the current tile
+    const PathBounds tile_bounds{static_cast<float>(x_begin), static_cast<float>(y_offset),
+                                 static_cast<float>(x_end - 1), static_cast<float>(y_offset + height - 1)};
+    const uint8_t layer_mask = (render_static_paths ? SpatialGrid::kStaticMask : 0) |
+                               (render_dynamic_paths ? SpatialGrid::kDynamicMask : 0);
+    path_index_.query(tile_bounds, layer_mask, context.visible_paths);
+    context.renderer.set_clip_x(x_begin, x_end);
+
+    for (uint32_t index : context.visible_paths) {
+        const bool is_dynamic = is_dynamic_path(index);
+        if (is_dynamic && uses_sweep_map(index)) {
+            render_sweep_map(context, index, target_buffer, height, stride, y_offset,
+                             std::max(x_begin, 0), std::min(x_end, width), format);
+            continue;
         }
 
-        const bool has_animation = (index < animation_index_by_path_.size()) && (animation_index_by_path_[index] >= 0);
-        const bool is_dynamic_path = has_animation;
-        if ((is_dynamic_path && !render_dynamic_paths) || (!is_dynamic_path && !render_static_paths)) {
+        const VectorRenderer::PathView path = display_view(index);
+        if (is_dynamic && !path.is_filled) {
+            const PreparedSweep& sweep = prepared_sweeps_[index];
+            if (sweep.count >= 2) {
+                context.renderer.set_quality(dynamic_quality);
+                context.renderer.render_path(with_points(path, sweep.points, sweep.count), target_buffer,
+                                             width, height, stride, y_offset, format);
+            }
             continue;
         }
 
-        const auto& path = is_dynamic_path ? prepared_paths_[index] : transformed_paths_[index];
-        if (path.control_points.empty()) {
+        if (path.point_count == 0) {
             continue;
         }
 
-        if (!path.is_filled && path.control_points.size() < 2) {
+        if (!path.is_filled && path.point_count < 2) {
             continue;
         }
 
-        renderer_->render_path(path, target_buffer, width, height, stride, y_offset);
+        context.renderer.set_quality(is_dynamic ? dynamic_quality : static_quality);
+        context.renderer.render_path(path, target_buffer, width, height, stride, y_offset, format);
     }
 }
 
 bool GaugeScene::has_dynamic_in_region(int y_offset, int height) const {
-    if (transformed_paths_.empty()) return false;
-    if (prepared_paths_.empty()) {
-        const_cast<GaugeScene*>(this)->prepare_frame_paths();
-        if (prepared_paths_.empty()) return false;
-    }
-    const float region_min = static_cast<float>(y_offset);
-    const float region_max = static_cast<float>(y_offset + height - 1);
-    for (size_t index = 0; index < prepared_paths_.size(); ++index) {
-        bool has_animation = (index < animation_index_by_path_.size()) && (animation_index_by_path_[index] >= 0);
-        if (!has_animation) continue;
-        if (index < prepared_min_y_.size() && index < prepared_max_y_.size()) {
-            if (prepared_max_y_[index] < region_min || prepared_min_y_[index] > region_max) {
-                continue;
-            }
-            return true;
-        }
-    }
-    return false;
+    const int region_width = static_cast<int>(viewport_width_ ? viewport_width_ : width_);
+    return has_dynamic_in_rect(0, y_offset, std::max(region_width, 1), height);
+}
+
+bool GaugeScene::has_dynamic_in_rect(int x, int y, int width, int height) const {
+    if (path_records_.empty()) return false;
+    const PathBounds region{static_cast<float>(x), static_cast<float>(y),
+                            static_cast<float>(x + width - 1), static_cast<float>(y + height - 1)};
+    return path_index_.any(region, SpatialGrid::Layer::Dynamic);
 }
 
 void GaugeScene::set_pid_value(uint32_t pid_id, float value) {
@@ -666,9 +1446,18 @@ void GaugeScene::set_pid_value(uint32_t pid_id, float value) {
 }
 
 void GaugeScene::set_render_quality(int quality_level) {
-    if (renderer_) {
-        renderer_->set_quality(quality_level);
+    const int clamped = std::clamp(quality_level,
+                                   static_cast<int>(RenderQuality::NoAA),
+                                   static_cast<int>(RenderQuality::Supersampled));
+    if (clamped != render_quality_ && prepared_bounds_.size() == path_records_.size()) {
+        // A new tier re-rasterizes every dynamic path with different edges
+        for (size_t index = 0; index < prepared_bounds_.size(); ++index) {
+            if (is_dynamic_path(index)) {
+                add_damage(prepared_bounds_[index]);
+            }
+        }
     }
+    render_quality_ = clamped;
 }
 
 } // namespace digidash
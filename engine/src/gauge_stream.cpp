@@ -0,0 +1,190 @@
+#include "digidash/gauge_stream.h"
+#include <algorithm>
+#include <cstring>
+
+namespace digidash {
+
+// Commands are read straight into PathCommand storage
+static_assert(sizeof(PathCommand) == sizeof(gauge_format::CommandRecord),
+              "PathCommand must match gauge_format::CommandRecord");
+
+GaugeStreamReader::GaugeStreamReader(ByteSource& source)
+    : source_(source),
+      window_begin_(0),
+      window_end_(0),
+      position_(0),
+      commands_offset_(0),
+      commands_read_(0),
+      static_layer_data_offset_(0) {}
+
+template <typename T>
+bool GaugeStreamReader::read_records(const gauge_format::SectionEntry& entry, std::vector<T>& records) {
+    if (entry.size % sizeof(T) != 0 || !skip_to(entry.offset)) {
+        return false;
+    }
+
+    // Grow with the bytes that arrive rather than trusting the table's size
+    constexpr size_t kChunk = kWindowSize / sizeof(T);
+    records.clear();
+    for (size_t remaining = entry.size / sizeof(T); remaining > 0;) {
+        const size_t count = std::min(remaining, kChunk);
+        const size_t first = records.size();
+        records.resize(first + count);
+        if (!read_exact(records.data() + first, count * sizeof(T))) {
+            return false;
+        }
+        remaining -= count;
+    }
+    return true;
+}
+
+bool GaugeStreamReader::open() {
+    using namespace gauge_format;
+
+    FileHeader header;
+    if (!read_exact(&header, sizeof(header)) || header.magic != kMagic || header.version != kSectionedVersion) {
+        return false;
+    }
+    std::vector<SectionEntry> sections;
+    for (uint16_t i = 0; i < header.section_count; ++i) {
+        SectionEntry entry;
+        if (!read_exact(&entry, sizeof(entry))) {
+            return false;
+        }
+        sections.push_back(entry);
+    }
+
+    // Visit sections in file order; nothing is read twice
+    std::sort(sections.begin(), sections.end(),
+              [](const SectionEntry& a, const SectionEntry& b) { return a.offset < b.offset; });
+
+    view_ = GaugeView{};
+    view_.width = header.width;
+    view_.height = header.height;
+    bool bulk_seen = false;
+    for (const SectionEntry& entry : sections) {
+        if (entry.offset % kSectionAlignment != 0 || entry.offset < position_) {
+            return false;
+        }
+
+        bool ok = true;
+        switch (static_cast<SectionId>(entry.id)) {
+            case SectionId::Paths:
+                ok = !bulk_seen && read_records(entry, paths_);
+                break;
+            case SectionId::Animations:
+                ok = !bulk_seen && read_records(entry, animations_);
+                break;
+            case SectionId::Strings:
+                ok = !bulk_seen && read_records(entry, strings_);
+                break;
+            case SectionId::StaticLayers:
+                ok = !bulk_seen && read_records(entry, static_layers_);
+                break;
+            case SectionId::Commands:
+                // Layer data is only reachable after the commands
+                ok = static_layer_data_offset_ == 0 && entry.size % sizeof(PathCommand) == 0;
+                commands_offset_ = entry.offset;
+                view_.command_count = entry.size / sizeof(PathCommand);
+                bulk_seen = true;
+                break;
+            case SectionId::StaticLayerData:
+                static_layer_data_offset_ = entry.offset;
+                view_.static_layer_data_size = entry.size;
+                bulk_seen = true;
+                break;
+            default:
+                break;  // Newer section, not needed here
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+
+    view_.paths = paths_.data();
+    view_.path_count = paths_.size();
+    view_.animations = animations_.data();
+    view_.animation_count = animations_.size();
+    view_.strings = strings_.data();
+    view_.strings_size = strings_.size();
+    view_.static_layers = static_layers_.data();
+    view_.static_layer_count = static_layers_.size();
+    return BinaryGaugeLoader::validate_view(view_);
+}
+
+bool GaugeStreamReader::read_commands(PathCommand* out, size_t count) {
+    if (count == 0) {
+        return true;
+    }
+    if (commands_offset_ == 0 || count > view_.command_count - commands_read_) {
+        return false;
+    }
+    if (!skip_to(commands_offset_ + commands_read_ * sizeof(PathCommand)) ||
+        !read_exact(out, count * sizeof(PathCommand))) {
+        return false;
+    }
+    commands_read_ += count;
+    return true;
+}
+
+bool GaugeStreamReader::read_static_layer(const gauge_format::StaticLayerRecord& record,
+                                          std::vector<uint8_t>& out) {
+    if (static_layer_data_offset_ == 0 || !skip_to(static_layer_data_offset_ + record.data_offset)) {
+        return false;
+    }
+    out.resize(record.data_size);
+    return read_exact(out.data(), out.size());
+}
+
+bool GaugeStreamReader::read_exact(void* dst, size_t size) {
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    while (size > 0) {
+        if (window_begin_ == window_end_) {
+            // Large reads bypass the window
+            if (size >= kWindowSize) {
+                const size_t read = source_.read(out, size);
+                if (read == 0) {
+                    return false;
+                }
+                position_ += read;
+                out += read;
+                size -= read;
+                continue;
+            }
+            window_begin_ = 0;
+            window_end_ = source_.read(window_, kWindowSize);
+            if (window_end_ == 0) {
+                return false;
+            }
+        }
+
+        const size_t take = std::min(size, window_end_ - window_begin_);
+        std::memcpy(out, window_ + window_begin_, take);
+        window_begin_ += take;
+        position_ += take;
+        out += take;
+        size -= take;
+    }
+    return true;
+}
+
+bool GaugeStreamReader::skip_to(size_t offset) {
+    if (offset < position_) {
+        return false;
+    }
+    while (position_ < offset) {
+        if (window_begin_ == window_end_) {
+            window_begin_ = 0;
+            window_end_ = source_.read(window_, kWindowSize);
+            if (window_end_ == 0) {
+                return false;
+            }
+        }
+        const size_t take = std::min(offset - position_, window_end_ - window_begin_);
+        window_begin_ += take;
+        position_ += take;
+    }
+    return true;
+}
+
+} // namespace digidash
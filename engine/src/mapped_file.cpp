@@ -0,0 +1,75 @@
+#include "digidash/mapped_file.h"
+#include <fstream>
+
+#if !defined(ESP_PLATFORM) && (defined(__unix__) || defined(__APPLE__))
+#define DIGIDASH_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace digidash {
+
+MappedFile::MappedFile() : data_(nullptr), size_(0), mapped_(false) {}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#if defined(DIGIDASH_HAS_MMAP)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    void* address = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);    // The mapping keeps the file referenced
+    if (address != MAP_FAILED) {
+        data_ = static_cast<const uint8_t*>(address);
+        size_ = static_cast<size_t>(info.st_size);
+        mapped_ = true;
+        return true;
+    }
+#endif
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+    const std::streamoff file_size = file.tellg();
+    if (file_size <= 0) {
+        return false;
+    }
+    file.seekg(0, std::ios::beg);
+
+    buffer_.resize((static_cast<size_t>(file_size) + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+    if (!file.read(reinterpret_cast<char*>(buffer_.data()), file_size)) {
+        std::vector<uint32_t>().swap(buffer_);
+        return false;
+    }
+    data_ = reinterpret_cast<const uint8_t*>(buffer_.data());
+    size_ = static_cast<size_t>(file_size);
+    return true;
+}
+
+void MappedFile::close() {
+#if defined(DIGIDASH_HAS_MMAP)
+    if (mapped_) {
+        munmap(const_cast<uint8_t*>(data_), size_);
+    }
+#endif
+    std::vector<uint32_t>().swap(buffer_);
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+}
+
+} // namespace digidash
@@ -0,0 +1,418 @@
+#include "digidash/path_tessellator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace digidash {
+
+namespace {
+
+// Chord limit per cubic, against degenerate or absurdly scaled control points
+constexpr int kMaxCubicSegments = 256;
+
+// Paths per executor task are kept coarse: a path flattens in microseconds
+constexpr size_t kTasksPerWorker = 4;
+
+struct StorePoint {
+    VectorRenderer::Point operator()(const VectorRenderer::Point& point) const {
+        return point;
+    }
+};
+
+struct StoreFixedPoint {
+    VectorRenderer::FixedPoint operator()(const VectorRenderer::Point& point) const {
+        // Round half away from zero
+        constexpr float kScale = VectorRenderer::FixedPoint::kScale;
+        return {static_cast<int16_t>(point.x * kScale + std::copysign(0.5f, point.x)),
+                static_cast<int16_t>(point.y * kScale + std::copysign(0.5f, point.y))};
+    }
+};
+
+// Size one path's slices without evaluating any curve
+void count_path(const PathCommand* commands, TessellationRange& range, const TessellationTransform& transform,
+                float tolerance) {
+    uint32_t point_count = 0;
+    uint32_t contour_count = 0;
+    bool leading_points = false;
+    VectorRenderer::Point current = transform.apply(0.0f, 0.0f);
+
+    for (uint32_t i = 0; i < range.command_count; ++i) {
+        const PathCommand& cmd = commands[range.command_offset + i];
+        switch (cmd.type) {
+            case PathCommand::Type::MoveTo:
+                leading_points = leading_points || (contour_count == 0 && point_count > 0);
+                current = transform.apply(cmd.x1, cmd.y1);
+                ++contour_count;
+                ++point_count;
+                break;
+
+            case PathCommand::Type::LineTo:
+                current = transform.apply(cmd.x1, cmd.y1);
+                ++point_count;
+                break;
+
+            case PathCommand::Type::CubicTo: {
+                const VectorRenderer::Point p3 = transform.apply(cmd.x3, cmd.y3);
+                point_count += static_cast<uint32_t>(cubic_segment_count(
+                    current, transform.apply(cmd.x1, cmd.y1), transform.apply(cmd.x2, cmd.y2), p3, tolerance));
+                current = p3;
+                break;
+            }
+
+            case PathCommand::Type::Close:
+                if (point_count > 0) {
+                    ++point_count;
+                }
+                break;
+        }
+    }
+
+    range.point_count = point_count;
+    range.contour_count = contour_count + (leading_points ? 1 : 0);
+}
+
+// Write one path into the slices count_path() sized
+template <typename Out, typename Store>
+void write_path(const PathCommand* commands, const TessellationRange& range, const TessellationTransform& transform,
+                float tolerance, Out* points, uint32_t* contours, Store store) {
+    uint32_t point_count = 0;
+    uint32_t contour_count = 0;
+    VectorRenderer::Point current = transform.apply(0.0f, 0.0f);
+    VectorRenderer::Point contour_first = current;
+    auto add = [&](const VectorRenderer::Point& point) {
+        if (point_count == 0) {
+            contour_first = point;
+        }
+        points[point_count++] = store(point);
+    };
+
+    for (uint32_t i = 0; i < range.command_count; ++i) {
+        const PathCommand& cmd = commands[range.command_offset + i];
+        switch (cmd.type) {
+            case PathCommand::Type::MoveTo:
+                if (contour_count == 0 && point_count > 0) {
+                    contours[contour_count++] = 0;  // Points before the first MoveTo
+                }
+                current = transform.apply(cmd.x1, cmd.y1);
+                contours[contour_count++] = point_count;
+                add(current);
+                contour_first = current;
+                break;
+
+            case PathCommand::Type::LineTo:
+                current = transform.apply(cmd.x1, cmd.y1);
+                add(current);
+                break;
+
+            case PathCommand::Type::CubicTo: {
+                const VectorRenderer::Point p0 = current;
+                const VectorRenderer::Point p1 = transform.apply(cmd.x1, cmd.y1);
+                const VectorRenderer::Point p2 = transform.apply(cmd.x2, cmd.y2);
+                const VectorRenderer::Point p3 = transform.apply(cmd.x3, cmd.y3);
+                const int segments = cubic_segment_count(p0, p1, p2, p3, tolerance);
+
+                // Power basis a t^3 + b t^2 + c t + p0, stepped by h = 1 / segments
+                const float h = 1.0f / static_cast<float>(segments);
+                const float h2 = h * h;
+                const float h3 = h2 * h;
+                const float ax = -p0.x + 3.0f * (p1.x - p2.x) + p3.x;
+                const float ay = -p0.y + 3.0f * (p1.y - p2.y) + p3.y;
+                const float bx = 3.0f * (p0.x - 2.0f * p1.x + p2.x);
+                const float by = 3.0f * (p0.y - 2.0f * p1.y + p2.y);
+                const float cx = 3.0f * (p1.x - p0.x);
+                const float cy = 3.0f * (p1.y - p0.y);
+
+                float x = p0.x;
+                float y = p0.y;
+                float dx = ax * h3 + bx * h2 + cx * h;
+                float dy = ay * h3 + by * h2 + cy * h;
+                float ddx = 6.0f * ax * h3 + 2.0f * bx * h2;
+                float ddy = 6.0f * ay * h3 + 2.0f * by * h2;
+                const float dddx = 6.0f * ax * h3;
+                const float dddy = 6.0f * ay * h3;
+                for (int s = 1; s < segments; ++s) {
+                    x += dx;
+                    y += dy;
+                    dx += ddx;
+                    dy += ddy;
+                    ddx += dddx;
+                    ddy += dddy;
+                    add({x, y});
+                }
+                // The end point is exact, so rounding never accumulates across curves
+                add(p3);
+                current = p3;
+                break;
+            }
+
+            case PathCommand::Type::Close:
+                // Close the current contour by adding its first point again
+                if (point_count > 0) {
+                    add(contour_first);
+                    current = contour_first;
+                }
+                break;
+        }
+    }
+}
+
+VectorRenderer::Point load_point(const VectorRenderer::Point& point) {
+    return point;
+}
+
+VectorRenderer::Point load_point(const VectorRenderer::FixedPoint& point) {
+    constexpr float kScale = VectorRenderer::FixedPoint::kScale;
+    return {point.x / kScale, point.y / kScale};
+}
+
+float segment_distance_sq(const VectorRenderer::Point& p, const VectorRenderer::Point& a,
+                          const VectorRenderer::Point& b) {
+    const float dx = b.x - a.x;
+    const float dy = b.y - a.y;
+    const float len_sq = dx * dx + dy * dy;
+    float t = 0.0f;
+    if (len_sq > 0.0f) {
+        t = std::clamp(((p.x - a.x) * dx + (p.y - a.y) * dy) / len_sq, 0.0f, 1.0f);
+    }
+    const float ex = a.x + dx * t - p.x;
+    const float ey = a.y + dy * t - p.y;
+    return ex * ex + ey * ey;
+}
+
+// Scratch for simplifying one path at a time
+struct SimplifyScratch {
+    std::vector<uint8_t> keep;
+    std::vector<std::pair<uint32_t, uint32_t>> spans;
+};
+
+// Douglas-Peucker over one path's slice, compacting it towards its start
+template <typename Pt>
+void simplify_path(TessellationRange& range, Pt* points, uint32_t* contours, float tolerance_sq,
+                   SimplifyScratch& scratch) {
+    const uint32_t point_count = range.point_count;
+    scratch.keep.assign(point_count, 0);
+
+    uint32_t write = 0;
+    const uint32_t contour_count = std::max<uint32_t>(range.contour_count, 1);
+    for (uint32_t contour = 0; contour < contour_count; ++contour) {
+        const uint32_t begin = (range.contour_count == 0) ? 0 : contours[contour];
+        const uint32_t end = (contour + 1 < range.contour_count) ? contours[contour + 1] : point_count;
+        if (range.contour_count != 0) {
+            contours[contour] = write;
+        }
+        if (end <= begin) {
+            continue;
+        }
+
+        // Mark the points to keep, splitting at the farthest one until every
+        // span lies within tolerance of its chord
+        scratch.keep[begin] = 1;
+        scratch.keep[end - 1] = 1;
+        scratch.spans.clear();
+        scratch.spans.emplace_back(begin, end - 1);
+        while (!scratch.spans.empty()) {
+            const auto [first, last] = scratch.spans.back();
+            scratch.spans.pop_back();
+            if (last <= first + 1) {
+                continue;
+            }
+            const VectorRenderer::Point a = load_point(points[first]);
+            const VectorRenderer::Point b = load_point(points[last]);
+            float farthest_sq = tolerance_sq;
+            uint32_t farthest = 0;
+            for (uint32_t i = first + 1; i < last; ++i) {
+                const float distance_sq = segment_distance_sq(load_point(points[i]), a, b);
+                if (distance_sq > farthest_sq) {
+                    farthest_sq = distance_sq;
+                    farthest = i;
+                }
+            }
+            if (farthest != 0) {
+                scratch.keep[farthest] = 1;
+                scratch.spans.emplace_back(first, farthest);
+                scratch.spans.emplace_back(farthest, last);
+            }
+        }
+
+        // The write cursor never passes this contour's unread points
+        for (uint32_t i = begin; i < end; ++i) {
+            if (scratch.keep[i]) {
+                points[write++] = points[i];
+            }
+        }
+    }
+    range.point_count = write;
+}
+
+template <typename Pt>
+void simplify(TessellationRange* ranges, size_t range_count, float tolerance, std::vector<Pt>& points,
+              std::vector<uint32_t>& contours, TaskExecutor* executor) {
+    if (range_count == 0 || !(tolerance > 0.0f)) {
+        return;
+    }
+
+    InlineTaskExecutor inline_executor;
+    TaskExecutor& runner = executor ? *executor : inline_executor;
+    const size_t task_count = std::min(range_count, runner.worker_count() * kTasksPerWorker);
+    const float tolerance_sq = tolerance * tolerance;
+    Pt* point_pool = points.data();
+    uint32_t* contour_pool = contours.data();
+
+    // Each path shrinks within its own slice
+    runner.parallel_for(task_count, [&](size_t task, size_t) {
+        SimplifyScratch scratch;
+        const size_t begin = range_count * task / task_count;
+        const size_t end = range_count * (task + 1) / task_count;
+        for (size_t index = begin; index < end; ++index) {
+            TessellationRange& range = ranges[index];
+            simplify_path(range, point_pool + range.point_offset, contour_pool + range.contour_offset,
+                          tolerance_sq, scratch);
+        }
+    });
+
+    // Close the gaps; slices only ever move towards the front
+    size_t write = 0;
+    for (size_t index = 0; index < range_count; ++index) {
+        TessellationRange& range = ranges[index];
+        if (range.point_offset != write) {
+            std::copy(point_pool + range.point_offset, point_pool + range.point_offset + range.point_count,
+                      point_pool + write);
+            range.point_offset = static_cast<uint32_t>(write);
+        }
+        write += range.point_count;
+    }
+    points.resize(write);
+}
+
+template <typename Out, typename Store>
+void tessellate(const PathCommand* commands, TessellationRange* ranges, size_t range_count,
+                const TessellationTransform& transform, float tolerance, std::vector<Out>& points,
+                std::vector<uint32_t>& contours, TaskExecutor* executor, Store store) {
+    points.clear();
+    contours.clear();
+    if (range_count == 0) {
+        return;
+    }
+
+    InlineTaskExecutor inline_executor;
+    TaskExecutor& runner = executor ? *executor : inline_executor;
+    const size_t task_count = std::min(range_count, runner.worker_count() * kTasksPerWorker);
+    auto for_each_range = [&](auto&& fn) {
+        runner.parallel_for(task_count, [&](size_t task, size_t) {
+            const size_t begin = range_count * task / task_count;
+            const size_t end = range_count * (task + 1) / task_count;
+            for (size_t index = begin; index < end; ++index) {
+                fn(ranges[index]);
+            }
+        });
+    };
+
+    for_each_range([&](TessellationRange& range) {
+        count_path(commands, range, transform, tolerance);
+    });
+
+    size_t point_total = 0;
+    size_t contour_total = 0;
+    for (size_t index = 0; index < range_count; ++index) {
+        ranges[index].point_offset = static_cast<uint32_t>(point_total);
+        ranges[index].contour_offset = static_cast<uint32_t>(contour_total);
+        point_total += ranges[index].point_count;
+        contour_total += ranges[index].contour_count;
+    }
+    points.resize(point_total);
+    contours.resize(contour_total);
+
+    Out* point_pool = points.data();
+    uint32_t* contour_pool = contours.data();
+    for_each_range([&](const TessellationRange& range) {
+        write_path(commands, range, transform, tolerance, point_pool + range.point_offset,
+                   contour_pool + range.contour_offset, store);
+    });
+}
+
+} // namespace
+
+int cubic_segment_count(const VectorRenderer::Point& p0, const VectorRenderer::Point& p1,
+                        const VectorRenderer::Point& p2, const VectorRenderer::Point& p3,
+                        float tolerance) {
+    // n = sqrt(3 * 2 / 8 * max |second difference of control points| / tolerance)
+    const float ax = p0.x - 2.0f * p1.x + p2.x;
+    const float ay = p0.y - 2.0f * p1.y + p2.y;
+    const float bx = p1.x - 2.0f * p2.x + p3.x;
+    const float by = p1.y - 2.0f * p2.y + p3.y;
+    const float second_difference = std::sqrt(std::max(ax * ax + ay * ay, bx * bx + by * by));
+    const float segments = std::ceil(std::sqrt(0.75f * second_difference / tolerance));
+    // Compare in float: a NaN or huge count must not overflow the cast
+    if (!(segments < static_cast<float>(kMaxCubicSegments))) {
+        return kMaxCubicSegments;
+    }
+    return std::max(1, static_cast<int>(segments));
+}
+
+void tessellate_paths(const PathCommand* commands, TessellationRange* ranges, size_t range_count,
+                      const TessellationTransform& transform, float tolerance,
+                      std::vector<VectorRenderer::Point>& points, std::vector<uint32_t>& contours,
+                      TaskExecutor* executor) {
+    tessellate(commands, ranges, range_count, transform, tolerance, points, contours, executor, StorePoint{});
+}
+
+void tessellate_paths(const PathCommand* commands, TessellationRange* ranges, size_t range_count,
+                      const TessellationTransform& transform, float tolerance,
+                      std::vector<VectorRenderer::FixedPoint>& points, std::vector<uint32_t>& contours,
+                      TaskExecutor* executor) {
+    tessellate(commands, ranges, range_count, transform, tolerance, points, contours, executor,
+               StoreFixedPoint{});
+}
+
+void simplify_paths(TessellationRange* ranges, size_t range_count, float tolerance,
+                    std::vector<VectorRenderer::Point>& points, std::vector<uint32_t>& contours,
+                    TaskExecutor* executor) {
+    simplify(ranges, range_count, tolerance, points, contours, executor);
+}
+
+void simplify_paths(TessellationRange* ranges, size_t range_count, float tolerance,
+                    std::vector<VectorRenderer::FixedPoint>& points, std::vector<uint32_t>& contours,
+                    TaskExecutor* executor) {
+    simplify(ranges, range_count, tolerance, points, contours, executor);
+}
+
+size_t trim_polyline(const VectorRenderer::Point* points, const float* distance, size_t count, float ratio,
+                     VectorRenderer::Point* out) {
+    if (count == 0 || ratio <= 0.0f) {
+        return 0;
+    }
+
+    if (ratio >= 1.0f) {
+        std::copy(points, points + count, out);
+        return count;
+    }
+
+    const float total_length = distance[count - 1];
+    if (count < 2 || total_length <= 0.0f) {
+        return 0;
+    }
+
+    const float target_length = total_length * ratio;
+    if (target_length <= 0.5f) {
+        return 0;
+    }
+
+    // Every point strictly before the target length is kept whole
+    const size_t cut = static_cast<size_t>(std::lower_bound(distance + 1, distance + count, target_length) - distance);
+    std::copy(points, points + cut, out);
+    if (cut >= count) {
+        return cut;
+    }
+
+    const VectorRenderer::Point& prev = points[cut - 1];
+    const VectorRenderer::Point& curr = points[cut];
+    const float dx = curr.x - prev.x;
+    const float dy = curr.y - prev.y;
+    const float seg_length = std::sqrt(dx * dx + dy * dy);
+    const float t = std::clamp((target_length - distance[cut - 1]) / seg_length, 0.0f, 1.0f);
+    out[cut] = VectorRenderer::Point{prev.x + dx * t, prev.y + dy * t};
+    return cut + 1;
+}
+
+} // namespace digidash
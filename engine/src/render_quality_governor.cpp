@@ -0,0 +1,84 @@
+#include "digidash/render_quality_governor.h"
+#include <algorithm>
+
+namespace digidash {
+
+RenderQualityGovernor::RenderQualityGovernor()
+    : RenderQualityGovernor(Config{}) {
+}
+
+RenderQualityGovernor::RenderQualityGovernor(const Config& config)
+    : config_(config) {
+    config_.min_level = std::clamp(config_.min_level, 0, 3);
+    config_.max_level = std::clamp(config_.max_level, config_.min_level, 3);
+    reset();
+}
+
+void RenderQualityGovernor::reset() {
+    level_ = std::clamp(config_.initial_level, config_.min_level, config_.max_level);
+    average_ms_ = 0.0f;
+    has_average_ = false;
+    settle_remaining_ = 0;
+    calm_frames_ = 0;
+    frames_since_upgrade_ = UINT32_MAX;
+    for (uint32_t& hold : upgrade_hold_) {
+        hold = config_.upgrade_hold_frames;
+    }
+}
+
+void RenderQualityGovernor::change_level(int new_level) {
+    level_ = new_level;
+    calm_frames_ = 0;
+    settle_remaining_ = config_.settle_frames;
+    // The average describes the old tier; let the new one establish its own
+    has_average_ = false;
+}
+
+int RenderQualityGovernor::submit_frame_time(float frame_ms) {
+    if (frame_ms < 0.0f) {
+        frame_ms = 0.0f;
+    }
+    if (frames_since_upgrade_ != UINT32_MAX) {
+        ++frames_since_upgrade_;
+    }
+
+    if (!has_average_) {
+        average_ms_ = frame_ms;
+        has_average_ = true;
+    } else {
+        average_ms_ += (frame_ms - average_ms_) * config_.smoothing;
+    }
+
+    if (settle_remaining_ > 0) {
+        --settle_remaining_;
+        return level_;
+    }
+
+    if (average_ms_ > config_.target_frame_ms) {
+        if (level_ > config_.min_level) {
+            // An upgrade that could not hold the budget: wait longer next time
+            const int failed_level = level_;
+            const uint32_t hold_window = upgrade_hold_[failed_level];
+            if (frames_since_upgrade_ <= hold_window) {
+                upgrade_hold_[failed_level] = std::min(hold_window * 2, config_.max_upgrade_hold_frames);
+            }
+            frames_since_upgrade_ = UINT32_MAX;
+            change_level(level_ - 1);
+        }
+        return level_;
+    }
+
+    if (level_ < config_.max_level &&
+        average_ms_ < config_.target_frame_ms * config_.upgrade_ratio) {
+        ++calm_frames_;
+        if (calm_frames_ >= upgrade_hold_[level_ + 1]) {
+            frames_since_upgrade_ = 0;
+            change_level(level_ + 1);
+        }
+    } else {
+        calm_frames_ = 0;
+    }
+    return level_;
+}
+
+} // namespace digidash
@@ -0,0 +1,102 @@
+#include "digidash/rle565.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace digidash {
+
+namespace {
+
+constexpr uint8_t kRunFlag = 0x80;
+constexpr uint8_t kLongFlag = 0x40;
+constexpr size_t kShortLimit = 64;          // Lengths that fit the header byte
+constexpr size_t kMaxPacket = 64 * 256;     // 14-bit length - 1
+
+void write_header(std::vector<uint8_t>& out, uint8_t kind, size_t length) {
+    const size_t field = length - 1;
+    if (length <= kShortLimit) {
+        out.push_back(static_cast<uint8_t>(kind | field));
+    } else {
+        out.push_back(static_cast<uint8_t>(kind | kLongFlag | (field >> 8)));
+        out.push_back(static_cast<uint8_t>(field & 0xFF));
+    }
+}
+
+void write_pixel(std::vector<uint8_t>& out, uint16_t pixel) {
+    out.push_back(static_cast<uint8_t>(pixel & 0xFF));
+    out.push_back(static_cast<uint8_t>(pixel >> 8));
+}
+
+size_t run_length(const uint16_t* pixels, size_t begin, size_t end) {
+    size_t i = begin + 1;
+    while (i < end && i - begin < kMaxPacket && pixels[i] == pixels[begin]) {
+        ++i;
+    }
+    return i - begin;
+}
+
+} // namespace
+
+void rle565_encode(const uint16_t* pixels, size_t pixel_count, std::vector<uint8_t>& out) {
+    out.clear();
+    size_t i = 0;
+    while (i < pixel_count) {
+        const size_t run = run_length(pixels, i, pixel_count);
+        if (run >= 2) {
+            write_header(out, kRunFlag, run);
+            write_pixel(out, pixels[i]);
+            i += run;
+            continue;
+        }
+
+        // Literals up to the next pair of equal pixels
+        size_t end = i + 1;
+        while (end < pixel_count && end - i < kMaxPacket &&
+               !(end + 1 < pixel_count && pixels[end] == pixels[end + 1])) {
+            ++end;
+        }
+        write_header(out, 0, end - i);
+        for (; i < end; ++i) {
+            write_pixel(out, pixels[i]);
+        }
+    }
+}
+
+bool rle565_decode(const uint8_t* data, size_t size, uint16_t* pixels, size_t pixel_count) {
+    size_t offset = 0;
+    size_t written = 0;
+    while (offset < size) {
+        const uint8_t header = data[offset++];
+        size_t length = header & 0x3F;
+        if (header & kLongFlag) {
+            if (offset >= size) {
+                return false;
+            }
+            length = (length << 8) | data[offset++];
+        }
+        length += 1;
+        if (length > pixel_count - written) {
+            return false;
+        }
+
+        if (header & kRunFlag) {
+            if (offset + 2 > size) {
+                return false;
+            }
+            const uint16_t pixel = static_cast<uint16_t>(data[offset] | (data[offset + 1] << 8));
+            offset += 2;
+            std::fill_n(pixels + written, length, pixel);
+        } else {
+            if (offset + length * 2 > size) {
+                return false;
+            }
+            // Stored little-endian, as the targets are
+            std::memcpy(pixels + written, data + offset, length * 2);
+            offset += length * 2;
+        }
+        written += length;
+    }
+    return written == pixel_count;
+}
+
+} // namespace digidash
@@ -0,0 +1,413 @@
+#include "digidash/span_blend.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#define DIGIDASH_SPAN_X86 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define DIGIDASH_SPAN_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace digidash {
+
+namespace {
+
+// Exact round(x / 255) for x <= 65535
+inline uint32_t div255(uint32_t x) {
+    x += 128u;
+    return (x + (x >> 8)) >> 8;
+}
+
+// Exact round(x / 255) for x <= 255^3, still divide-free
+inline uint32_t div255_wide(uint32_t x) {
+    x += 127u;
+    uint32_t q = (x * 257u) >> 16;
+    q += (x - q * 255u) >= 255u ? 1u : 0u;
+    return q;
+}
+
+// ceil(65536 / n): (value + n/2) * table[n] >> 16 rounds value / n within one LSB
+constexpr std::array<uint32_t, 256> make_reciprocal_table() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t n = 1; n < 256; ++n) {
+        table[n] = (65536u + n - 1u) / n;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 256> kReciprocal = make_reciprocal_table();
+
+/**
+ * @brief Scalar src-over of one non-premultiplied pixel with source alpha @p sa
+ *
+ * Opaque and fully transparent destinations are bit-exact with the original
+ * divide-based blend; partially transparent ones are within one LSB.
+ */
+inline void blend_pixel(uint8_t* px, uint8_t r, uint8_t g, uint8_t b, uint32_t sa) {
+    if (sa == 0) {
+        return;
+    }
+    if (sa == 255) {
+        px[0] = r;
+        px[1] = g;
+        px[2] = b;
+        px[3] = 255;
+        return;
+    }
+
+    const uint32_t da = px[3];
+    if (da == 0) {
+        px[0] = r;
+        px[1] = g;
+        px[2] = b;
+        px[3] = static_cast<uint8_t>(sa);
+        return;
+    }
+    const uint32_t inv = 255u - sa;
+    const uint32_t out_a = sa + div255(da * inv);
+    const uint32_t dst_scale = da * inv;
+
+    const uint32_t num_r = r * sa + div255_wide(px[0] * dst_scale);
+    const uint32_t num_g = g * sa + div255_wide(px[1] * dst_scale);
+    const uint32_t num_b = b * sa + div255_wide(px[2] * dst_scale);
+
+    if (out_a == 255u) {
+        px[0] = static_cast<uint8_t>(div255(num_r));
+        px[1] = static_cast<uint8_t>(div255(num_g));
+        px[2] = static_cast<uint8_t>(div255(num_b));
+    } else {
+        const uint32_t recip = kReciprocal[out_a];
+        const uint32_t half = out_a >> 1;
+        px[0] = static_cast<uint8_t>(std::min(255u, ((num_r + half) * recip) >> 16));
+        px[1] = static_cast<uint8_t>(std::min(255u, ((num_g + half) * recip) >> 16));
+        px[2] = static_cast<uint8_t>(std::min(255u, ((num_b + half) * recip) >> 16));
+    }
+    px[3] = static_cast<uint8_t>(out_a);
+}
+
+void blend_span_scalar(uint8_t* dst, const uint8_t* coverage, size_t count,
+                       uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    for (size_t i = 0; i < count; ++i) {
+        blend_pixel(dst + i * 4, r, g, b, div255(static_cast<uint32_t>(a) * coverage[i]));
+    }
+}
+
+#if defined(DIGIDASH_SPAN_X86)
+
+// The vector kernels handle the pixel classes that dominate rasterized tiles:
+// empty coverage, opaque source, and fully opaque or fully transparent
+// destinations. Chunks that contain a partially transparent destination
+// under a partially transparent source drop to the scalar path.
+
+inline __m128i div255_epu16(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+void blend_span_sse2(uint8_t* dst, const uint8_t* coverage, size_t count,
+                     uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i c255_16 = _mm_set1_epi16(255);
+    const __m128i c255_32 = _mm_set1_epi32(255);
+    const __m128i alpha16 = _mm_set1_epi16(a);
+    const __m128i src16 = _mm_setr_epi16(r, g, b, 255, r, g, b, 255);
+    const __m128i src_rgb = _mm_set1_epi32(static_cast<int>(r | (g << 8) | (b << 16)));
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        uint8_t* px = dst + i * 4;
+        uint32_t cov4;
+        std::memcpy(&cov4, coverage + i, sizeof(cov4));
+        if (cov4 == 0) {
+            continue;
+        }
+
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(px));
+        const __m128i cov16 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(cov4)), zero);
+        const __m128i sa16 = div255_epu16(_mm_mullo_epi16(cov16, alpha16));
+        const __m128i sa32 = _mm_unpacklo_epi16(sa16, zero);
+        const __m128i da32 = _mm_srli_epi32(d, 24);
+
+        const __m128i sa_zero = _mm_cmpeq_epi32(sa32, zero);
+        const __m128i sa_full = _mm_cmpeq_epi32(sa32, c255_32);
+        const __m128i da_zero = _mm_cmpeq_epi32(da32, zero);
+        const __m128i da_full = _mm_cmpeq_epi32(da32, c255_32);
+        const __m128i simple = _mm_or_si128(_mm_or_si128(sa_zero, sa_full), _mm_or_si128(da_zero, da_full));
+        if (_mm_movemask_epi8(simple) != 0xFFFF) {
+            blend_span_scalar(px, coverage + i, 4, r, g, b, a);
+            continue;
+        }
+
+        // Opaque destination: out = (src * sa + dst * (255 - sa)) / 255, alpha 255
+        const __m128i sa_pair = _mm_or_si128(sa32, _mm_slli_epi32(sa32, 16));
+        const __m128i sa_lo = _mm_unpacklo_epi32(sa_pair, sa_pair);
+        const __m128i sa_hi = _mm_unpackhi_epi32(sa_pair, sa_pair);
+        const __m128i d_lo = _mm_unpacklo_epi8(d, zero);
+        const __m128i d_hi = _mm_unpackhi_epi8(d, zero);
+        const __m128i out_lo = div255_epu16(_mm_add_epi16(_mm_mullo_epi16(src16, sa_lo),
+                                                          _mm_mullo_epi16(d_lo, _mm_sub_epi16(c255_16, sa_lo))));
+        const __m128i out_hi = div255_epu16(_mm_add_epi16(_mm_mullo_epi16(src16, sa_hi),
+                                                          _mm_mullo_epi16(d_hi, _mm_sub_epi16(c255_16, sa_hi))));
+        const __m128i opaque = _mm_packus_epi16(out_lo, out_hi);
+
+        // Transparent destination: out = src color with alpha sa
+        const __m128i transparent = _mm_or_si128(src_rgb, _mm_slli_epi32(sa32, 24));
+
+        __m128i result = _mm_or_si128(_mm_and_si128(da_zero, transparent), _mm_andnot_si128(da_zero, opaque));
+        result = _mm_or_si128(_mm_and_si128(sa_zero, d), _mm_andnot_si128(sa_zero, result));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(px), result);
+    }
+
+    blend_span_scalar(dst + i * 4, coverage + i, count - i, r, g, b, a);
+}
+
+#if defined(__GNUC__)
+#define DIGIDASH_TARGET_AVX2 __attribute__((target("avx2")))
+#define DIGIDASH_HAS_AVX2_KERNEL 1
+#elif defined(__AVX2__)
+#define DIGIDASH_TARGET_AVX2
+#define DIGIDASH_HAS_AVX2_KERNEL 1
+#endif
+
+#if defined(DIGIDASH_HAS_AVX2_KERNEL)
+DIGIDASH_TARGET_AVX2 inline __m256i div255_epu16_avx2(__m256i x) {
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+DIGIDASH_TARGET_AVX2 void blend_span_avx2(uint8_t* dst, const uint8_t* coverage, size_t count,
+                                          uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i c255_16 = _mm256_set1_epi16(255);
+    const __m256i c255_32 = _mm256_set1_epi32(255);
+    const __m256i alpha32 = _mm256_set1_epi32(a);
+    const __m256i src16 = _mm256_setr_epi16(r, g, b, 255, r, g, b, 255, r, g, b, 255, r, g, b, 255);
+    const __m256i src_rgb = _mm256_set1_epi32(static_cast<int>(r | (g << 8) | (b << 16)));
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        uint8_t* px = dst + i * 4;
+        uint64_t cov8;
+        std::memcpy(&cov8, coverage + i, sizeof(cov8));
+        if (cov8 == 0) {
+            continue;
+        }
+
+        const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(px));
+        const __m256i cov32 = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(coverage + i)));
+        __m256i sa32 = _mm256_add_epi32(_mm256_mullo_epi32(cov32, alpha32), _mm256_set1_epi32(128));
+        sa32 = _mm256_srli_epi32(_mm256_add_epi32(sa32, _mm256_srli_epi32(sa32, 8)), 8);
+        const __m256i da32 = _mm256_srli_epi32(d, 24);
+
+        const __m256i sa_zero = _mm256_cmpeq_epi32(sa32, zero);
+        const __m256i sa_full = _mm256_cmpeq_epi32(sa32, c255_32);
+        const __m256i da_zero = _mm256_cmpeq_epi32(da32, zero);
+        const __m256i da_full = _mm256_cmpeq_epi32(da32, c255_32);
+        const __m256i simple = _mm256_or_si256(_mm256_or_si256(sa_zero, sa_full), _mm256_or_si256(da_zero, da_full));
+        if (_mm256_movemask_epi8(simple) != -1) {
+            blend_span_scalar(px, coverage + i, 8, r, g, b, a);
+            continue;
+        }
+
+        // Unpack/pack work within 128-bit lanes on both sides, so pixel order is preserved
+        const __m256i sa_pair = _mm256_or_si256(sa32, _mm256_slli_epi32(sa32, 16));
+        const __m256i sa_lo = _mm256_unpacklo_epi32(sa_pair, sa_pair);
+        const __m256i sa_hi = _mm256_unpackhi_epi32(sa_pair, sa_pair);
+        const __m256i d_lo = _mm256_unpacklo_epi8(d, zero);
+        const __m256i d_hi = _mm256_unpackhi_epi8(d, zero);
+        const __m256i out_lo = div255_epu16_avx2(_mm256_add_epi16(_mm256_mullo_epi16(src16, sa_lo),
+                                                                  _mm256_mullo_epi16(d_lo, _mm256_sub_epi16(c255_16, sa_lo))));
+        const __m256i out_hi = div255_epu16_avx2(_mm256_add_epi16(_mm256_mullo_epi16(src16, sa_hi),
+                                                                  _mm256_mullo_epi16(d_hi, _mm256_sub_epi16(c255_16, sa_hi))));
+        const __m256i opaque = _mm256_packus_epi16(out_lo, out_hi);
+        const __m256i transparent = _mm256_or_si256(src_rgb, _mm256_slli_epi32(sa32, 24));
+
+        __m256i result = _mm256_blendv_epi8(opaque, transparent, da_zero);
+        result = _mm256_blendv_epi8(result, d, sa_zero);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(px), result);
+    }
+
+    blend_span_scalar(dst + i * 4, coverage + i, count - i, r, g, b, a);
+}
+#endif
+
+#endif // DIGIDASH_SPAN_X86
+
+#if defined(DIGIDASH_SPAN_NEON)
+
+inline uint8x8_t div255_narrow(uint16x8_t x) {
+    x = vaddq_u16(x, vdupq_n_u16(128));
+    return vshrn_n_u16(vsraq_n_u16(x, x, 8), 8);
+}
+
+void blend_span_neon(uint8_t* dst, const uint8_t* coverage, size_t count,
+                     uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    const uint8x8_t v0 = vdup_n_u8(0);
+    const uint8x8_t v255 = vdup_n_u8(255);
+    const uint8x8_t alpha = vdup_n_u8(a);
+    const uint8x8_t src[3] = {vdup_n_u8(r), vdup_n_u8(g), vdup_n_u8(b)};
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        uint8_t* px = dst + i * 4;
+        const uint8x8_t cov = vld1_u8(coverage + i);
+        if (vget_lane_u64(vreinterpret_u64_u8(cov), 0) == 0) {
+            continue;
+        }
+
+        uint8x8x4_t d = vld4_u8(px);
+        const uint8x8_t sa = div255_narrow(vmull_u8(cov, alpha));
+        const uint8x8_t inv = vsub_u8(v255, sa);
+        const uint8x8_t sa_zero = vceq_u8(sa, v0);
+        const uint8x8_t da_zero = vceq_u8(d.val[3], v0);
+        const uint8x8_t simple = vorr_u8(vorr_u8(sa_zero, vceq_u8(sa, v255)),
+                                         vorr_u8(da_zero, vceq_u8(d.val[3], v255)));
+        if (vget_lane_u64(vreinterpret_u64_u8(simple), 0) != ~0ull) {
+            blend_span_scalar(px, coverage + i, 8, r, g, b, a);
+            continue;
+        }
+
+        for (int c = 0; c < 3; ++c) {
+            const uint8x8_t opaque = div255_narrow(vmlal_u8(vmull_u8(src[c], sa), d.val[c], inv));
+            const uint8x8_t blended = vbsl_u8(da_zero, src[c], opaque);
+            d.val[c] = vbsl_u8(sa_zero, d.val[c], blended);
+        }
+        d.val[3] = vbsl_u8(sa_zero, d.val[3], vbsl_u8(da_zero, sa, v255));
+        vst4_u8(px, d);
+    }
+
+    blend_span_scalar(dst + i * 4, coverage + i, count - i, r, g, b, a);
+}
+
+#endif // DIGIDASH_SPAN_NEON
+
+std::atomic<SpanBlendFn> g_pie_kernel{nullptr};
+
+SpanBlendFn kernel_function(SpanBlendKernel kernel) {
+    switch (kernel) {
+        case SpanBlendKernel::Scalar:
+            return blend_span_scalar;
+#if defined(DIGIDASH_SPAN_X86)
+        case SpanBlendKernel::SSE2:
+            return blend_span_sse2;
+#if defined(DIGIDASH_HAS_AVX2_KERNEL)
+        case SpanBlendKernel::AVX2:
+#if defined(__GNUC__)
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") ? blend_span_avx2 : nullptr;
+#else
+            return blend_span_avx2;
+#endif
+#endif
+#endif
+#if defined(DIGIDASH_SPAN_NEON)
+        case SpanBlendKernel::NEON:
+            return blend_span_neon;
+#endif
+        case SpanBlendKernel::PIE:
+            return g_pie_kernel.load();
+        default:
+            return nullptr;
+    }
+}
+
+SpanBlendKernel detect_best_kernel() {
+    const SpanBlendKernel preference[] = {
+        SpanBlendKernel::PIE,
+        SpanBlendKernel::AVX2,
+        SpanBlendKernel::SSE2,
+        SpanBlendKernel::NEON,
+    };
+    for (SpanBlendKernel kernel : preference) {
+        if (kernel_function(kernel)) {
+            return kernel;
+        }
+    }
+    return SpanBlendKernel::Scalar;
+}
+
+struct ActiveKernel {
+    std::atomic<SpanBlendFn> fn;
+    std::atomic<SpanBlendKernel> id;
+
+    ActiveKernel() {
+        const SpanBlendKernel best = detect_best_kernel();
+        id.store(best);
+        fn.store(kernel_function(best));
+    }
+};
+
+ActiveKernel& active_kernel() {
+    static ActiveKernel active;
+    return active;
+}
+
+} // namespace
+
+void blend_span_rgba(uint8_t* dst, const uint8_t* coverage, size_t count,
+                     uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    if (!dst || !coverage || count == 0 || a == 0) {
+        return;
+    }
+    active_kernel().fn.load(std::memory_order_relaxed)(dst, coverage, count, r, g, b, a);
+}
+
+void blend_span_rgb565(uint16_t* dst, const uint8_t* coverage, size_t count,
+                       uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    if (!dst || !coverage || count == 0 || a == 0) {
+        return;
+    }
+
+    // Spread 565 as 00000gggggg00000rrrrr000000bbbbb so a 0..32 weight can
+    // scale all three channels with a single multiply
+    constexpr uint32_t kSpreadMask = 0x07E0F81Fu;
+    constexpr uint32_t kRound = 0x02008010u;   // 16 in each channel field
+    const uint16_t src565 = static_cast<uint16_t>(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+    const uint32_t src = (src565 | (static_cast<uint32_t>(src565) << 16)) & kSpreadMask;
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t sa = div255(static_cast<uint32_t>(a) * coverage[i]);
+        const uint32_t weight = (sa * 32u + 128u) >> 8;
+        if (weight == 0) {
+            continue;
+        }
+        if (weight == 32u) {
+            dst[i] = src565;
+            continue;
+        }
+        const uint32_t d = (dst[i] | (static_cast<uint32_t>(dst[i]) << 16)) & kSpreadMask;
+        const uint32_t blended = ((d * (32u - weight) + src * weight + kRound) >> 5) & kSpreadMask;
+        dst[i] = static_cast<uint16_t>(blended | (blended >> 16));
+    }
+}
+
+SpanBlendKernel active_span_blend_kernel() {
+    return active_kernel().id.load();
+}
+
+bool span_blend_kernel_supported(SpanBlendKernel kernel) {
+    return kernel_function(kernel) != nullptr;
+}
+
+bool set_span_blend_kernel(SpanBlendKernel kernel) {
+    SpanBlendFn fn = kernel_function(kernel);
+    if (!fn) {
+        return false;
+    }
+    ActiveKernel& active = active_kernel();
+    active.fn.store(fn);
+    active.id.store(kernel);
+    return true;
+}
+
+void register_span_blend_pie_kernel(SpanBlendFn kernel) {
+    g_pie_kernel.store(kernel);
+    const SpanBlendKernel best = detect_best_kernel();
+    set_span_blend_kernel(best);
+}
+
+} // namespace digidash
@@ -0,0 +1,153 @@
+#include "digidash/spatial_grid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace digidash {
+
+void SpatialGrid::reset(float width, float height, float cell_size) {
+    cell_size = std::max(1.0f, cell_size);
+    inv_cell_size_ = 1.0f / cell_size;
+    columns_ = std::max(1, static_cast<int>(std::ceil(std::max(width, 1.0f) * inv_cell_size_)));
+    rows_ = std::max(1, static_cast<int>(std::ceil(std::max(height, 1.0f) * inv_cell_size_)));
+
+    items_.clear();
+    live_items_ = 0;
+    for (auto& layer_cells : cells_) {
+        layer_cells.assign(static_cast<size_t>(columns_) * rows_, {});
+    }
+}
+
+SpatialGrid::CellRange SpatialGrid::cell_range(const PathBounds& bounds) const {
+    // Items outside the grid are clamped into the border cells; the exact
+    // bounds test in query() rejects them when they do not overlap
+    auto to_cell = [this](float value, int limit) {
+        const float scaled = std::floor(value * inv_cell_size_);
+        if (scaled < 0.0f) return 0;
+        if (scaled >= static_cast<float>(limit)) return limit - 1;
+        return static_cast<int>(scaled);
+    };
+    return {to_cell(bounds.min_x, columns_), to_cell(bounds.min_y, rows_),
+            to_cell(bounds.max_x, columns_), to_cell(bounds.max_y, rows_)};
+}
+
+std::vector<uint32_t>& SpatialGrid::cell(Layer layer, int cx, int cy) {
+    return cells_[static_cast<size_t>(layer)][static_cast<size_t>(cy) * columns_ + cx];
+}
+
+const std::vector<uint32_t>& SpatialGrid::cell(Layer layer, int cx, int cy) const {
+    return cells_[static_cast<size_t>(layer)][static_cast<size_t>(cy) * columns_ + cx];
+}
+
+void SpatialGrid::link(uint32_t id, const Item& item) {
+    for (int cy = item.cells.y0; cy <= item.cells.y1; ++cy) {
+        for (int cx = item.cells.x0; cx <= item.cells.x1; ++cx) {
+            cell(item.layer, cx, cy).push_back(id);
+        }
+    }
+}
+
+void SpatialGrid::unlink(uint32_t id, const Item& item) {
+    for (int cy = item.cells.y0; cy <= item.cells.y1; ++cy) {
+        for (int cx = item.cells.x0; cx <= item.cells.x1; ++cx) {
+            auto& bucket = cell(item.layer, cx, cy);
+            auto it = std::find(bucket.begin(), bucket.end(), id);
+            if (it != bucket.end()) {
+                *it = bucket.back();
+                bucket.pop_back();
+            }
+        }
+    }
+}
+
+void SpatialGrid::insert(uint32_t id, const PathBounds& bounds, Layer layer) {
+    if (columns_ == 0) {
+        return;
+    }
+    if (id >= items_.size()) {
+        items_.resize(static_cast<size_t>(id) + 1, Item{{0.0f, 0.0f, 0.0f, 0.0f}, {0, 0, 0, 0}, Layer::Static, false});
+    }
+
+    Item& item = items_[id];
+    if (item.live) {
+        unlink(id, item);
+    } else {
+        ++live_items_;
+    }
+    item.bounds = bounds;
+    item.cells = cell_range(bounds);
+    item.layer = layer;
+    item.live = true;
+    link(id, item);
+}
+
+void SpatialGrid::update(uint32_t id, const PathBounds& bounds) {
+    if (id >= items_.size() || !items_[id].live) {
+        return;
+    }
+
+    Item& item = items_[id];
+    item.bounds = bounds;
+    const CellRange cells = cell_range(bounds);
+    if (cells == item.cells) {
+        return;
+    }
+    unlink(id, item);
+    item.cells = cells;
+    link(id, item);
+}
+
+void SpatialGrid::remove(uint32_t id) {
+    if (id >= items_.size() || !items_[id].live) {
+        return;
+    }
+    unlink(id, items_[id]);
+    items_[id].live = false;
+    --live_items_;
+}
+
+void SpatialGrid::query(const PathBounds& region, uint8_t layer_mask, std::vector<uint32_t>& out) const {
+    out.clear();
+    if (columns_ == 0) {
+        return;
+    }
+
+    const CellRange range = cell_range(region);
+    for (size_t layer = 0; layer < 2; ++layer) {
+        if ((layer_mask & (1u << layer)) == 0) {
+            continue;
+        }
+        for (int cy = range.y0; cy <= range.y1; ++cy) {
+            for (int cx = range.x0; cx <= range.x1; ++cx) {
+                for (uint32_t id : cell(static_cast<Layer>(layer), cx, cy)) {
+                    if (items_[id].bounds.intersects(region)) {
+                        out.push_back(id);
+                    }
+                }
+            }
+        }
+    }
+
+    // Items spanning several cells are reported once, in paint order
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+bool SpatialGrid::any(const PathBounds& region, Layer layer) const {
+    if (columns_ == 0) {
+        return false;
+    }
+
+    const CellRange range = cell_range(region);
+    for (int cy = range.y0; cy <= range.y1; ++cy) {
+        for (int cx = range.x0; cx <= range.x1; ++cx) {
+            for (uint32_t id : cell(layer, cx, cy)) {
+                if (items_[id].bounds.intersects(region)) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace digidash
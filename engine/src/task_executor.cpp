@@ -0,0 +1,137 @@
+#include "digidash/task_executor.h"
+#include <algorithm>
+
+namespace digidash {
+
+void InlineTaskExecutor::parallel_for(size_t task_count, const TaskFn& fn) {
+    for (size_t task = 0; task < task_count; ++task) {
+        fn(task, 0);
+    }
+}
+
+ThreadPoolTaskExecutor::ThreadPoolTaskExecutor(size_t worker_count)
+    : job_(nullptr)
+    , generation_(0)
+    , busy_workers_(0)
+    , stopping_(false) {
+    if (worker_count == 0) {
+        worker_count = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    queues_.reserve(worker_count);
+    for (size_t worker = 0; worker < worker_count; ++worker) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    // Worker 0 is the thread calling parallel_for
+    threads_.reserve(worker_count - 1);
+    for (size_t worker = 1; worker < worker_count; ++worker) {
+        threads_.emplace_back(&ThreadPoolTaskExecutor::worker_loop, this, worker);
+    }
+}
+
+ThreadPoolTaskExecutor::~ThreadPoolTaskExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        stopping_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void ThreadPoolTaskExecutor::parallel_for(size_t task_count, const TaskFn& fn) {
+    if (task_count == 0) {
+        return;
+    }
+    if (threads_.empty() || task_count == 1) {
+        for (size_t task = 0; task < task_count; ++task) {
+            fn(task, 0);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> dispatch_lock(dispatch_mutex_);
+
+    for (size_t task = 0; task < task_count; ++task) {
+        WorkerQueue& queue = *queues_[task % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(task);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        job_ = &fn;
+        busy_workers_ = threads_.size();
+        ++generation_;
+    }
+    start_cv_.notify_all();
+
+    run_tasks(0, fn);
+
+    // Every worker checks in before returning, so none can still hold a
+    // pointer to this call's job when the next batch starts
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    done_cv_.wait(lock, [this] { return busy_workers_ == 0; });
+    job_ = nullptr;
+}
+
+void ThreadPoolTaskExecutor::worker_loop(size_t worker) {
+    uint64_t seen_generation = 0;
+    for (;;) {
+        const TaskFn* job = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(state_mutex_);
+            start_cv_.wait(lock, [&] { return stopping_ || generation_ != seen_generation; });
+            if (stopping_) {
+                return;
+            }
+            seen_generation = generation_;
+            job = job_;
+        }
+
+        run_tasks(worker, *job);
+
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            --busy_workers_;
+            if (busy_workers_ == 0) {
+                done_cv_.notify_one();
+            }
+        }
+    }
+}
+
+void ThreadPoolTaskExecutor::run_tasks(size_t worker, const TaskFn& fn) {
+    size_t task = 0;
+    while (pop_task(worker, task)) {
+        fn(task, worker);
+    }
+}
+
+bool ThreadPoolTaskExecutor::pop_task(size_t worker, size_t& task) {
+    {
+        WorkerQueue& own = *queues_[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = own.tasks.front();
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+
+    // Steal from the back of the other queues
+    for (size_t offset = 1; offset < queues_.size(); ++offset) {
+        WorkerQueue& victim = *queues_[(worker + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.back();
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace digidash
@@ -1,7 +1,9 @@
 #include "digidash/vector_renderer.h"
+#include "digidash/span_blend.h"
 #include <cstring>
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <chrono>
 #include <unordered_map>
 #include <vector>
@@ -11,55 +13,73 @@
 namespace digidash {
 
 namespace {
-inline void blend_pixel_src_over(uint8_t* px, uint8_t src_r, uint8_t src_g, uint8_t src_b, uint8_t src_a) {
-    if (src_a == 0) {
-        return;
-    }
-    if (src_a == 255) {
-        px[0] = src_r;
-        px[1] = src_g;
-        px[2] = src_b;
-        px[3] = 255;
-        return;
-    }
 
-    const uint32_t dst_a = px[3];
-    const uint32_t inv_src_a = 255u - src_a;
-    const uint32_t out_a = src_a + ((dst_a * inv_src_a + 127u) / 255u);
-    if (out_a == 0) {
-        px[0] = 0;
-        px[1] = 0;
-        px[2] = 0;
-        px[3] = 0;
-        return;
+// Target pixel policies: the rasterizers resolve a row of coverage and hand
+// each touched run to Format::blend_span.
+struct Rgba8888Format {
+    static constexpr int kBytesPerPixel = 4;
+
+    static void blend_span(uint8_t* row, int x, const uint8_t* coverage, size_t count,
+                           uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+        blend_span_rgba(row + static_cast<size_t>(x) * kBytesPerPixel, coverage, count, r, g, b, a);
     }
+};
 
-    const uint32_t src_r_p = src_r * src_a;
-    const uint32_t src_g_p = src_g * src_a;
-    const uint32_t src_b_p = src_b * src_a;
+struct Rgb565Format {
+    static constexpr int kBytesPerPixel = 2;
 
-    const uint32_t dst_r_p = px[0] * dst_a;
-    const uint32_t dst_g_p = px[1] * dst_a;
-    const uint32_t dst_b_p = px[2] * dst_a;
+    static void blend_span(uint8_t* row, int x, const uint8_t* coverage, size_t count,
+                           uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+        blend_span_rgb565(reinterpret_cast<uint16_t*>(row) + x, coverage, count, r, g, b, a);
+    }
+};
 
-    const uint32_t out_r_p = src_r_p + ((dst_r_p * inv_src_a + 127u) / 255u);
-    const uint32_t out_g_p = src_g_p + ((dst_g_p * inv_src_a + 127u) / 255u);
-    const uint32_t out_b_p = src_b_p + ((dst_b_p * inv_src_a + 127u) / 255u);
+// Coverage mask: accumulates geometric coverage, the color is ignored
+struct Alpha8Format {
+    static constexpr int kBytesPerPixel = 1;
 
-    px[0] = static_cast<uint8_t>((out_r_p + (out_a / 2u)) / out_a);
-    px[1] = static_cast<uint8_t>((out_g_p + (out_a / 2u)) / out_a);
-    px[2] = static_cast<uint8_t>((out_b_p + (out_a / 2u)) / out_a);
-    px[3] = static_cast<uint8_t>(out_a);
-}
-}
+    static void blend_span(uint8_t* row, int x, const uint8_t* coverage, size_t count,
+                           uint8_t, uint8_t, uint8_t, uint8_t) {
+        uint8_t* dst = row + x;
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = static_cast<uint8_t>(coverage[i] + (dst[i] * (255 - coverage[i]) + 127) / 255);
+        }
+    }
+};
+
+} // anonymous namespace
 
-VectorRenderer::VectorRenderer() : quality_level_(2) {}
+VectorRenderer::VectorRenderer()
+    : quality_level_(2)
+    , clip_x_begin_(0)
+    , clip_x_end_(std::numeric_limits<int>::max()) {}
 
 VectorRenderer::~VectorRenderer() {}
 
+VectorRenderer::PathView VectorRenderer::view(const BezierPath& path) {
+    PathView view;
+    view.points = path.control_points.data();
+    view.point_count = static_cast<uint32_t>(path.control_points.size());
+    view.contour_starts = path.contour_starts.data();
+    view.contour_count = static_cast<uint32_t>(path.contour_starts.size());
+    view.color = path.color;
+    view.stroke_width = path.stroke_width;
+    view.is_filled = path.is_filled;
+    view.stroke_cap = path.stroke_cap;
+    view.fill_rule = path.fill_rule;
+    return view;
+}
+
 void VectorRenderer::render_path(const BezierPath& path, uint8_t* target_buffer,
-                                 int width, int height, int stride, int y_offset) {
-    if (!target_buffer || path.control_points.empty()) {
+                                 int width, int height, int stride, int y_offset,
+                                 PixelFormat format) {
+    render_path(view(path), target_buffer, width, height, stride, y_offset, format);
+}
+
+void VectorRenderer::render_path(const PathView& path, uint8_t* target_buffer,
+                                 int width, int height, int stride, int y_offset,
+                                 PixelFormat format) {
+    if (!target_buffer || path.point_count == 0) {
         return;
     }
     
@@ -70,22 +90,65 @@ void VectorRenderer::render_path(const BezierPath& path, uint8_t* target_buffer,
     uint8_t b = (color >> 0) & 0xFF;
     uint8_t a = (color >> 24) & 0xFF;
     
+    if (format == PixelFormat::Alpha8) {
+        if (path.is_filled) {
+            draw_filled_path<Alpha8Format>(path, target_buffer, width, height, stride, r, g, b, a, y_offset);
+        } else {
+            draw_stroked_path<Alpha8Format>(path, target_buffer, width, height, stride,
+                                            r, g, b, a, y_offset);
+        }
+        return;
+    }
+
+    if (format == PixelFormat::RGB565) {
+        // Blend straight into the display's 565 layout, no RGBA intermediate
+        if (path.is_filled) {
+            draw_filled_path<Rgb565Format>(path, target_buffer, width, height, stride, r, g, b, a, y_offset);
+        } else {
+            draw_stroked_path<Rgb565Format>(path, target_buffer, width, height, stride,
+                                            r, g, b, a, y_offset);
+        }
+        return;
+    }
+
     #ifndef ESP_PLATFORM
     // Simulator uses BGR pixel order, swap R and B
     std::swap(r, b);
     #endif
     
     if (path.is_filled) {
-        // Draw filled shape - simple polygon fill
-        draw_filled_path(path.control_points, target_buffer, width, height, 
-                        stride, r, g, b, a, y_offset);
+        // Draw filled shape - anti-aliased active edge list fill
+        draw_filled_path<Rgba8888Format>(path, target_buffer, width, height, stride, r, g, b, a, y_offset);
     } else {
         // Draw stroked path - polyline
-        draw_stroked_path(path.control_points, target_buffer, width, height,
-                         stride, r, g, b, a, path.stroke_width, path.stroke_cap, y_offset);
+        draw_stroked_path<Rgba8888Format>(path, target_buffer, width, height, stride,
+                                          r, g, b, a, y_offset);
     }
 }
 
+void VectorRenderer::blend_coverage(const PathView& path, uint8_t* row, int x, const uint8_t* coverage,
+                                    size_t count, PixelFormat format) const {
+    uint8_t r = (path.color >> 16) & 0xFF;
+    uint8_t g = (path.color >> 8) & 0xFF;
+    uint8_t b = (path.color >> 0) & 0xFF;
+    const uint8_t a = (path.color >> 24) & 0xFF;
+
+    if (format == PixelFormat::Alpha8) {
+        Alpha8Format::blend_span(row, x, coverage, count, r, g, b, a);
+        return;
+    }
+    if (format == PixelFormat::RGB565) {
+        Rgb565Format::blend_span(row, x, coverage, count, r, g, b, a);
+        return;
+    }
+
+    #ifndef ESP_PLATFORM
+    // Same channel order as render_path()
+    std::swap(r, b);
+    #endif
+    Rgba8888Format::blend_span(row, x, coverage, count, r, g, b, a);
+}
+
 void VectorRenderer::render_paths(const std::vector<BezierPath>& paths,
                                    uint8_t* target_buffer, int width, int height,
                                    int stride) {
@@ -100,10 +163,10 @@ void VectorRenderer::render_paths(const std::vector<BezierPath>& paths,
 
     for (const auto& path : paths) {
         // Build a simple hash for this path (color + fill + size + sample points)
-        size_t h = 1469598103934665603uULL;
+        size_t h = 1469598103934665603ULL;
         auto mix = [&](uint64_t v) {
             h ^= v;
-            h *= 1099511628211uULL;
+            h *= 1099511628211ULL;
         };
         mix(path.color);
         mix(path.is_filled ? 0xF00D : 0xC0DE);
@@ -161,233 +224,496 @@ void VectorRenderer::set_quality(int quality_level) {
     quality_level_ = quality_level;
 }
 
-void VectorRenderer::draw_filled_path(const std::vector<Point>& points,
-                                      uint8_t* buffer, int width, int height,
-                                      int stride, uint8_t r, uint8_t g,
-                                      uint8_t b, uint8_t a, int y_offset) {
-    // Simple flood-fill using scanline algorithm
-    if (points.empty()) return;
-    
-    // Find bounding box
-    float min_x = points[0].x, max_x = points[0].x;
-    float min_y = points[0].y, max_y = points[0].y;
-    
-    for (const auto& p : points) {
-        min_x = std::min(min_x, p.x);
-        max_x = std::max(max_x, p.x);
-        min_y = std::min(min_y, p.y);
-        max_y = std::max(max_y, p.y);
-    }
-    
-    // Clip to tile bounds (accounting for y_offset)
-    int start_y = std::max(0, (int)min_y - y_offset);
-    int end_y = std::min(height - 1, (int)max_y - y_offset + 1);
-    
-    // For each scanline in bounding box
-    for (int y = start_y; y <= end_y; ++y) {
-        std::vector<float> intersections;
-        intersections.reserve(points.size());
-        
-        // Actual y coordinate in full space
-        float actual_y = y + y_offset;
-        
-        // Find all intersections with edges
-        for (size_t i = 0; i < points.size(); ++i) {
-            size_t j = (i + 1) % points.size();
-            const Point& p1 = points[i];
-            const Point& p2 = points[j];
-            
-            // Check if edge crosses scanline at actual_y
-            if ((p1.y <= actual_y && p2.y > actual_y) || (p2.y <= actual_y && p1.y > actual_y)) {
-                float dy = p2.y - p1.y;
-                if (dy != 0.0f) {  // Avoid divide by zero
-                    float x_intersect = p1.x + (actual_y - p1.y) / dy * (p2.x - p1.x);
-                    intersections.push_back(x_intersect);
-                }
-            }
+void VectorRenderer::set_clip_x(int x_begin, int x_end) {
+    clip_x_begin_ = x_begin;
+    clip_x_end_ = x_end;
+}
+
+void VectorRenderer::reset_clip_x() {
+    clip_x_begin_ = 0;
+    clip_x_end_ = std::numeric_limits<int>::max();
+}
+
+void VectorRenderer::build_edge_table(const PathView& path, float clip_min_y, float clip_max_y) {
+    edges_.clear();
+
+    const size_t point_count = path.point_count;
+    const size_t contour_count = (path.contour_count == 0) ? 1 : path.contour_count;
+    for (size_t contour = 0; contour < contour_count; ++contour) {
+        const size_t begin = (path.contour_count == 0) ? 0 : path.contour_starts[contour];
+        const size_t end = (contour + 1 < contour_count) ? path.contour_starts[contour + 1] : point_count;
+        if (end <= begin + 1 || end > point_count) {
+            continue;
         }
-        
-        // Sort intersections
-        std::sort(intersections.begin(), intersections.end());
-        
-        // Fill between pairs of intersections
-        for (size_t i = 0; i + 1 < intersections.size(); i += 2) {
-            int x1 = std::max(0, (int)intersections[i]);
-            int x2 = std::min(width - 1, (int)intersections[i + 1] + 1);
-
-            for (int x = x1; x < x2; ++x) {
-                int pixel_offset = y * stride + x * 4;
-                buffer[pixel_offset + 0] = r;
-                buffer[pixel_offset + 1] = g;
-                buffer[pixel_offset + 2] = b;
-                buffer[pixel_offset + 3] = a;
+
+        // Every contour is implicitly closed back to its first point
+        for (size_t i = begin; i < end; ++i) {
+            const Point p0 = path.point(i);
+            const Point p1 = path.point((i + 1 < end) ? i + 1 : begin);
+            if (p0.y == p1.y) {
+                continue;
             }
+
+            Edge edge;
+            edge.winding = (p1.y > p0.y) ? 1 : -1;
+            const Point& top = (p0.y < p1.y) ? p0 : p1;
+            const Point& bottom = (p0.y < p1.y) ? p1 : p0;
+            if (bottom.y <= clip_min_y || top.y >= clip_max_y) {
+                continue;
+            }
+            edge.dxdy = (bottom.x - top.x) / (bottom.y - top.y);
+            edge.x_top = top.x;
+            edge.y_top = top.y;
+            edge.y_bottom = bottom.y;
+            edges_.push_back(edge);
         }
     }
+
+    std::sort(edges_.begin(), edges_.end(), [](const Edge& lhs, const Edge& rhs) {
+        return lhs.y_top < rhs.y_top;
+    });
 }
 
-void VectorRenderer::draw_stroked_path(const std::vector<Point>& points,
-                                       uint8_t* buffer, int width, int height,
-                                       int stride, uint8_t r, uint8_t g,
-                                       uint8_t b, uint8_t a,
-                                       float stroke_width, StrokeLineCap cap, int y_offset) {
-    if (points.empty()) return;
-    
-    // Draw line segments between consecutive points
-    for (size_t i = 0; i + 1 < points.size(); ++i) {
-        draw_line(points[i].x, points[i].y, points[i + 1].x, points[i + 1].y,
-                 buffer, width, height, stride, r, g, b, a, stroke_width, y_offset);
-    }
-    
-    // Draw caps at endpoints if round
-    if (cap == StrokeLineCap::Round && points.size() >= 2) {
-        // Round cap radius equals half the stroke width (standard SVG behavior)
-        float radius = stroke_width / 2.0f;
-        
-        // Start cap at first point - render in stroke color
-        draw_round_cap(points[0].x, points[0].y, buffer, width, height,
-                      stride, r, g, b, a, radius, y_offset);
-        
-        // End cap at last point - render in stroke color
-        draw_round_cap(points.back().x, points.back().y, buffer, width, height,
-                      stride, r, g, b, a, radius, y_offset);
-    } else if (cap == StrokeLineCap::Round && points.size() == 1) {
-        // Single point: just draw a circle at that location
-        float radius = stroke_width / 2.0f;
-        draw_round_cap(points[0].x, points[0].y, buffer, width, height,
-                      stride, r, g, b, a, radius, y_offset);
+void VectorRenderer::accumulate_span(float x_start, float x_end, int weight, int x_min, int x_max,
+                                     int& touched_min_x, int& touched_max_x) {
+    x_start = std::max(x_start, static_cast<float>(x_min));
+    x_end = std::min(x_end, static_cast<float>(x_max));
+    if (x_end <= x_start) {
+        return;
     }
+
+    // Partial coverage of the first and last pixel, full weight in between.
+    // Deltas are prefix-summed when the row is resolved.
+    const int start_px = static_cast<int>(x_start);
+    const int end_px = static_cast<int>(x_end);
+    const int start_part = static_cast<int>((1.0f - (x_start - start_px)) * weight + 0.5f);
+    const int end_part = static_cast<int>((1.0f - (x_end - end_px)) * weight + 0.5f);
+
+    coverage_delta_[start_px] += start_part;
+    coverage_delta_[start_px + 1] += weight - start_part;
+    coverage_delta_[end_px] -= end_part;
+    coverage_delta_[end_px + 1] -= weight - end_part;
+
+    touched_min_x = std::min(touched_min_x, start_px);
+    touched_max_x = std::max(touched_max_x, std::min(end_px, x_max - 1));
 }
-void VectorRenderer::draw_line(float x0, float y0, float x1, float y1,
-                                uint8_t* buffer, int width, int height,
-                                int stride, uint8_t r, uint8_t g, uint8_t b,
-                                uint8_t a, float stroke_width, int y_offset) {
-    // Draw a true thick line segment (distance-to-segment coverage),
-    // avoiding circle-stamp overdraw artifacts.
-    float dx = x1 - x0;
-    float dy = y1 - y0;
-    float len = std::sqrt(dx * dx + dy * dy);
-
-    float radius = stroke_width / 2.0f;
-
-    if (len < 0.001f) {
-        draw_round_cap(x0, y0, buffer, width, height, stride, r, g, b, a, radius, y_offset);
+
+template <typename Format>
+void VectorRenderer::draw_filled_path(const PathView& path, uint8_t* buffer, int width, int height,
+                                      int stride, uint8_t r, uint8_t g,
+                                      uint8_t b, uint8_t a, int y_offset) {
+    if (path.point_count < 3 || width <= 0 || height <= 0) return;
+
+    const float clip_min_y = static_cast<float>(y_offset);
+    const float clip_max_y = static_cast<float>(y_offset + height);
+    build_edge_table(path, clip_min_y, clip_max_y);
+    if (edges_.empty()) {
         return;
     }
 
-    const float line_min_y = std::min(y0, y1) - radius - 1.0f;
-    const float line_max_y = std::max(y0, y1) + radius + 1.0f;
-    const float tile_min_y = static_cast<float>(y_offset);
-    const float tile_max_y = static_cast<float>(y_offset + height - 1);
-    if (line_max_y < tile_min_y || line_min_y > tile_max_y) {
-        return;
+    float max_y = edges_[0].y_bottom;
+    for (const auto& edge : edges_) {
+        max_y = std::max(max_y, edge.y_bottom);
     }
 
-    const float inv_len_sq = 1.0f / (len * len);
-    const float aa_outer = radius + 0.75f;
-    const float aa_inner = std::max(0.0f, radius - 0.75f);
+    const int start_row = std::max(y_offset, static_cast<int>(std::floor(edges_[0].y_top)));
+    const int end_row = std::min(y_offset + height, static_cast<int>(std::ceil(max_y)));
 
-    const int min_x = std::max(0, static_cast<int>(std::floor(std::min(x0, x1) - aa_outer)));
-    const int max_x = std::min(width - 1, static_cast<int>(std::ceil(std::max(x0, x1) + aa_outer)));
-    const int min_y = std::max(y_offset, static_cast<int>(std::floor(std::min(y0, y1) - aa_outer)));
-    const int max_y = std::min(y_offset + height - 1, static_cast<int>(std::ceil(std::max(y0, y1) + aa_outer)));
+    if (coverage_delta_.size() < static_cast<size_t>(width) + 2) {
+        coverage_delta_.assign(static_cast<size_t>(width) + 2, 0);
+    }
+    if (coverage_row_.size() < static_cast<size_t>(width)) {
+        coverage_row_.resize(static_cast<size_t>(width));
+    }
+    active_edges_.clear();
+
+    // Quality tier -> vertical samples per pixel row; horizontal span ends are
+    // exact except at NoAA, which snaps them to pixel centres
+    static constexpr int kSubScanlinesByTier[4] = {1, 2, 4, 16};
+    const int tier = std::clamp(quality_level_, 0, 3);
+    const int sub_scanlines = kSubScanlinesByTier[tier];
+    const int sample_weight = 256 / sub_scanlines;
+    const bool snap_to_centres = (tier == static_cast<int>(RenderQuality::NoAA));
+    const int x_min = std::max(0, clip_x_begin_);
+    const int x_max = std::min(width, clip_x_end_);
+    if (x_max <= x_min) {
+        return;
+    }
+    size_t next_edge = 0;
 
-    for (int py = min_y; py <= max_y; ++py) {
-        const int tile_y = py - y_offset;
-        const float fy = static_cast<float>(py) + 0.5f;
-        for (int px = min_x; px <= max_x; ++px) {
-            const float fx = static_cast<float>(px) + 0.5f;
+    for (int row = start_row; row < end_row; ++row) {
+        int touched_min_x = width;
+        int touched_max_x = -1;
 
-            float t = ((fx - x0) * dx + (fy - y0) * dy) * inv_len_sq;
-            if (t < 0.0f) t = 0.0f;
-            if (t > 1.0f) t = 1.0f;
+        for (int sub = 0; sub < sub_scanlines; ++sub) {
+            const float sample_y = static_cast<float>(row) + (sub + 0.5f) / sub_scanlines;
 
-            const float proj_x = x0 + t * dx;
-            const float proj_y = y0 + t * dy;
-            const float ddx = fx - proj_x;
-            const float ddy = fy - proj_y;
-            const float dist = std::sqrt(ddx * ddx + ddy * ddy);
+            while (next_edge < edges_.size() && edges_[next_edge].y_top <= sample_y) {
+                active_edges_.push_back(static_cast<uint32_t>(next_edge));
+                ++next_edge;
+            }
 
-            if (dist > aa_outer) {
+            crossings_.clear();
+            size_t keep = 0;
+            for (size_t i = 0; i < active_edges_.size(); ++i) {
+                const Edge& edge = edges_[active_edges_[i]];
+                if (edge.y_bottom <= sample_y) {
+                    continue;
+                }
+                active_edges_[keep++] = active_edges_[i];
+                crossings_.push_back({edge.x_top + (sample_y - edge.y_top) * edge.dxdy, edge.winding});
+            }
+            active_edges_.resize(keep);
+
+            if (crossings_.size() < 2) {
                 continue;
             }
 
-            int offset = tile_y * stride + px * 4;
-            if (offset + 3 >= stride * height) {
+            // Active crossings stay nearly sorted between sub-scanlines
+            for (size_t i = 1; i < crossings_.size(); ++i) {
+                Crossing value = crossings_[i];
+                size_t j = i;
+                while (j > 0 && crossings_[j - 1].x > value.x) {
+                    crossings_[j] = crossings_[j - 1];
+                    --j;
+                }
+                crossings_[j] = value;
+            }
+
+            int winding = 0;
+            for (size_t i = 0; i + 1 < crossings_.size(); ++i) {
+                winding += crossings_[i].winding;
+                const bool inside = (path.fill_rule == FillRule::EvenOdd) ? ((winding & 1) != 0) : (winding != 0);
+                if (!inside) {
+                    continue;
+                }
+                float x_start = crossings_[i].x;
+                float x_end = crossings_[i + 1].x;
+                if (snap_to_centres) {
+                    x_start = std::ceil(x_start - 0.5f);
+                    x_end = std::ceil(x_end - 0.5f);
+                }
+                accumulate_span(x_start, x_end, sample_weight, x_min, x_max, touched_min_x, touched_max_x);
+            }
+        }
+
+        if (touched_max_x < touched_min_x) {
+            continue;
+        }
+
+        int coverage = 0;
+        for (int x = touched_min_x; x <= touched_max_x; ++x) {
+            coverage += coverage_delta_[x];
+            coverage_delta_[x] = 0;
+            coverage_row_[x] = static_cast<uint8_t>(std::clamp(coverage, 0, 255));
+        }
+        // Span ends may have written up to two entries past the last touched pixel
+        const int clear_end = std::min(touched_max_x + 2, width + 1);
+        for (int x = touched_max_x + 1; x <= clear_end; ++x) {
+            coverage_delta_[x] = 0;
+        }
+
+        uint8_t* row_ptr = buffer + static_cast<size_t>(row - y_offset) * stride;
+        Format::blend_span(row_ptr, touched_min_x, &coverage_row_[touched_min_x],
+                           static_cast<size_t>(touched_max_x - touched_min_x + 1), r, g, b, a);
+    }
+}
+
+void VectorRenderer::build_segment_table(const PathView& path, float reach) {
+    segments_.clear();
+    cap_planes_.clear();
+
+    SegmentEnd cap_end = SegmentEnd::Butt;
+    if (path.stroke_cap == StrokeLineCap::Round) {
+        cap_end = SegmentEnd::Round;
+    } else if (path.stroke_cap == StrokeLineCap::Square) {
+        cap_end = SegmentEnd::Square;
+    }
+
+    const size_t point_count = path.point_count;
+    const size_t contour_count = (path.contour_count == 0) ? 1 : path.contour_count;
+    for (size_t contour = 0; contour < contour_count; ++contour) {
+        const size_t begin = (path.contour_count == 0) ? 0 : path.contour_starts[contour];
+        const size_t end = (contour + 1 < contour_count) ? path.contour_starts[contour + 1] : point_count;
+        if (end <= begin || end > point_count) {
+            continue;
+        }
+
+        // Closed polylines get joins at the seam instead of two caps
+        const Point first = path.point(begin);
+        const Point last = path.point(end - 1);
+        const float close_dx = last.x - first.x;
+        const float close_dy = last.y - first.y;
+        const bool closed = (end - begin >= 3) && (close_dx * close_dx + close_dy * close_dy) <= 1e-4f;
+
+        const size_t first_segment = segments_.size();
+        for (size_t i = begin; i + 1 < end; ++i) {
+            const Point p0 = path.point(i);
+            const Point p1 = path.point(i + 1);
+            const float dx = p1.x - p0.x;
+            const float dy = p1.y - p0.y;
+            const float len_sq = dx * dx + dy * dy;
+            if (len_sq < 1e-8f) {
                 continue;
             }
 
-            if (dist <= aa_inner) {
-                blend_pixel_src_over(&buffer[offset], r, g, b, a);
-            } else {
-                const float edge = (aa_outer - dist) / (aa_outer - aa_inner);
-                const uint8_t edge_a = static_cast<uint8_t>(static_cast<float>(a) * std::max(0.0f, std::min(1.0f, edge)));
-                blend_pixel_src_over(&buffer[offset], r, g, b, edge_a);
+            StrokeSegment segment;
+            segment.x0 = p0.x;
+            segment.y0 = p0.y;
+            segment.dx = dx;
+            segment.dy = dy;
+            segment.len = std::sqrt(len_sq);
+            segment.inv_len_sq = 1.0f / len_sq;
+            segment.min_y = std::min(p0.y, p1.y) - reach;
+            segment.max_y = std::max(p0.y, p1.y) + reach;
+            segment.start_end = SegmentEnd::Join;
+            segment.end_end = SegmentEnd::Join;
+            segment.start_plane = -1;
+            segment.end_plane = -1;
+            segments_.push_back(segment);
+        }
+
+        if (segments_.size() == first_segment) {
+            // Degenerate contour: a round cap still paints a dot
+            if (cap_end == SegmentEnd::Round) {
+                StrokeSegment dot{};
+                dot.x0 = first.x;
+                dot.y0 = first.y;
+                dot.min_y = dot.y0 - reach;
+                dot.max_y = dot.y0 + reach;
+                dot.start_end = SegmentEnd::Round;
+                dot.end_end = SegmentEnd::Round;
+                dot.start_plane = -1;
+                dot.end_plane = -1;
+                segments_.push_back(dot);
+            }
+            continue;
+        }
+
+        if (!closed) {
+            segments_[first_segment].start_end = cap_end;
+            segments_.back().end_end = cap_end;
+
+            if (cap_end != SegmentEnd::Round) {
+                const StrokeSegment& head = segments_[first_segment];
+                const StrokeSegment& tail = segments_.back();
+                const int16_t head_plane = static_cast<int16_t>(cap_planes_.size());
+                cap_planes_.push_back({head.x0, head.y0, head.dx / head.len, head.dy / head.len, cap_end});
+                const int16_t tail_plane = static_cast<int16_t>(cap_planes_.size());
+                cap_planes_.push_back({tail.x0 + tail.dx, tail.y0 + tail.dy,
+                                       -tail.dx / tail.len, -tail.dy / tail.len, cap_end});
+
+                float walked = 0.0f;
+                for (size_t i = first_segment; i < segments_.size() && walked < reach; ++i) {
+                    segments_[i].start_plane = head_plane;
+                    walked += segments_[i].len;
+                }
+                walked = 0.0f;
+                for (size_t i = segments_.size(); i > first_segment && walked < reach; --i) {
+                    segments_[i - 1].end_plane = tail_plane;
+                    walked += segments_[i - 1].len;
+                }
             }
         }
     }
+
+    std::sort(segments_.begin(), segments_.end(), [](const StrokeSegment& lhs, const StrokeSegment& rhs) {
+        return lhs.min_y < rhs.min_y;
+    });
 }
 
-void VectorRenderer::draw_round_cap(float x, float y, uint8_t* buffer,
-                                    int width, int height, int stride,
-                                    uint8_t r, uint8_t g, uint8_t b, uint8_t a,
-                                    float radius, int y_offset) {
-    // Draw a filled circle at the endpoint with anti-aliasing
-    float cx = x;
-    float cy = y;
-    float rad = radius;
-    float rad_sq = rad * rad;
-    float edge_rad = rad + 1.5f;
-    float edge_rad_sq = edge_rad * edge_rad;
-    int rad_int = (int)(rad + 2.0f);
-    
-    if (rad_int <= 0) return;
-    
-    // Draw filled circle scanline by scanline with anti-aliasing
-    for (int dy = -rad_int; dy <= rad_int; ++dy) {
-        int py = cy + dy;
-        if (py < y_offset || py >= y_offset + height) continue;
-        int tile_y = py - y_offset;
-        
-        float y_dist = std::abs((float)dy);
-        if (y_dist > rad + 1.0f) continue;
-        
-        // Calculate the width of the circle at this y position
-        float dx_max_sq = rad * rad - y_dist * y_dist;
-        if (dx_max_sq < 0) continue;
-        
-        float dx_max = std::sqrt(dx_max_sq) + 1.0f;
-        int dx_max_int = (int)(dx_max + 1.0f);
-        
-        for (int dx = -(int)dx_max_int; dx <= (int)dx_max_int; ++dx) {
-            int px = cx + dx;
-            if (px < 0 || px >= width) continue;
-            
-            // Calculate distance from center
-            float dist_sq = dx * dx + dy * dy;
-            
-            // Use distance-based blending for smooth edges
-            if (dist_sq <= rad_sq) {
-                int offset = tile_y * stride + px * 4;
-                if (offset + 3 < stride * height) {
-                    buffer[offset + 0] = r;
-                    buffer[offset + 1] = g;
-                    buffer[offset + 2] = b;
-                    buffer[offset + 3] = a;
+float VectorRenderer::segment_distance_sq(const StrokeSegment& seg, float px, float py,
+                                          float radius) const {
+    const float rel_x = px - seg.x0;
+    const float rel_y = py - seg.y0;
+    if (seg.len == 0.0f) {
+        return rel_x * rel_x + rel_y * rel_y;
+    }
+
+    const float t = (rel_x * seg.dx + rel_y * seg.dy) * seg.inv_len_sq;
+    const float cross = rel_x * seg.dy - rel_y * seg.dx;
+    const float perp_sq = cross * cross * seg.inv_len_sq;
+    float along = 0.0f;
+    SegmentEnd end_kind = SegmentEnd::Join;
+    if (t < 0.0f) {
+        along = -t * seg.len;
+        end_kind = seg.start_end;
+    } else if (t > 1.0f) {
+        along = (t - 1.0f) * seg.len;
+        end_kind = seg.end_end;
+    }
+
+    float dist_sq;
+    switch (end_kind) {
+        case SegmentEnd::Butt: {
+            const float cut = radius + along;
+            dist_sq = std::max(perp_sq, cut * cut);
+            break;
+        }
+        case SegmentEnd::Square:
+            dist_sq = std::max(perp_sq, along * along);
+            break;
+        default:
+            dist_sq = perp_sq + along * along;
+            break;
+    }
+
+    const int16_t planes[2] = {seg.start_plane, seg.end_plane};
+    for (int16_t plane_index : planes) {
+        if (plane_index < 0) {
+            continue;
+        }
+        const CapPlane& plane = cap_planes_[static_cast<size_t>(plane_index)];
+        const float beyond = -((px - plane.x) * plane.ux + (py - plane.y) * plane.uy);
+        if (beyond <= 0.0f) {
+            continue;
+        }
+        const float cut = (plane.kind == SegmentEnd::Butt) ? radius + beyond : beyond;
+        dist_sq = std::max(dist_sq, cut * cut);
+    }
+    return dist_sq;
+}
+
+template <typename Format>
+void VectorRenderer::draw_stroked_path(const PathView& path, uint8_t* buffer, int width, int height,
+                                       int stride, uint8_t r, uint8_t g,
+                                       uint8_t b, uint8_t a, int y_offset) {
+    if (path.point_count == 0 || width <= 0 || height <= 0 || path.stroke_width <= 0.0f) return;
+
+    const float radius = path.stroke_width * 0.5f;
+    // Half a pixel of anti-aliasing fringe; square caps reach further at the corners
+    const float reach = ((path.stroke_cap == StrokeLineCap::Square) ? radius * 1.4143f : radius) + 1.0f;
+
+    build_segment_table(path, reach);
+    if (segments_.empty()) {
+        return;
+    }
+
+    float max_y = segments_[0].max_y;
+    for (const auto& segment : segments_) {
+        max_y = std::max(max_y, segment.max_y);
+    }
+
+    const int start_row = std::max(y_offset, static_cast<int>(std::floor(segments_[0].min_y)));
+    const int end_row = std::min(y_offset + height, static_cast<int>(std::ceil(max_y)));
+    const int x_min = std::max(0, clip_x_begin_);
+    const int x_max = std::min(width, clip_x_end_);
+    if (start_row >= end_row || x_max <= x_min) {
+        return;
+    }
+
+    // Quality tier -> distance samples per pixel and coverage filter.
+    // NoAA thresholds the centre sample at the stroke edge, EdgeAA/Analytic
+    // use a one-pixel analytic ramp, Supersampled averages a 2x2 grid of
+    // half-pixel ramps.
+    static constexpr float kCentre[1] = {0.0f};
+    static constexpr float kGridX[4] = {-0.25f, 0.25f, -0.25f, 0.25f};
+    static constexpr float kGridY[4] = {-0.25f, -0.25f, 0.25f, 0.25f};
+    const int tier = std::clamp(quality_level_, 0, 3);
+    const bool supersampled = (tier == static_cast<int>(RenderQuality::Supersampled));
+    const int sample_count = supersampled ? 4 : 1;
+    const float* sample_dx = supersampled ? kGridX : kCentre;
+    const float* sample_dy = supersampled ? kGridY : kCentre;
+    const float filter_half_width = supersampled ? 0.25f : 0.5f;
+    const float filter_scale = 0.5f / filter_half_width;
+    const float sample_norm = 255.0f / static_cast<float>(sample_count);
+    const float outer = (tier == static_cast<int>(RenderQuality::NoAA))
+                            ? std::max(radius, 0.5f)
+                            : radius + filter_half_width;
+    const float outer_sq = outer * outer;
+
+    constexpr float kFar = 3.0e38f;
+    const size_t distance_count = static_cast<size_t>(width) * sample_count;
+    if (distance_row_.size() < distance_count) {
+        distance_row_.resize(distance_count, kFar);
+    }
+    if (coverage_row_.size() < static_cast<size_t>(width)) {
+        coverage_row_.resize(static_cast<size_t>(width));
+    }
+    active_segments_.clear();
+
+    size_t next_segment = 0;
+    for (int row = start_row; row < end_row; ++row) {
+        const float row_top = static_cast<float>(row);
+        const float row_bottom = row_top + 1.0f;
+        const float fy = row_top + 0.5f;
+
+        while (next_segment < segments_.size() && segments_[next_segment].min_y < row_bottom) {
+            active_segments_.push_back(static_cast<uint32_t>(next_segment));
+            ++next_segment;
+        }
+
+        int touched_min_x = width;
+        int touched_max_x = -1;
+        size_t keep = 0;
+        for (size_t i = 0; i < active_segments_.size(); ++i) {
+            const StrokeSegment& seg = segments_[active_segments_[i]];
+            if (seg.max_y <= row_top) {
+                continue;
+            }
+            active_segments_[keep++] = active_segments_[i];
+
+            // Horizontal extent of the segment portion that can reach this row
+            float t_lo = 0.0f;
+            float t_hi = 1.0f;
+            if (seg.dy != 0.0f) {
+                const float ta = (fy - reach - seg.y0) / seg.dy;
+                const float tb = (fy + reach - seg.y0) / seg.dy;
+                t_lo = std::max(0.0f, std::min(ta, tb));
+                t_hi = std::min(1.0f, std::max(ta, tb));
+                if (t_lo > t_hi) {
+                    continue;
                 }
-            } else if (dist_sq <= edge_rad_sq) {
-                // Anti-aliased edge pixels
-                float dist = std::sqrt(dist_sq);
-                float blend = 1.0f - (dist - rad) / 1.5f;
-                int offset = tile_y * stride + px * 4;
-                if (offset + 3 < stride * height) {
-                    if (blend > 0.0f) {
-                        uint8_t edge_a = static_cast<uint8_t>(a * std::min(1.0f, std::max(0.0f, blend)));
-                        blend_pixel_src_over(&buffer[offset], r, g, b, edge_a);
+            }
+            const float xa = seg.x0 + seg.dx * t_lo;
+            const float xb = seg.x0 + seg.dx * t_hi;
+            const int x_begin = std::max(x_min, static_cast<int>(std::floor(std::min(xa, xb) - reach)));
+            const int x_end = std::min(x_max - 1, static_cast<int>(std::ceil(std::max(xa, xb) + reach)));
+            if (x_begin > x_end) {
+                continue;
+            }
+            touched_min_x = std::min(touched_min_x, x_begin);
+            touched_max_x = std::max(touched_max_x, x_end);
+
+            for (int x = x_begin; x <= x_end; ++x) {
+                float* samples = &distance_row_[static_cast<size_t>(x) * sample_count];
+                for (int sample = 0; sample < sample_count; ++sample) {
+                    const float px = static_cast<float>(x) + 0.5f + sample_dx[sample];
+                    const float dist_sq = segment_distance_sq(seg, px, fy + sample_dy[sample], radius);
+                    if (dist_sq < samples[sample]) {
+                        samples[sample] = dist_sq;
                     }
                 }
             }
         }
+        active_segments_.resize(keep);
+
+        if (touched_max_x < touched_min_x) {
+            continue;
+        }
+
+        // Resolve: one sqrt per covered sample, then one span blend for the row
+        for (int x = touched_min_x; x <= touched_max_x; ++x) {
+            float* samples = &distance_row_[static_cast<size_t>(x) * sample_count];
+            float coverage = 0.0f;
+            for (int sample = 0; sample < sample_count; ++sample) {
+                const float dist_sq = samples[sample];
+                samples[sample] = kFar;
+                if (dist_sq >= outer_sq) {
+                    continue;
+                }
+                if (tier == static_cast<int>(RenderQuality::NoAA)) {
+                    coverage += 1.0f;
+                } else {
+                    coverage += std::min(1.0f, (outer - std::sqrt(dist_sq)) * filter_scale);
+                }
+            }
+            coverage_row_[x] = static_cast<uint8_t>(coverage * sample_norm + 0.5f);
+        }
+
+        uint8_t* row_ptr = buffer + static_cast<size_t>(row - y_offset) * stride;
+        Format::blend_span(row_ptr, touched_min_x, &coverage_row_[touched_min_x],
+                           static_cast<size_t>(touched_max_x - touched_min_x + 1), r, g, b, a);
     }
 }
 
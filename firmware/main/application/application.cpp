@@ -1,8 +1,18 @@
 #include "application.h"
+#include "boot_graph.h"
+#include "init_graph.h"
+#include "digidash/gauge_stream.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include <cstring>
+#include <utility>
+
+// svg_preprocessor --embed output, found by main/CMakeLists.txt
+#if defined(DIGI_DASH_EMBEDDED_GAUGE)
+#include "embedded_gauge.h"
+#endif
 
 static const char* TAG = "Application";
 
@@ -12,14 +22,29 @@ namespace digidash {
 static constexpr uint32_t DISPLAY_WIDTH = 720;
 static constexpr uint32_t DISPLAY_HEIGHT = 720;
 static constexpr uint32_t TILE_HEIGHT = 60;
+// DirectRgb565 is opt-in: it drops the RGBA tiles and the staging pipeline
+static constexpr RenderStrategy RENDER_STRATEGY = RenderStrategy::TileHeight;
 
-// Gauge file path
+// Gauge sources: the raw gauge partition, else the file on SPIFFS
+static constexpr const char* GAUGE_PARTITION_LABEL = "gauge";
 static constexpr const char* GAUGE_FILE_PATH = "/spiffs/dashboard_tiny.gauge";
 
+// Flattened paths of the last gauge loaded, see GaugeScene::save_tessellation()
+static constexpr const char* TESSELLATION_CACHE_PATH = "/spiffs/tessellation.bin";
+
+// RLE565 static frame of the last gauge loaded, shown at boot while the
+// next one loads; see TileRenderer::save_static_frame()
+static constexpr const char* STATIC_FRAME_PATH = "/spiffs/static_frame.rle";
+
 // Frame rate
 static constexpr uint32_t TARGET_FPS = 30;
 static constexpr uint32_t FRAME_DELAY_MS = 1000 / TARGET_FPS;
 
+// Time since boot, so time-to-first-pixel can be read straight off the log
+static void log_boot_phase(const char* phase) {
+    ESP_LOGI(TAG, "Boot: %s at %llu ms", phase, (unsigned long long)(esp_timer_get_time() / 1000));
+}
+
 Application::Application()
     : display_(nullptr)
     , storage_(nullptr)
@@ -108,52 +133,142 @@ bool Application::initialize() {
 
     ESP_LOGI(TAG, "Initializing Digi-Dash Application...");
 
-    // Initialize display
-    ESP_LOGI(TAG, "Step 1/4: Initializing display subsystem");
+    // Constructing these touches no hardware; the steps below bring them up
     display_ = std::make_unique<DisplayDriver>(DISPLAY_WIDTH, DISPLAY_HEIGHT);
-    if (!display_->initialize()) {
-        ESP_LOGE(TAG, "Failed to initialize display");
-        return false;
-    }
+    renderer_ = std::make_unique<RenderEngine>(*display_, TILE_HEIGHT, RENDER_STRATEGY);
 
-    // Initialize storage
-    ESP_LOGI(TAG, "Step 2/4: Initializing storage subsystem");
+    // The graph in add_boot_steps() decides when each of these runs
+    BootSteps steps;
+    steps.display = [this] {
+        return display_->initialize();
+    };
+    steps.renderer = [this] {
+        return renderer_->initialize();
+    };
+#if !defined(DIGI_DASH_EMBEDDED_GAUGE)
+    // A compiled-in gauge leaves these out: nothing to mount or show first
     storage_ = std::make_unique<StorageManager>();
-    if (!storage_->initialize()) {
-        ESP_LOGE(TAG, "Failed to initialize storage");
+    steps.storage = [this] {
+        return storage_->initialize();
+    };
+
+    // The last gauge's static frame goes up as soon as the panel is, while
+    // the gauge may still be loading; without one the step just passes
+    steps.static_frame = [this] {
+        if (!storage_->file_exists(STATIC_FRAME_PATH) || !storage_->read_file(STATIC_FRAME_PATH, static_frame_)) {
+            static_frame_.clear();
+        }
+        return true;
+    };
+    steps.splash = [this] {
+        if (!static_frame_.empty() && renderer_->show_static_frame(static_frame_.data(), static_frame_.size())) {
+            log_boot_phase("first pixel (stored static frame)");
+        }
+        return true;
+    };
+#endif
+    steps.gauge = [this] {
+        return load_gauge();
+    };
+    // Replaces the splash: the gauge load damaged the whole frame
+    steps.first_frame = [this] {
+        renderer_->render_frame();
+        log_boot_phase("first live frame");
+        return true;
+    };
+
+    InitGraph graph;
+    add_boot_steps(graph, std::move(steps));
+    if (!graph.run()) {
+        ESP_LOGE(TAG, "Start-up failed, see the steps above");
         return false;
     }
 
-    // Initialize rendering engine
-    ESP_LOGI(TAG, "Step 3/4: Initializing rendering engine");
-    renderer_ = std::make_unique<RenderEngine>(*display_, TILE_HEIGHT);
-    if (!renderer_->initialize()) {
-        ESP_LOGE(TAG, "Failed to initialize renderer");
+    // Flash writes wait until the gauge is on screen
+    save_boot_caches();
+
+    initialized_ = true;
+    ESP_LOGI(TAG, "Application initialized successfully!");
+    return true;
+}
+
+bool Application::load_gauge() {
+#if defined(DIGI_DASH_EMBEDDED_GAUGE)
+    // Bound in place from flash rodata, with nothing to read or parse
+    if (!renderer_->load_gauge(embedded::embedded_gauge::kView)) {
+        ESP_LOGE(TAG, "Failed to load embedded gauge into renderer");
         return false;
     }
+    return true;
+#else
+    // Paths flattened on an earlier boot; the scene ignores them unless
+    // the gauge, display and engine all still match
+    std::vector<uint8_t> tessellation;
+    if (storage_->file_exists(TESSELLATION_CACHE_PATH) &&
+        storage_->read_file(TESSELLATION_CACHE_PATH, tessellation)) {
+        renderer_->set_tessellation_cache(tessellation.data(), tessellation.size());
+    }
+    const bool gauge_loaded = load_stored_gauge();
+    renderer_->set_tessellation_cache(nullptr, 0);
+    return gauge_loaded;
+#endif
+}
 
-    // Load gauge file
-    ESP_LOGI(TAG, "Step 4/4: Loading gauge file from SPIFFS");
-    
-    // Read gauge file from storage
-    std::vector<uint8_t> gauge_data;
-    if (!storage_->read_file(GAUGE_FILE_PATH, gauge_data)) {
-        ESP_LOGE(TAG, "Failed to read gauge file: %s", GAUGE_FILE_PATH);
-        return false;
+void Application::save_boot_caches() {
+#if !defined(DIGI_DASH_EMBEDDED_GAUGE)
+    // Flattened afresh, so the next boot can skip it
+    std::vector<uint8_t> tessellation;
+    if (renderer_->save_tessellation(tessellation) &&
+        storage_->write_file(TESSELLATION_CACHE_PATH, tessellation.data(), tessellation.size())) {
+        ESP_LOGI(TAG, "Tessellation cache saved: %zu bytes", tessellation.size());
     }
-    
-    ESP_LOGI(TAG, "Gauge file loaded: %zu bytes", gauge_data.size());
-    
-    // Load gauge into renderer
-    if (!renderer_->load_gauge(gauge_data.data(), gauge_data.size())) {
-        ESP_LOGE(TAG, "Failed to load gauge into renderer");
-        return false;
+
+    // Rewritten only when the frame changed, to spare the flash
+    std::vector<uint8_t> static_frame;
+    if (renderer_->save_static_frame(static_frame) && static_frame != static_frame_ &&
+        storage_->write_file(STATIC_FRAME_PATH, static_frame.data(), static_frame.size())) {
+        ESP_LOGI(TAG, "Static frame saved: %zu bytes", static_frame.size());
+    }
+    std::vector<uint8_t>().swap(static_frame_);
+#endif
+}
+
+bool Application::load_stored_gauge() {
+    // Read the gauge partition in place through the flash cache; storage_
+    // outlives renderer_, so the mapping does too
+    bool gauge_loaded = false;
+    const uint8_t* gauge_partition = nullptr;
+    size_t gauge_partition_size = 0;
+    if (storage_->map_partition(GAUGE_PARTITION_LABEL, gauge_partition, gauge_partition_size)) {
+        gauge_loaded = renderer_->map_gauge(gauge_partition, gauge_partition_size);
+    }
+
+    // Otherwise stream the file straight into the scene, so it is never in RAM
+    if (!gauge_loaded) {
+        ESP_LOGW(TAG, "No gauge in the %s partition, loading %s", GAUGE_PARTITION_LABEL, GAUGE_FILE_PATH);
+        if (FILE* file = storage_->open_file(GAUGE_FILE_PATH)) {
+            FileByteSource source(file);
+            gauge_loaded = renderer_->load_gauge(source);
+            fclose(file);
+        }
+    }
+
+    // Older gauge formats can only be parsed from a buffer
+    if (!gauge_loaded) {
+        ESP_LOGW(TAG, "Streaming the gauge failed, reading the whole file");
+        std::vector<uint8_t> gauge_data;
+        if (!storage_->read_file(GAUGE_FILE_PATH, gauge_data)) {
+            ESP_LOGE(TAG, "Failed to read gauge file: %s", GAUGE_FILE_PATH);
+            return false;
+        }
+
+        ESP_LOGI(TAG, "Gauge file loaded: %zu bytes", gauge_data.size());
+
+        if (!renderer_->load_gauge(gauge_data.data(), gauge_data.size())) {
+            ESP_LOGE(TAG, "Failed to load gauge into renderer");
+            return false;
+        }
     }
-    
-    ESP_LOGI(TAG, "Gauge loaded successfully!");
-    
-    initialized_ = true;
-    ESP_LOGI(TAG, "Application initialized successfully!");
     return true;
 }
 
@@ -163,19 +278,12 @@ void Application::run() {
         return;
     }
 
-    ESP_LOGI(TAG, "Starting main loop...");
-    
-    // Clear to black before rendering gauge
-    display_->clear(0x000000);
-    
-    ESP_LOGI(TAG, "Rendering gauge...");
-    
     ESP_LOGI(TAG, "Starting animated render loop at %u FPS", static_cast<unsigned>(TARGET_FPS));
 
-    // Animated render loop
+    // Animated render loop, carrying on from the first frame drawn during start-up
     while (true) {
-        renderer_->render_frame();
         vTaskDelay(FRAME_DELAY_MS / portTICK_PERIOD_MS);
+        renderer_->render_frame();
     }
 }
 
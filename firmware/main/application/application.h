@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 #include "platform/display/display_driver.h"
 #include "subsystems/storage/storage_manager.h"
 #include "subsystems/rendering/render_engine.h"
@@ -18,10 +19,15 @@ public:
     
 private:
     void display_hello_world();
+    bool load_gauge();
+    bool load_stored_gauge();
+    void save_boot_caches();
     std::unique_ptr<DisplayDriver> display_;
     std::unique_ptr<StorageManager> storage_;
     std::unique_ptr<RenderEngine> renderer_;
-    
+
+    std::vector<uint8_t> static_frame_;     // Shown at boot, kept to skip rewriting it
+
     bool initialized_;
 };
 
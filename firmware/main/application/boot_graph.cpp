@@ -0,0 +1,34 @@
+#include "boot_graph.h"
+
+#include <utility>
+
+namespace digidash {
+
+// The panel is brought up, and later rendered, on the core running
+// app_main, while storage and the gauge load on the other
+static constexpr BaseType_t DISPLAY_CORE = 0;
+static constexpr BaseType_t LOAD_CORE = 1;
+
+BootStepIds add_boot_steps(InitGraph& graph, BootSteps steps) {
+    BootStepIds ids;
+    ids.display = graph.add_step("display", std::move(steps.display), {}, DISPLAY_CORE);
+    ids.renderer = graph.add_step("renderer", std::move(steps.renderer), {}, LOAD_CORE);
+
+    if (!steps.storage) {
+        ids.gauge = graph.add_step("gauge", std::move(steps.gauge), {ids.renderer}, LOAD_CORE);
+        ids.first_frame = graph.add_step("first_frame", std::move(steps.first_frame), {ids.display, ids.gauge},
+                                         DISPLAY_CORE);
+        return ids;
+    }
+
+    ids.storage = graph.add_step("storage", std::move(steps.storage), {}, LOAD_CORE);
+    ids.static_frame = graph.add_step("static_frame", std::move(steps.static_frame), {ids.storage}, LOAD_CORE);
+    ids.splash = graph.add_step("splash", std::move(steps.splash), {ids.display, ids.renderer, ids.static_frame},
+                                DISPLAY_CORE);
+    ids.gauge = graph.add_step("gauge", std::move(steps.gauge), {ids.storage, ids.renderer}, LOAD_CORE);
+    ids.first_frame = graph.add_step("first_frame", std::move(steps.first_frame),
+                                     {ids.display, ids.splash, ids.gauge}, DISPLAY_CORE);
+    return ids;
+}
+
+} // namespace digidash
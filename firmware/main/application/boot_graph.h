@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include "init_graph.h"
+
+namespace digidash {
+
+/**
+ * @brief What each start-up step does; add_boot_steps() decides the order
+ *
+ * storage, static_frame and splash are left empty for a compiled-in gauge,
+ * which needs nothing mounted and binds too quickly for a splash.
+ */
+struct BootSteps {
+    InitGraph::StepFn display;
+    InitGraph::StepFn renderer;
+    InitGraph::StepFn storage;
+    InitGraph::StepFn static_frame;
+    InitGraph::StepFn splash;
+    InitGraph::StepFn gauge;
+    InitGraph::StepFn first_frame;
+};
+
+/**
+ * @brief Ids of the steps added by add_boot_steps(), kNoStep where left out
+ */
+struct BootStepIds {
+    static constexpr InitGraph::StepId kNoStep = static_cast<InitGraph::StepId>(-1);
+
+    InitGraph::StepId display = kNoStep;
+    InitGraph::StepId renderer = kNoStep;
+    InitGraph::StepId storage = kNoStep;
+    InitGraph::StepId static_frame = kNoStep;
+    InitGraph::StepId splash = kNoStep;
+    InitGraph::StepId gauge = kNoStep;
+    InitGraph::StepId first_frame = kNoStep;
+};
+
+/**
+ * @brief Add Application's start-up steps to @p graph
+ *
+ * Panel bring-up mostly sleeps through its init sequence, so storage and
+ * the gauge load alongside it on the other core. The stored static frame
+ * is shown once display, renderer and frame are all ready, and the first
+ * live frame replaces it once the gauge has loaded.
+ */
+BootStepIds add_boot_steps(InitGraph& graph, BootSteps steps);
+
+} // namespace digidash
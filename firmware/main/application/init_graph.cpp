@@ -0,0 +1,122 @@
+#include "init_graph.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char* TAG = "InitGraph";
+
+namespace digidash {
+
+InitGraph::InitGraph(uint32_t stack_size, UBaseType_t priority)
+    : stack_size_(stack_size)
+    , priority_(priority)
+    , finished_(nullptr) {
+}
+
+InitGraph::~InitGraph() {
+    for (Step& step : steps_) {
+        if (step.done) {
+            vSemaphoreDelete(step.done);
+        }
+    }
+    if (finished_) {
+        vSemaphoreDelete(finished_);
+    }
+}
+
+InitGraph::StepId InitGraph::add_step(const char* name, StepFn fn, std::vector<StepId> dependencies,
+                                      BaseType_t core) {
+    const StepId id = steps_.size();
+    for (StepId dependency : dependencies) {
+        if (dependency >= id) {
+            // Would allow a cycle; run() fails the step instead of hanging
+            ESP_LOGE(TAG, "Step %s depends on a step added after it", name);
+            fn = [] { return false; };
+            dependencies.clear();
+            break;
+        }
+    }
+    steps_.push_back(Step{this, std::move(fn), std::move(dependencies), core, nullptr,
+                          StepResult{name, false, false, 0, 0}});
+    return id;
+}
+
+bool InitGraph::run() {
+    finished_ = xSemaphoreCreateCounting(steps_.size(), 0);
+    if (!finished_) {
+        ESP_LOGE(TAG, "Failed to create completion semaphore");
+        return false;
+    }
+    for (Step& step : steps_) {
+        step.done = xSemaphoreCreateBinary();
+        if (!step.done) {
+            ESP_LOGE(TAG, "Failed to create semaphore for step %s", step.result.name);
+            return false;
+        }
+    }
+
+    // A step that cannot get a task counts as failed, so its dependents
+    // are skipped rather than left waiting
+    for (Step& step : steps_) {
+        if (xTaskCreatePinnedToCore(&InitGraph::step_entry, step.result.name, stack_size_, &step, priority_,
+                                    nullptr, step.core) != pdPASS) {
+            ESP_LOGE(TAG, "Failed to create task for step %s", step.result.name);
+            finish_step(step);
+        }
+    }
+    for (size_t i = 0; i < steps_.size(); ++i) {
+        xSemaphoreTake(finished_, portMAX_DELAY);
+    }
+
+    log_results();
+    bool succeeded = true;
+    for (const Step& step : steps_) {
+        succeeded = succeeded && step.result.succeeded;
+    }
+    return succeeded;
+}
+
+void InitGraph::step_entry(void* arg) {
+    Step* step = static_cast<Step*>(arg);
+    step->graph->run_step(*step);
+    vTaskDelete(nullptr);
+}
+
+void InitGraph::run_step(Step& step) {
+    // done stays given once set, so every dependent can wait on it
+    bool ready = true;
+    for (StepId dependency : step.dependencies) {
+        Step& before = steps_[dependency];
+        xSemaphoreTake(before.done, portMAX_DELAY);
+        xSemaphoreGive(before.done);
+        ready = ready && before.result.succeeded;
+    }
+
+    if (ready) {
+        step.result.ran = true;
+        step.result.start_us = esp_timer_get_time();
+        step.result.succeeded = step.fn();
+        step.result.end_us = esp_timer_get_time();
+    }
+    finish_step(step);
+}
+
+void InitGraph::finish_step(Step& step) {
+    xSemaphoreGive(step.done);
+    xSemaphoreGive(finished_);
+}
+
+void InitGraph::log_results() const {
+    for (const Step& step : steps_) {
+        const StepResult& result = step.result;
+        if (!result.ran) {
+            ESP_LOGW(TAG, "Step %-12s skipped", result.name);
+            continue;
+        }
+        ESP_LOGI(TAG, "Step %-12s at %6llu ms took %7llu us%s", result.name,
+                 (unsigned long long)(result.start_us / 1000),
+                 (unsigned long long)(result.end_us - result.start_us),
+                 result.succeeded ? "" : " (failed)");
+    }
+}
+
+} // namespace digidash
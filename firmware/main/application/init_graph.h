@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+namespace digidash {
+
+/**
+ * @brief Start-up steps with dependencies, each run as soon as it can be
+ *
+ * Every step gets its own FreeRTOS task, pinned to the step's core, which
+ * waits for the steps it depends on and then runs. Steps without a path
+ * between them run concurrently, so slow panel bring-up on one core can
+ * overlap mounting storage and loading a gauge on the other.
+ *
+ * Dependencies must name steps added earlier, so the graph has no cycles.
+ * A step whose function returns false fails, and every step depending on
+ * it, directly or not, is skipped; unrelated steps still run.
+ */
+class InitGraph {
+public:
+    using StepId = size_t;
+    using StepFn = std::function<bool()>;
+
+    static constexpr uint32_t kDefaultStackSize = 8192;
+    static constexpr UBaseType_t kDefaultPriority = 5;
+
+    /**
+     * @brief What happened to one step during run()
+     */
+    struct StepResult {
+        const char* name;
+        bool ran;           // false if skipped for a failed dependency
+        bool succeeded;
+        int64_t start_us;   // esp_timer_get_time() around the step function
+        int64_t end_us;
+    };
+
+    explicit InitGraph(uint32_t stack_size = kDefaultStackSize, UBaseType_t priority = kDefaultPriority);
+    ~InitGraph();
+
+    InitGraph(const InitGraph&) = delete;
+    InitGraph& operator=(const InitGraph&) = delete;
+
+    /**
+     * @brief Add a step run after all of @p dependencies have succeeded
+     *
+     * @param core Core to pin the step's task to, or tskNO_AFFINITY
+     * @return The step's id, for later steps' dependencies
+     */
+    StepId add_step(const char* name, StepFn fn, std::vector<StepId> dependencies = {},
+                    BaseType_t core = tskNO_AFFINITY);
+
+    /**
+     * @brief Run every step and wait for all of them to finish or be skipped
+     *
+     * Logs each step's start time and duration.
+     *
+     * @return true if every step succeeded
+     */
+    bool run();
+
+    const StepResult& result(StepId step) const { return steps_[step].result; }
+    size_t step_count() const { return steps_.size(); }
+
+private:
+    struct Step {
+        InitGraph* graph;
+        StepFn fn;
+        std::vector<StepId> dependencies;
+        BaseType_t core;
+        SemaphoreHandle_t done;     // Given once the step has finished or been skipped
+        StepResult result;
+    };
+
+    static void step_entry(void* arg);
+    void run_step(Step& step);
+    void finish_step(Step& step);
+    void log_results() const;
+
+    uint32_t stack_size_;
+    UBaseType_t priority_;
+    std::vector<Step> steps_;       // Not resized while running: tasks hold pointers into it
+    SemaphoreHandle_t finished_;    // Given once per finished step
+};
+
+} // namespace digidash
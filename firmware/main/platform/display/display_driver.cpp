@@ -121,7 +121,7 @@ bool DisplayDriver::init_rgb_panel() {
         },
         .data_width = 16,  // RGB565 mode
         .bits_per_pixel = 16,
-        .num_fbs = 2,  // Double framebuffer (like working example)
+        .num_fbs = kFrameBufferCount,  // Double framebuffer (like working example)
         .bounce_buffer_size_px = 0,
         .sram_trans_align = 8,
         .psram_trans_align = 64,
@@ -165,7 +165,7 @@ bool DisplayDriver::init_rgb_panel() {
     }
     
     // Get framebuffer pointers from driver
-    ret = esp_lcd_rgb_panel_get_frame_buffer(panel_handle_, 2, &framebuffer0_, &framebuffer1_);
+    ret = esp_lcd_rgb_panel_get_frame_buffer(panel_handle_, kFrameBufferCount, &framebuffer0_, &framebuffer1_);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to get framebuffer pointers: %s", esp_err_to_name(ret));
         return false;
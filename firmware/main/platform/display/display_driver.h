@@ -30,6 +30,10 @@ public:
     void refresh();
     uint16_t* acquire_back_buffer();
     void present_back_buffer(const uint16_t* back_buffer);
+
+    // acquire_back_buffer() rotates through this many framebuffers, so the
+    // buffer it returns still holds the frame presented this many frames ago
+    static constexpr uint32_t kFrameBufferCount = 2;
     
     // Test pattern methods (verify display is working before rendering gauge)
     void test_pattern_solid_red();
@@ -0,0 +1,280 @@
+#include "async_memcpy.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <chrono>
+#include <cstring>
+
+#ifdef ESP_PLATFORM
+#include "esp_cache.h"
+#include "esp_memory_utils.h"
+#endif
+
+static const char* TAG = "AsyncMemcpy";
+
+namespace digidash {
+
+std::unique_ptr<AsyncMemcpy> create_async_memcpy() {
+#ifdef ESP_PLATFORM
+    return std::make_unique<EspAsyncMemcpy>();
+#else
+    return std::make_unique<ThreadAsyncMemcpy>();
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// ThreadAsyncMemcpy
+
+ThreadAsyncMemcpy::ThreadAsyncMemcpy()
+    : next_job_(0)
+    , issued_(0)
+    , completed_(0)
+    , stats_{0, 0, 0}
+    , running_(false)
+    , stopping_(false) {
+}
+
+ThreadAsyncMemcpy::~ThreadAsyncMemcpy() {
+    if (!running_) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_cv_.notify_one();
+    thread_.join();
+}
+
+bool ThreadAsyncMemcpy::initialize() {
+    if (running_) {
+        return true;
+    }
+    thread_ = std::thread(&ThreadAsyncMemcpy::worker_loop, this);
+    running_ = true;
+    return true;
+}
+
+AsyncMemcpy::Ticket ThreadAsyncMemcpy::copy(void* dst, const void* src, size_t size) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!running_) {
+        // Ordering is trivially preserved: nothing can be in flight
+        std::memcpy(dst, src, size);
+        ++stats_.copies;
+        stats_.bytes += size;
+        completed_ = ++issued_;
+        return issued_;
+    }
+
+    queue_.push_back(Job{dst, src, size});
+    const Ticket ticket = ++issued_;
+    lock.unlock();
+    work_cv_.notify_one();
+    return ticket;
+}
+
+void ThreadAsyncMemcpy::wait(Ticket ticket) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [&] { return static_cast<int32_t>(completed_ - ticket) >= 0; });
+}
+
+void ThreadAsyncMemcpy::wait_all() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const Ticket ticket = issued_;
+    done_cv_.wait(lock, [&] { return static_cast<int32_t>(completed_ - ticket) >= 0; });
+}
+
+AsyncMemcpy::Stats ThreadAsyncMemcpy::take_stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Stats stats = stats_;
+    stats_ = Stats{0, 0, 0};
+    return stats;
+}
+
+void ThreadAsyncMemcpy::worker_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        work_cv_.wait(lock, [this] { return stopping_ || next_job_ < queue_.size(); });
+        if (next_job_ >= queue_.size()) {
+            return;
+        }
+
+        const Job job = queue_[next_job_++];
+        if (next_job_ == queue_.size()) {
+            queue_.clear();
+            next_job_ = 0;
+        }
+        lock.unlock();
+
+        const auto start = std::chrono::steady_clock::now();
+        std::memcpy(job.dst, job.src, job.size);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        lock.lock();
+        ++stats_.copies;
+        stats_.bytes += job.size;
+        stats_.busy_us += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        ++completed_;
+        done_cv_.notify_all();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// EspAsyncMemcpy
+
+#ifdef ESP_PLATFORM
+
+EspAsyncMemcpy::EspAsyncMemcpy()
+    : handle_(nullptr)
+    , done_semaphore_(nullptr)
+    , waiting_(false)
+    , issued_(0)
+    , completed_(0)
+    , busy_start_us_(0)
+    , stats_{0, 0, 0} {
+    portMUX_INITIALIZE(&lock_);
+}
+
+EspAsyncMemcpy::~EspAsyncMemcpy() {
+    if (handle_) {
+        wait_all();
+        esp_async_memcpy_uninstall(handle_);
+    }
+    if (done_semaphore_) {
+        vSemaphoreDelete(done_semaphore_);
+    }
+}
+
+bool EspAsyncMemcpy::initialize() {
+    if (handle_) {
+        return true;
+    }
+
+    done_semaphore_ = xSemaphoreCreateBinary();
+    if (!done_semaphore_) {
+        ESP_LOGE(TAG, "Failed to create completion semaphore");
+        return false;
+    }
+
+    async_memcpy_config_t config = ASYNC_MEMCPY_DEFAULT_CONFIG();
+    config.backlog = 16;
+    config.sram_trans_align = 4;
+    config.psram_trans_align = kAlignment;
+    esp_err_t err = esp_async_memcpy_install(&config, &handle_);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "esp_async_memcpy_install failed: %s", esp_err_to_name(err));
+        handle_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+AsyncMemcpy::Ticket EspAsyncMemcpy::copy(void* dst, const void* src, size_t size) {
+    auto dma_reachable = [](const void* ptr) {
+        return esp_ptr_dma_capable(ptr) || esp_ptr_dma_ext_capable(ptr);
+    };
+    const uintptr_t alignment_bits = reinterpret_cast<uintptr_t>(dst) | reinterpret_cast<uintptr_t>(src) | size;
+    const bool dma_ok = handle_ && size > 0 && (alignment_bits & (kAlignment - 1)) == 0 &&
+                        dma_reachable(dst) && dma_reachable(src);
+    if (!dma_ok) {
+        std::memcpy(dst, src, size);
+        portENTER_CRITICAL(&lock_);
+        ++stats_.copies;
+        stats_.bytes += size;
+        const Ticket ticket = issued_;      // Done now; waiting on it still orders earlier copies
+        portEXIT_CRITICAL(&lock_);
+        return ticket;
+    }
+
+    // GDMA bypasses the data cache: push CPU writes of the source out to
+    // PSRAM, and drop destination lines so a later eviction cannot
+    // overwrite what the DMA wrote
+    if (esp_ptr_external_ram(src)) {
+        esp_cache_msync(const_cast<void*>(src), size, ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+    }
+    if (esp_ptr_external_ram(dst)) {
+        esp_cache_msync(dst, size, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_INVALIDATE);
+    }
+
+    portENTER_CRITICAL(&lock_);
+    if (issued_ == completed_) {
+        busy_start_us_ = esp_timer_get_time();
+    }
+    const Ticket ticket = issued_ + 1;
+    issued_ = ticket;
+    portEXIT_CRITICAL(&lock_);
+
+    esp_err_t err = esp_async_memcpy(handle_, dst, const_cast<void*>(src), size, &EspAsyncMemcpy::on_copy_done, this);
+    if (err != ESP_OK) {
+        // Backlog full: the copy was never queued, so take its ticket back
+        portENTER_CRITICAL(&lock_);
+        issued_ = ticket - 1;
+        if (issued_ == completed_) {
+            stats_.busy_us += esp_timer_get_time() - busy_start_us_;
+        }
+        portEXIT_CRITICAL(&lock_);
+
+        std::memcpy(dst, src, size);
+        portENTER_CRITICAL(&lock_);
+        ++stats_.copies;
+        stats_.bytes += size;
+        portEXIT_CRITICAL(&lock_);
+        return ticket - 1;
+    }
+
+    portENTER_CRITICAL(&lock_);
+    ++stats_.copies;
+    stats_.bytes += size;
+    portEXIT_CRITICAL(&lock_);
+    return ticket;
+}
+
+bool EspAsyncMemcpy::on_copy_done(async_memcpy_handle_t, async_memcpy_event_t*, void* arg) {
+    EspAsyncMemcpy* self = static_cast<EspAsyncMemcpy*>(arg);
+    BaseType_t woken = pdFALSE;
+
+    portENTER_CRITICAL_ISR(&self->lock_);
+    self->completed_ = self->completed_ + 1;
+    if (self->completed_ == self->issued_) {
+        self->stats_.busy_us += esp_timer_get_time() - self->busy_start_us_;
+    }
+    const bool waiting = self->waiting_;
+    portEXIT_CRITICAL_ISR(&self->lock_);
+
+    if (waiting) {
+        xSemaphoreGiveFromISR(self->done_semaphore_, &woken);
+    }
+    return woken == pdTRUE;
+}
+
+void EspAsyncMemcpy::wait(Ticket ticket) {
+    for (;;) {
+        portENTER_CRITICAL(&lock_);
+        const bool done = static_cast<int32_t>(completed_ - ticket) >= 0;
+        waiting_ = !done;
+        portEXIT_CRITICAL(&lock_);
+        if (done) {
+            return;
+        }
+        // A stale give from an earlier wait only causes one extra re-check
+        xSemaphoreTake(done_semaphore_, portMAX_DELAY);
+    }
+}
+
+void EspAsyncMemcpy::wait_all() {
+    portENTER_CRITICAL(&lock_);
+    const Ticket ticket = issued_;
+    portEXIT_CRITICAL(&lock_);
+    wait(ticket);
+}
+
+AsyncMemcpy::Stats EspAsyncMemcpy::take_stats() {
+    portENTER_CRITICAL(&lock_);
+    const Stats stats = stats_;
+    stats_ = Stats{0, 0, 0};
+    portEXIT_CRITICAL(&lock_);
+    return stats;
+}
+
+#endif // ESP_PLATFORM
+
+} // namespace digidash
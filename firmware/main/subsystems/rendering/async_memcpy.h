@@ -0,0 +1,142 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef ESP_PLATFORM
+#include "esp_async_memcpy.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#endif
+
+namespace digidash {
+
+/**
+ * @brief Copy engine that runs memcpy in the background
+ *
+ * Copies complete in the order they were queued. Each copy returns a
+ * ticket; wait() blocks until that copy (and every earlier one) has landed.
+ * An instance is meant to be driven by a single task.
+ */
+class AsyncMemcpy {
+public:
+    using Ticket = uint32_t;
+
+    struct Stats {
+        uint32_t copies;
+        uint64_t bytes;
+        uint64_t busy_us;   // Time the engine spent with copies in flight
+    };
+
+    virtual ~AsyncMemcpy() = default;
+
+    virtual bool initialize() = 0;
+
+    /**
+     * @brief Queue a copy of @p size bytes
+     *
+     * Falls back to a synchronous memcpy when the buffers are unsuitable for
+     * the engine or it cannot accept more work. Neither buffer may be touched
+     * until the returned ticket has been waited on.
+     */
+    virtual Ticket copy(void* dst, const void* src, size_t size) = 0;
+
+    /**
+     * @brief Block until the copy identified by @p ticket has completed
+     */
+    virtual void wait(Ticket ticket) = 0;
+
+    /**
+     * @brief Block until every queued copy has completed
+     */
+    virtual void wait_all() = 0;
+
+    /**
+     * @brief Return statistics gathered since the previous call and reset them
+     */
+    virtual Stats take_stats() = 0;
+};
+
+/**
+ * @brief Create the platform's preferred AsyncMemcpy
+ *
+ * esp_async_memcpy (GDMA) on device, a worker thread elsewhere.
+ */
+std::unique_ptr<AsyncMemcpy> create_async_memcpy();
+
+/**
+ * @brief Host stand-in that performs copies on a worker thread
+ */
+class ThreadAsyncMemcpy : public AsyncMemcpy {
+public:
+    ThreadAsyncMemcpy();
+    ~ThreadAsyncMemcpy() override;
+
+    bool initialize() override;
+    Ticket copy(void* dst, const void* src, size_t size) override;
+    void wait(Ticket ticket) override;
+    void wait_all() override;
+    Stats take_stats() override;
+
+private:
+    struct Job {
+        void* dst;
+        const void* src;
+        size_t size;
+    };
+
+    void worker_loop();
+
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    std::vector<Job> queue_;    // Emptied once drained, so its storage is reused
+    size_t next_job_;           // First job of queue_ not yet taken
+    Ticket issued_;
+    Ticket completed_;
+    Stats stats_;
+    bool running_;
+    bool stopping_;
+};
+
+#ifdef ESP_PLATFORM
+/**
+ * @brief GDMA-backed copies through esp_async_memcpy
+ *
+ * Buffers must be DMA capable and aligned to kAlignment bytes, as must the
+ * copy size; anything else is copied synchronously.
+ */
+class EspAsyncMemcpy : public AsyncMemcpy {
+public:
+    static constexpr size_t kAlignment = 32;
+
+    EspAsyncMemcpy();
+    ~EspAsyncMemcpy() override;
+
+    bool initialize() override;
+    Ticket copy(void* dst, const void* src, size_t size) override;
+    void wait(Ticket ticket) override;
+    void wait_all() override;
+    Stats take_stats() override;
+
+private:
+    static bool on_copy_done(async_memcpy_handle_t handle, async_memcpy_event_t* event, void* arg);
+
+    async_memcpy_handle_t handle_;
+    SemaphoreHandle_t done_semaphore_;
+    portMUX_TYPE lock_;
+    volatile bool waiting_;
+    volatile Ticket issued_;
+    volatile Ticket completed_;
+    int64_t busy_start_us_;
+    Stats stats_;
+};
+#endif
+
+} // namespace digidash
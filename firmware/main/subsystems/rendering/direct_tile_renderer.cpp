@@ -0,0 +1,223 @@
+#include "direct_tile_renderer.h"
+#include "platform/display/display_driver.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <cstring>
+#include <cstdlib>
+#include "fps_overlay.h"
+
+// Provide fallbacks for ESP-IDF heap helpers when building tests on host
+#ifndef MALLOC_CAP_8BIT
+#define MALLOC_CAP_8BIT 0
+#endif
+#ifndef MALLOC_CAP_SPIRAM
+#define MALLOC_CAP_SPIRAM 0
+#endif
+#ifndef heap_caps_malloc
+#define heap_caps_malloc(sz, caps) malloc(sz)
+#endif
+
+static const char* TAG = "DirectTileRenderer";
+
+namespace digidash {
+
+DirectTileRenderer::DirectTileRenderer(DisplayDriver& display, uint32_t tile_height, TaskExecutor* executor)
+    : GaugeTileRenderer(display, executor)
+    , tile_height_(tile_height)
+    , num_tiles_(0)
+    , quality_governor_()
+    , damage_(DisplayDriver::kFrameBufferCount) {
+}
+
+bool DirectTileRenderer::initialize() {
+    if (initialized_) {
+        ESP_LOGW(TAG, "Renderer already initialized");
+        return true;
+    }
+
+    uint32_t width = display_.get_width();
+    uint32_t height = display_.get_height();
+
+    num_tiles_ = (height + tile_height_ - 1) / tile_height_;
+
+    // Tiles render straight into the back buffer, so workers only need
+    // their own rasterizer scratch
+    workers_.resize(executor_->worker_count());
+    for (auto& worker : workers_) {
+        worker.context = std::make_unique<GaugeScene::RenderContext>();
+    }
+
+    // Full-frame static RGB565 cache (PSRAM preferred); no RGBA buffers are needed
+    size_t static_rgb565_size = width * height * sizeof(uint16_t);
+    static_rgb565_frame_buffer_ = (uint16_t*)heap_caps_malloc(static_rgb565_size, MALLOC_CAP_8BIT | MALLOC_CAP_SPIRAM);
+    if (!static_rgb565_frame_buffer_) {
+        ESP_LOGW(TAG, "Static RGB565 cache allocation failed (%zu bytes), running without static cache", static_rgb565_size);
+    }
+
+    ESP_LOGI(TAG, "Renderer initialized: %lux%lu display, %lu tiles of height %lu, %zu workers (direct RGB565)",
+             (unsigned long)width, (unsigned long)height,
+             (unsigned long)num_tiles_, (unsigned long)tile_height_, workers_.size());
+
+    initialized_ = true;
+    return true;
+}
+
+void DirectTileRenderer::build_static_cache(uint32_t width, uint32_t height, bool layer_decoded) {
+    static_cache_ready_ = false;
+    if (!gauge_scene_ || !static_rgb565_frame_buffer_) {
+        return;
+    }
+
+    if (!layer_decoded) {
+        std::memset(static_rgb565_frame_buffer_, 0, width * height * sizeof(uint16_t));
+        gauge_scene_->render_static(reinterpret_cast<uint8_t*>(static_rgb565_frame_buffer_),
+                                    width, height, width * sizeof(uint16_t), 0, PixelFormat::RGB565);
+    }
+    static_cache_ready_ = true;
+
+    // The next frames are damaged in full, which copies the static image
+    // into each framebuffer in turn; the display is left alone here, so a
+    // gauge can load while the panel is still coming up
+    damage_.reset(width, height);
+}
+
+void DirectTileRenderer::render_frame() {
+    if (!initialized_ || !gauge_scene_) {
+        return;
+    }
+
+    uint32_t width = display_.get_width();
+    uint32_t height = display_.get_height();
+    uint16_t* back_buffer = display_.acquire_back_buffer();
+    if (!back_buffer) {
+        return;
+    }
+
+    uint64_t t_frame_start = esp_timer_get_time();
+
+    // Quality tier chosen from the measured cost of previous frames
+    const int render_quality = quality_governor_.level();
+    gauge_scene_->set_render_quality(render_quality);
+
+    static uint32_t last_tick = xTaskGetTickCount();
+    uint32_t now_tick = xTaskGetTickCount();
+    uint32_t delta_ms = (now_tick - last_tick) * portTICK_PERIOD_MS;
+    if (delta_ms == 0) {
+        delta_ms = 1;
+    }
+    last_tick = now_tick;
+    gauge_scene_->update(delta_ms);
+
+    // Without the static cache every tile is redrawn from scratch
+    if (static_cache_ready_) {
+        scene_damage_.clear();
+        gauge_scene_->take_damage(scene_damage_);
+        damage_.begin_frame(scene_damage_, back_buffer);
+    }
+    const uint32_t damage_area = static_cache_ready_ ? damage_.area() : width * height;
+
+    for (auto& worker : workers_) {
+        worker.t_static_copy = 0;
+        worker.t_render_paths = 0;
+        worker.dynamic_tiles = 0;
+    }
+
+    // Tiles own disjoint back buffer rows, so they can render concurrently;
+    // the task captures no more than std::function stores inline
+    executor_->parallel_for(num_tiles_, [this, back_buffer](size_t tile, size_t worker) {
+        render_tile(static_cast<uint32_t>(tile), workers_[worker], back_buffer);
+    });
+
+    uint64_t t_static_copy = 0;
+    uint64_t t_render_paths = 0;
+    uint32_t dynamic_tiles = 0;
+    for (const auto& worker : workers_) {
+        t_static_copy += worker.t_static_copy;
+        t_render_paths += worker.t_render_paths;
+        dynamic_tiles += worker.dynamic_tiles;
+    }
+
+    static uint32_t last_present_tick = 0;
+    uint32_t now_present = xTaskGetTickCount();
+    if (last_present_tick == 0) last_present_tick = now_present;
+    uint32_t delta_present_ms = (now_present - last_present_tick) * portTICK_PERIOD_MS;
+    if (delta_present_ms == 0) delta_present_ms = 1;
+    int fps = (int)(1000u / delta_present_ms);
+    last_present_tick = now_present;
+
+    const PixelRect overlay_rect = draw_fps_overlay(back_buffer, width, height, fps);
+    if (static_cache_ready_) {
+        damage_.add_overlay(overlay_rect);
+    }
+
+    display_.present_back_buffer(back_buffer);
+
+    frame_count_++;
+
+    uint64_t t_total = esp_timer_get_time() - t_frame_start;
+    quality_governor_.submit_frame_time(t_total / 1000.0f);
+
+    if (frame_count_ % 60 == 0) {
+        ESP_LOGI(TAG, "Frame %lu: total=%.2fms render_paths=%.2fms static_copy=%.2fms dyn_tiles=%lu/%lu damage=%lupx (%lu%%) q=%d fps=%d",
+                 (unsigned long)frame_count_, t_total / 1000.0, t_render_paths / 1000.0, t_static_copy / 1000.0,
+                 (unsigned long)dynamic_tiles, (unsigned long)num_tiles_,
+                 (unsigned long)damage_area, (unsigned long)((uint64_t)damage_area * 100 / ((uint64_t)width * height)),
+                 render_quality, fps);
+    }
+}
+
+void DirectTileRenderer::render_tile(uint32_t tile, WorkerState& worker, uint16_t* back_buffer) {
+    const uint32_t width = display_.get_width();
+    const uint32_t height = display_.get_height();
+    const size_t row_bytes = width * sizeof(uint16_t);
+
+    uint32_t tile_y = tile * tile_height_;
+    uint32_t tile_h = (tile_y + tile_height_ > height) ? (height - tile_y) : tile_height_;
+    uint16_t* tile_rows = back_buffer + (size_t)tile_y * width;
+    uint8_t* target = reinterpret_cast<uint8_t*>(tile_rows);
+
+    if (!static_cache_ready_) {
+        uint64_t t0 = esp_timer_get_time();
+        std::memset(tile_rows, 0, tile_h * row_bytes);
+        worker.t_static_copy += (esp_timer_get_time() - t0);
+
+        uint64_t t1 = esp_timer_get_time();
+        gauge_scene_->render(*worker.context, target, width, tile_h, row_bytes, tile_y, PixelFormat::RGB565);
+        worker.t_render_paths += (esp_timer_get_time() - t1);
+        return;
+    }
+
+    // The back buffer holds an older frame: restore static content under
+    // each damaged rectangle, then draw the dynamic paths over it
+    worker.damage_rects.clear();
+    damage_.rects_in_band(tile_y, tile_h, worker.damage_rects);
+    bool any_dynamic = false;
+    for (const PixelRect& rect : worker.damage_rects) {
+        uint64_t t0 = esp_timer_get_time();
+        const size_t rect_bytes = (size_t)(rect.x1 - rect.x0) * sizeof(uint16_t);
+        for (int y = rect.y0; y < rect.y1; ++y) {
+            const size_t offset = (size_t)y * width + rect.x0;
+            std::memcpy(&back_buffer[offset], &static_rgb565_frame_buffer_[offset], rect_bytes);
+        }
+        worker.t_static_copy += (esp_timer_get_time() - t0);
+
+        if (!gauge_scene_->has_dynamic_in_rect(rect.x0, rect.y0, rect.x1 - rect.x0, rect.y1 - rect.y0)) {
+            continue;
+        }
+        any_dynamic = true;
+
+        uint64_t t1 = esp_timer_get_time();
+        gauge_scene_->render_dynamic_rect(*worker.context, rect, target, width, tile_h, row_bytes, tile_y,
+                                          PixelFormat::RGB565);
+        worker.t_render_paths += (esp_timer_get_time() - t1);
+    }
+
+    if (any_dynamic) {
+        ++worker.dynamic_tiles;
+    }
+}
+
+} // namespace digidash
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "gauge_tile_renderer.h"
+#include "digidash/damage_tracker.h"
+#include "digidash/gauge_scene.h"
+#include "digidash/render_quality_governor.h"
+#include "digidash/task_executor.h"
+#include <memory>
+#include <cstdint>
+#include <vector>
+
+namespace digidash {
+
+class DisplayDriver;
+
+/**
+ * @brief Tile renderer that rasterizes straight into the RGB565 back buffer
+ *
+ * Paths are blended in 565 space directly on the display's back buffer rows,
+ * so there is no RGBA tile intermediate and no per-frame conversion pass.
+ * Static content is cached once as RGB565, or decoded from a layer baked
+ * into the gauge at the display's size, and restored per tile before the
+ * dynamic paths are drawn over it. Tiles are spread over a TaskExecutor,
+ * each worker rasterizing with its own render context.
+ *
+ * With the static cache in place only damaged rectangles are restored and
+ * redrawn; the rest of the back buffer is left as it is.
+ */
+class DirectTileRenderer : public GaugeTileRenderer {
+public:
+    /**
+     * @param executor Runs tiles in parallel; null renders every tile on the
+     *        calling task. Must outlive the renderer.
+     */
+    DirectTileRenderer(DisplayDriver& display, uint32_t tile_height = 60, TaskExecutor* executor = nullptr);
+
+    bool initialize() override;
+    void render_frame() override;
+
+private:
+    /**
+     * @brief Scratch state owned by a single executor worker
+     */
+    struct WorkerState {
+        std::unique_ptr<GaugeScene::RenderContext> context;
+        std::vector<PixelRect> damage_rects;    // Damage within the current tile
+
+        // Per-frame profiling (microseconds)
+        uint64_t t_static_copy = 0;
+        uint64_t t_render_paths = 0;
+        uint32_t dynamic_tiles = 0;
+    };
+
+    void render_tile(uint32_t tile, WorkerState& worker, uint16_t* back_buffer);
+    void build_static_cache(uint32_t width, uint32_t height, bool layer_decoded) override;
+
+    uint32_t tile_height_;
+    uint32_t num_tiles_;
+
+    RenderQualityGovernor quality_governor_;
+    std::vector<WorkerState> workers_;
+    DamageTracker damage_;
+    std::vector<PixelRect> scene_damage_;
+};
+
+} // namespace digidash
@@ -0,0 +1,113 @@
+#include "fps_overlay.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace digidash {
+
+namespace {
+// Simple helpers to draw basic UI onto an RGB565 framebuffer for diagnostics.
+static inline uint16_t rgb_to_rgb565(uint8_t r, uint8_t g, uint8_t b) {
+    return static_cast<uint16_t>(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+}
+
+static void draw_rect_rgb565(uint16_t* fb, int fb_w, int fb_h, int x, int y, int w, int h, uint16_t color) {
+    if (!fb || w <= 0 || h <= 0) return;
+    int x0 = std::max(0, x);
+    int y0 = std::max(0, y);
+    int x1 = std::min(fb_w, x + w);
+    int y1 = std::min(fb_h, y + h);
+    for (int yy = y0; yy < y1; ++yy) {
+        uint16_t* row = fb + yy * fb_w;
+        for (int xx = x0; xx < x1; ++xx) {
+            row[xx] = color;
+        }
+    }
+}
+
+// Draw a single 7-segment digit using filled rectangles. x,y is top-left.
+static void draw_digit_7seg(uint16_t* fb, int fb_w, int fb_h, int digit, int x, int y, int seg_len, int seg_thick, uint16_t color) {
+    static const uint8_t seg_map[10] = {
+        // gfedcba
+        0b0111111, // 0
+        0b0000110, // 1
+        0b1011011, // 2
+        0b1001111, // 3
+        0b1100110, // 4
+        0b1101101, // 5
+        0b1111101, // 6
+        0b0000111, // 7
+        0b1111111, // 8
+        0b1101111  // 9
+    };
+    if (digit < 0 || digit > 9) return;
+    uint8_t m = seg_map[digit];
+
+    int a_x = x + seg_thick;
+    int a_y = y;
+    int b_x = x + seg_len + seg_thick;
+    int b_y = y + seg_thick;
+    int c_x = b_x;
+    int c_y = y + seg_len + seg_thick;
+    int d_x = a_x;
+    int d_y = y + seg_len * 2 + seg_thick;
+    int e_x = x;
+    int e_y = c_y;
+    int f_x = x;
+    int f_y = b_y;
+    int hor_w = seg_len;
+    int hor_h = seg_thick;
+    int ver_w = seg_thick;
+    int ver_h = seg_len;
+
+    // segment a
+    if (m & 0x01) draw_rect_rgb565(fb, fb_w, fb_h, a_x, a_y, hor_w, hor_h, color);
+    // segment b
+    if (m & 0x02) draw_rect_rgb565(fb, fb_w, fb_h, b_x, b_y, ver_w, ver_h, color);
+    // segment c
+    if (m & 0x04) draw_rect_rgb565(fb, fb_w, fb_h, c_x, c_y, ver_w, ver_h, color);
+    // segment d
+    if (m & 0x08) draw_rect_rgb565(fb, fb_w, fb_h, d_x, d_y, hor_w, hor_h, color);
+    // segment e
+    if (m & 0x10) draw_rect_rgb565(fb, fb_w, fb_h, e_x, e_y, ver_w, ver_h, color);
+    // segment f
+    if (m & 0x20) draw_rect_rgb565(fb, fb_w, fb_h, f_x, f_y, ver_w, ver_h, color);
+    // segment g (center)
+    if (m & 0x40) draw_rect_rgb565(fb, fb_w, fb_h, a_x, y + seg_len, hor_w, hor_h, color);
+}
+
+} // anonymous namespace
+
+PixelRect draw_fps_overlay(uint16_t* fb, int fb_w, int fb_h, int fps) {
+    if (!fb) return PixelRect{0, 0, 0, 0};
+    char buf[8];
+    int len = std::snprintf(buf, sizeof(buf), "%d", fps);
+    if (len <= 0) return PixelRect{0, 0, 0, 0};
+    int seg_len = std::max(8, fb_h / 30); // scale with display
+    int seg_thick = std::max(2, seg_len / 4);
+    int digit_w = seg_len + seg_thick * 2;
+    int spacing = seg_thick * 2;
+    int total_w = len * digit_w + (len - 1) * spacing;
+    int start_x = (fb_w - total_w) / 2;
+    int start_y = (fb_h / 2) - (seg_len); // roughly centered vertically
+
+    // background box
+    int pad = seg_thick * 2;
+    int box_w = total_w + pad * 2;
+    int box_h = seg_len * 2 + seg_thick * 4;
+    draw_rect_rgb565(fb, fb_w, fb_h, start_x - pad, start_y - pad, box_w, box_h, rgb_to_rgb565(0,0,0));
+
+    uint16_t color = rgb_to_rgb565(255, 255, 255);
+    for (int i = 0; i < len; ++i) {
+        char c = buf[i];
+        if (c < '0' || c > '9') continue;
+        int d = c - '0';
+        int x = start_x + i * (digit_w + spacing);
+        draw_digit_7seg(fb, fb_w, fb_h, d, x, start_y, seg_len, seg_thick, color);
+    }
+
+    // Digits lie inside the background box
+    return PixelRect{std::max(0, start_x - pad), std::max(0, start_y - pad),
+                     std::min(fb_w, start_x - pad + box_w), std::min(fb_h, start_y - pad + box_h)};
+}
+
+} // namespace digidash
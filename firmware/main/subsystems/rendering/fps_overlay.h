@@ -0,0 +1,14 @@
+#pragma once
+
+#include "digidash/types.h"
+#include <cstdint>
+
+namespace digidash {
+
+/**
+ * @brief Draw a centered 7-segment FPS counter onto an RGB565 framebuffer
+ * @return The framebuffer area the counter covers (empty if nothing was drawn)
+ */
+PixelRect draw_fps_overlay(uint16_t* fb, int fb_w, int fb_h, int fps);
+
+} // namespace digidash
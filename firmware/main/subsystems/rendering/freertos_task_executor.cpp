@@ -0,0 +1,139 @@
+#include "freertos_task_executor.h"
+#include "esp_log.h"
+#include <cstdio>
+
+static const char* TAG = "FreeRtosTaskExecutor";
+
+namespace digidash {
+
+FreeRtosTaskExecutor::FreeRtosTaskExecutor()
+    : FreeRtosTaskExecutor(Config()) {
+}
+
+FreeRtosTaskExecutor::FreeRtosTaskExecutor(const Config& config)
+    : config_(config)
+    , done_semaphore_(nullptr)
+    , job_(nullptr)
+    , task_count_(0)
+    , next_task_(0)
+    , stopping_(false) {
+}
+
+FreeRtosTaskExecutor::~FreeRtosTaskExecutor() {
+    stop_helpers();
+    if (done_semaphore_) {
+        vSemaphoreDelete(done_semaphore_);
+    }
+}
+
+bool FreeRtosTaskExecutor::initialize() {
+    if (!helpers_.empty()) {
+        ESP_LOGW(TAG, "Executor already initialized");
+        return true;
+    }
+    if (config_.helper_count == 0) {
+        return true;
+    }
+
+    done_semaphore_ = xSemaphoreCreateCounting(config_.helper_count, 0);
+    if (!done_semaphore_) {
+        ESP_LOGE(TAG, "Failed to create completion semaphore");
+        return false;
+    }
+
+    // Helpers keep a pointer to their slot, so the vector must not reallocate
+    helpers_.reserve(config_.helper_count);
+    for (uint32_t i = 0; i < config_.helper_count; ++i) {
+        helpers_.push_back(Helper{this, static_cast<size_t>(i) + 1, nullptr});
+        Helper& helper = helpers_.back();
+
+        char name[16];
+        std::snprintf(name, sizeof(name), "render_w%lu", (unsigned long)helper.worker_index);
+        const BaseType_t core = (config_.first_core + static_cast<BaseType_t>(i)) % portNUM_PROCESSORS;
+        if (xTaskCreatePinnedToCore(&FreeRtosTaskExecutor::helper_entry, name, config_.stack_size,
+                                    &helper, config_.priority, &helper.handle, core) != pdPASS) {
+            ESP_LOGE(TAG, "Failed to create render worker %lu", (unsigned long)helper.worker_index);
+            helpers_.pop_back();
+            stop_helpers();
+            return false;
+        }
+    }
+
+    ESP_LOGI(TAG, "Executor initialized: %zu workers (helpers from core %d)",
+             worker_count(), (int)config_.first_core);
+    return true;
+}
+
+void FreeRtosTaskExecutor::parallel_for(size_t task_count, const TaskFn& fn) {
+    if (task_count == 0) {
+        return;
+    }
+    if (helpers_.empty() || task_count == 1) {
+        for (size_t task = 0; task < task_count; ++task) {
+            fn(task, 0);
+        }
+        return;
+    }
+
+    job_ = &fn;
+    task_count_ = task_count;
+    next_task_.store(0, std::memory_order_release);
+
+    for (Helper& helper : helpers_) {
+        xTaskNotifyGive(helper.handle);
+    }
+
+    run_tasks(0);
+
+    // Each helper reports once its share is done; the job is only released
+    // after all of them have stopped touching it
+    for (size_t i = 0; i < helpers_.size(); ++i) {
+        xSemaphoreTake(done_semaphore_, portMAX_DELAY);
+    }
+    job_ = nullptr;
+}
+
+void FreeRtosTaskExecutor::run_tasks(size_t worker) {
+    for (;;) {
+        const size_t task = next_task_.fetch_add(1, std::memory_order_acq_rel);
+        if (task >= task_count_) {
+            return;
+        }
+        (*job_)(task, worker);
+    }
+}
+
+void FreeRtosTaskExecutor::helper_entry(void* arg) {
+    Helper* helper = static_cast<Helper*>(arg);
+    FreeRtosTaskExecutor* owner = helper->owner;
+
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (owner->stopping_.load(std::memory_order_acquire)) {
+            break;
+        }
+        owner->run_tasks(helper->worker_index);
+        xSemaphoreGive(owner->done_semaphore_);
+    }
+
+    xSemaphoreGive(owner->done_semaphore_);
+    vTaskDelete(nullptr);
+}
+
+void FreeRtosTaskExecutor::stop_helpers() {
+    if (helpers_.empty()) {
+        return;
+    }
+
+    stopping_.store(true, std::memory_order_release);
+    for (Helper& helper : helpers_) {
+        xTaskNotifyGive(helper.handle);
+    }
+    for (size_t i = 0; i < helpers_.size(); ++i) {
+        xSemaphoreTake(done_semaphore_, portMAX_DELAY);
+    }
+    helpers_.clear();
+    stopping_.store(false, std::memory_order_release);
+}
+
+} // namespace digidash
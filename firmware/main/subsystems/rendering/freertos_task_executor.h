@@ -0,0 +1,65 @@
+#pragma once
+
+#include "digidash/task_executor.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace digidash {
+
+/**
+ * @brief TaskExecutor backed by core-pinned FreeRTOS helper tasks
+ *
+ * The calling task is worker 0; helper tasks sleep on a task notification
+ * and pull task indices from a shared atomic counter, so an uneven tile mix
+ * still balances across cores. Until initialize() succeeds every batch runs
+ * inline on the caller.
+ */
+class FreeRtosTaskExecutor : public TaskExecutor {
+public:
+    struct Config {
+        uint32_t helper_count = 1;      // Workers in addition to the caller
+        BaseType_t first_core = 1;      // Core of the first helper; others follow round-robin
+        uint32_t stack_size = 8192;
+        UBaseType_t priority = 5;
+    };
+
+    FreeRtosTaskExecutor();
+    explicit FreeRtosTaskExecutor(const Config& config);
+    ~FreeRtosTaskExecutor() override;
+
+    FreeRtosTaskExecutor(const FreeRtosTaskExecutor&) = delete;
+    FreeRtosTaskExecutor& operator=(const FreeRtosTaskExecutor&) = delete;
+
+    /**
+     * @brief Create the helper tasks
+     */
+    bool initialize();
+
+    size_t worker_count() const override { return helpers_.size() + 1; }
+    void parallel_for(size_t task_count, const TaskFn& fn) override;
+
+private:
+    struct Helper {
+        FreeRtosTaskExecutor* owner;
+        size_t worker_index;
+        TaskHandle_t handle;
+    };
+
+    static void helper_entry(void* arg);
+    void run_tasks(size_t worker);
+    void stop_helpers();
+
+    Config config_;
+    std::vector<Helper> helpers_;
+    SemaphoreHandle_t done_semaphore_;
+    const TaskFn* job_;
+    size_t task_count_;
+    std::atomic<size_t> next_task_;
+    std::atomic<bool> stopping_;
+};
+
+} // namespace digidash
@@ -0,0 +1,234 @@
+#include "gauge_tile_renderer.h"
+#include "digidash/binary_gauge_loader.h"
+#include "digidash/gauge_stream.h"
+#include "digidash/rle565.h"
+#include "platform/display/display_driver.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <cstdlib>
+
+static const char* TAG = "GaugeTileRenderer";
+
+namespace digidash {
+
+GaugeTileRenderer::GaugeTileRenderer(DisplayDriver& display, TaskExecutor* executor)
+    : display_(display)
+    , inline_executor_()
+    , executor_(executor ? executor : &inline_executor_)
+    , gauge_scene_(nullptr)
+    , static_rgb565_frame_buffer_(nullptr)
+    , frame_count_(0)
+    , initialized_(false)
+    , static_cache_ready_(false)
+    , sweep_render_mode_(GaugeScene::SweepRenderMode::Geometry)
+    , point_encoding_(GaugeScene::PointEncoding::Float32)
+    , tessellation_cache_(nullptr)
+    , tessellation_cache_size_(0) {
+}
+
+GaugeTileRenderer::~GaugeTileRenderer() {
+    if (static_rgb565_frame_buffer_) {
+        free(static_rgb565_frame_buffer_);
+    }
+}
+
+bool GaugeTileRenderer::load_gauge(const uint8_t* data, size_t size) {
+    return load_buffer(data, size, GaugeScene::CommandStorage::Copy);
+}
+
+bool GaugeTileRenderer::map_gauge(const uint8_t* data, size_t size) {
+    return load_buffer(data, size, GaugeScene::CommandStorage::Borrow);
+}
+
+bool GaugeTileRenderer::load_gauge(const GaugeView& view) {
+    if (!initialized_) {
+        ESP_LOGE(TAG, "Renderer not initialized");
+        return false;
+    }
+
+    // Compiled into the firmware, so there is nothing to parse; the arrays
+    // live in flash rodata for good and are borrowed
+    if (!BinaryGaugeLoader::validate_view(view)) {
+        ESP_LOGE(TAG, "Embedded gauge is inconsistent");
+        return false;
+    }
+    return load_view(view, GaugeScene::CommandStorage::Borrow);
+}
+
+bool GaugeTileRenderer::load_buffer(const uint8_t* data, size_t size, GaugeScene::CommandStorage storage) {
+    if (!initialized_) {
+        ESP_LOGE(TAG, "Renderer not initialized");
+        return false;
+    }
+
+    // v3 gauges are read in place; older formats are parsed into an asset
+    BinaryGaugeLoader loader;
+    GaugeView view;
+    if (loader.map_view(data, size, view)) {
+        return load_view(view, storage);
+    }
+    if (storage == GaugeScene::CommandStorage::Borrow) {
+        ESP_LOGE(TAG, "Mapped gauge data is not a v3 gauge");
+        return false;
+    }
+    BinaryGaugeLoader::GaugeAsset asset;
+    if (!loader.load_from_buffer(data, size, asset)) {
+        ESP_LOGE(TAG, "Failed to parse gauge data");
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Gauge parsed: %lux%lu with %zu paths",
+             (unsigned long)asset.width, (unsigned long)asset.height, asset.paths.size());
+
+    // A layer baked for this display replaces flattening and rasterizing
+    // the static paths
+    const uint32_t width = display_.get_width();
+    const uint32_t height = display_.get_height();
+    const StaticLayer* baked = BinaryGaugeLoader::find_static_layer(asset, width, height);
+    const bool static_decoded = baked && decode_static_layer(baked->rle565.data(), baked->rle565.size(), width, height);
+
+    create_scene(static_decoded);
+    gauge_scene_->load_gauge(asset);
+    finish_gauge_load(width, height, static_decoded);
+    return true;
+}
+
+bool GaugeTileRenderer::load_view(const GaugeView& view, GaugeScene::CommandStorage storage) {
+    const uint32_t width = display_.get_width();
+    const uint32_t height = display_.get_height();
+    ESP_LOGI(TAG, "Gauge parsed: %lux%lu with %zu paths (mapped)",
+             (unsigned long)view.width, (unsigned long)view.height, view.path_count);
+
+    const auto* record = view.find_static_layer(width, height);
+    const bool static_decoded = record && decode_static_layer(view.static_layer_data + record->data_offset,
+                                                              record->data_size, width, height);
+
+    create_scene(static_decoded);
+    gauge_scene_->load_gauge(view, storage);
+    finish_gauge_load(width, height, static_decoded);
+    return true;
+}
+
+bool GaugeTileRenderer::load_gauge(ByteSource& source) {
+    if (!initialized_) {
+        ESP_LOGE(TAG, "Renderer not initialized");
+        return false;
+    }
+
+    GaugeStreamReader reader(source);
+    if (!reader.open()) {
+        ESP_LOGE(TAG, "Failed to parse gauge stream");
+        return false;
+    }
+    const GaugeView& view = reader.metadata();
+    const uint32_t width = display_.get_width();
+    const uint32_t height = display_.get_height();
+    ESP_LOGI(TAG, "Gauge parsed: %lux%lu with %zu paths (streamed)",
+             (unsigned long)view.width, (unsigned long)view.height, view.path_count);
+
+    // The baked layer follows the commands in the file, so the scene first
+    // assumes it decodes and is flattened for real by finish_gauge_load()
+    const auto* record = view.find_static_layer(width, height);
+    create_scene(record != nullptr);
+    if (!gauge_scene_->load_gauge(reader)) {
+        ESP_LOGE(TAG, "Gauge stream ended inside the path commands");
+        gauge_scene_.reset();
+        static_cache_ready_ = false;
+        return false;
+    }
+
+    std::vector<uint8_t> layer;
+    const bool static_decoded = record && reader.read_static_layer(*record, layer) &&
+                                decode_static_layer(layer.data(), layer.size(), width, height);
+    finish_gauge_load(width, height, static_decoded);
+    return true;
+}
+
+void GaugeTileRenderer::set_tessellation_cache(const uint8_t* data, size_t size) {
+    tessellation_cache_ = data;
+    tessellation_cache_size_ = size;
+}
+
+bool GaugeTileRenderer::save_tessellation(std::vector<uint8_t>& out) {
+    // Nothing new to save when the paths came from the cache
+    return gauge_scene_ && !gauge_scene_->is_tessellation_cached() && gauge_scene_->save_tessellation(out);
+}
+
+bool GaugeTileRenderer::show_static_frame(const uint8_t* data, size_t size) {
+    uint16_t* back_buffer = display_.acquire_back_buffer();
+    if (!initialized_ || !back_buffer) {
+        return false;
+    }
+
+    // Decoded straight into the framebuffers, leaving the static cache to a
+    // gauge that may be loading meanwhile
+    const size_t pixel_count = (size_t)display_.get_width() * display_.get_height();
+    if (!rle565_decode(data, size, back_buffer, pixel_count)) {
+        ESP_LOGW(TAG, "Stored static frame does not fit the display");
+        return false;
+    }
+    display_.present_back_buffer(back_buffer);
+    return rle565_decode(data, size, display_.acquire_back_buffer(), pixel_count);
+}
+
+bool GaugeTileRenderer::save_static_frame(std::vector<uint8_t>& out) {
+    if (!static_cache_ready_ || !static_rgb565_frame_buffer_) {
+        return false;
+    }
+    rle565_encode(static_rgb565_frame_buffer_, (size_t)display_.get_width() * display_.get_height(), out);
+    return true;
+}
+
+void GaugeTileRenderer::create_scene(bool static_layer_baked) {
+    // Set up before loading, so the paths are flattened once, straight at
+    // the display size, or copied from the offered cache
+    gauge_scene_ = std::make_unique<GaugeScene>();
+    gauge_scene_->set_static_layer_baked(static_layer_baked);
+    gauge_scene_->set_point_encoding(point_encoding_);
+    gauge_scene_->set_sweep_render_mode(sweep_render_mode_);
+    gauge_scene_->set_task_executor(executor_);
+    gauge_scene_->set_viewport(display_.get_width(), display_.get_height());
+    gauge_scene_->set_tessellation_cache(tessellation_cache_, tessellation_cache_size_);
+}
+
+void GaugeTileRenderer::finish_gauge_load(uint32_t width, uint32_t height, bool static_decoded) {
+    // Static paths are only flattened after all if the baked layer failed
+    if (gauge_scene_->get_static_layer_baked() != static_decoded) {
+        gauge_scene_->set_static_layer_baked(static_decoded);
+        gauge_scene_->set_viewport(width, height);
+    }
+    ESP_LOGI(TAG, "Gauge flattened to %zu points at %lux%lu%s", gauge_scene_->get_point_count(),
+             (unsigned long)width, (unsigned long)height,
+             gauge_scene_->is_tessellation_cached() ? " (from cache)" : "");
+    gauge_scene_->set_tessellation_cache(nullptr, 0);
+    tessellation_cache_ = nullptr;
+    tessellation_cache_size_ = 0;
+    build_static_cache(width, height, static_decoded);
+
+    ESP_LOGI(TAG, "Gauge loaded successfully");
+}
+
+bool GaugeTileRenderer::decode_static_layer(const uint8_t* layer, size_t layer_size, uint32_t width,
+                                            uint32_t height) {
+    if (!static_rgb565_frame_buffer_) {
+        return false;
+    }
+
+    const uint64_t t_start = esp_timer_get_time();
+    if (!rle565_decode(layer, layer_size, static_rgb565_frame_buffer_, (size_t)width * height)) {
+        ESP_LOGW(TAG, "Baked static layer for %lux%lu is corrupt, rendering static paths instead",
+                 (unsigned long)width, (unsigned long)height);
+        return false;
+    }
+    ESP_LOGI(TAG, "Static layer decoded from %zu bytes in %llu us", layer_size,
+             (unsigned long long)(esp_timer_get_time() - t_start));
+    return true;
+}
+
+void GaugeTileRenderer::set_pid_value(uint32_t pid_id, float value) {
+    if (gauge_scene_) {
+        gauge_scene_->set_pid_value(pid_id, value);
+    }
+}
+
+} // namespace digidash
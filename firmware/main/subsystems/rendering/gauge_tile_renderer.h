@@ -0,0 +1,84 @@
+#pragma once
+
+#include "tile_renderer.h"
+#include "digidash/gauge_scene.h"
+#include "digidash/task_executor.h"
+#include <memory>
+#include <cstdint>
+#include <vector>
+
+namespace digidash {
+
+class DisplayDriver;
+
+/**
+ * @brief Gauge loading shared by the tile renderers
+ *
+ * Parses, maps, streams or borrows the gauge, decodes a static layer baked
+ * for the display into the RGB565 static cache, and sets up the GaugeScene
+ * at the display size. A renderer only builds the rest of its static cache
+ * and draws its tiles.
+ */
+class GaugeTileRenderer : public TileRenderer {
+public:
+    ~GaugeTileRenderer() override;
+
+    /**
+     * @brief How trim-sweep paths are drawn; takes effect at load_gauge()
+     */
+    void set_sweep_render_mode(GaugeScene::SweepRenderMode mode) { sweep_render_mode_ = mode; }
+
+    /**
+     * @brief Storage of display-space path points; takes effect at load_gauge()
+     */
+    void set_point_encoding(GaugeScene::PointEncoding encoding) { point_encoding_ = encoding; }
+
+    bool load_gauge(const uint8_t* data, size_t size) override;
+    bool map_gauge(const uint8_t* data, size_t size) override;
+    bool load_gauge(ByteSource& source) override;
+    bool load_gauge(const GaugeView& view) override;
+    void set_tessellation_cache(const uint8_t* data, size_t size) override;
+    bool save_tessellation(std::vector<uint8_t>& out) override;
+    bool show_static_frame(const uint8_t* data, size_t size) override;
+    bool save_static_frame(std::vector<uint8_t>& out) override;
+    void set_pid_value(uint32_t pid_id, float value) override;
+    uint32_t get_frame_count() const override { return frame_count_; }
+
+protected:
+    /**
+     * @param executor Runs tiles in parallel; null runs everything on the
+     *        calling task. Must outlive the renderer.
+     */
+    GaugeTileRenderer(DisplayDriver& display, TaskExecutor* executor);
+
+    /**
+     * @brief Fill the static cache of the scene just loaded
+     *
+     * @param layer_decoded A baked layer is already in static_rgb565_frame_buffer_
+     */
+    virtual void build_static_cache(uint32_t width, uint32_t height, bool layer_decoded) = 0;
+
+    DisplayDriver& display_;
+    InlineTaskExecutor inline_executor_;
+    TaskExecutor* executor_;
+    std::unique_ptr<GaugeScene> gauge_scene_;
+    uint16_t* static_rgb565_frame_buffer_;  // Allocated by initialize(), freed here
+
+    uint32_t frame_count_;
+    bool initialized_;
+    bool static_cache_ready_;
+
+private:
+    bool load_buffer(const uint8_t* data, size_t size, GaugeScene::CommandStorage storage);
+    bool load_view(const GaugeView& view, GaugeScene::CommandStorage storage);
+    void create_scene(bool static_layer_baked);
+    void finish_gauge_load(uint32_t width, uint32_t height, bool static_decoded);
+    bool decode_static_layer(const uint8_t* layer, size_t layer_size, uint32_t width, uint32_t height);
+
+    GaugeScene::SweepRenderMode sweep_render_mode_;
+    GaugeScene::PointEncoding point_encoding_;
+    const uint8_t* tessellation_cache_;     // Offered to the next load only
+    size_t tessellation_cache_size_;
+};
+
+} // namespace digidash
@@ -1,11 +1,41 @@
 #include "render_engine.h"
 #include "tile_height_renderer.h"
+#include "direct_tile_renderer.h"
+#include "freertos_task_executor.h"
+#include "esp_log.h"
+
+static const char* TAG = "RenderEngine";
+
+// Rotating staging tiles per worker when compositing through an RGBA tile
+static constexpr uint32_t TILE_PIPELINE_DEPTH = 2;
 
 namespace digidash {
 
-RenderEngine::RenderEngine(DisplayDriver& display, uint32_t tile_height)
-    : display_(display)
-    , renderer_(std::make_unique<TileHeightRenderer>(display, tile_height)) {
+RenderEngine::RenderEngine(DisplayDriver& display, uint32_t tile_height, RenderStrategy strategy)
+    : display_(display) {
+    // The render loop runs on core 0; a helper pinned to core 1 shares the
+    // tiles. Without it the renderer falls back to a single worker.
+    auto executor = std::make_unique<FreeRtosTaskExecutor>();
+    if (executor->initialize()) {
+        executor_ = std::move(executor);
+    } else {
+        ESP_LOGW(TAG, "Render worker unavailable, rendering on a single core");
+    }
+
+    // Sweeps are drawn from baked arc-parameter maps instead of re-rasterized,
+    // and display points are kept as 12.4 fixed point to halve their PSRAM
+    if (strategy == RenderStrategy::DirectRgb565) {
+        auto renderer = std::make_unique<DirectTileRenderer>(display, tile_height, executor_.get());
+        renderer->set_sweep_render_mode(GaugeScene::SweepRenderMode::ParameterMap);
+        renderer->set_point_encoding(GaugeScene::PointEncoding::Fixed12_4);
+        renderer_ = std::move(renderer);
+    } else {
+        auto renderer = std::make_unique<TileHeightRenderer>(display, tile_height, executor_.get());
+        renderer->set_pipeline_depth(TILE_PIPELINE_DEPTH);
+        renderer->set_sweep_render_mode(GaugeScene::SweepRenderMode::ParameterMap);
+        renderer->set_point_encoding(GaugeScene::PointEncoding::Fixed12_4);
+        renderer_ = std::move(renderer);
+    }
 }
 
 RenderEngine::~RenderEngine() = default;
@@ -18,6 +48,34 @@ bool RenderEngine::load_gauge(const uint8_t* data, size_t size) {
     return renderer_->load_gauge(data, size);
 }
 
+bool RenderEngine::map_gauge(const uint8_t* data, size_t size) {
+    return renderer_->map_gauge(data, size);
+}
+
+bool RenderEngine::load_gauge(ByteSource& source) {
+    return renderer_->load_gauge(source);
+}
+
+bool RenderEngine::load_gauge(const GaugeView& view) {
+    return renderer_->load_gauge(view);
+}
+
+void RenderEngine::set_tessellation_cache(const uint8_t* data, size_t size) {
+    renderer_->set_tessellation_cache(data, size);
+}
+
+bool RenderEngine::save_tessellation(std::vector<uint8_t>& out) {
+    return renderer_->save_tessellation(out);
+}
+
+bool RenderEngine::show_static_frame(const uint8_t* data, size_t size) {
+    return renderer_->show_static_frame(data, size);
+}
+
+bool RenderEngine::save_static_frame(std::vector<uint8_t>& out) {
+    return renderer_->save_static_frame(out);
+}
+
 void RenderEngine::render_frame() {
     renderer_->render_frame();
 }
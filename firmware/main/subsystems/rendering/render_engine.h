@@ -2,12 +2,22 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 #include "tile_renderer.h"
+#include "digidash/task_executor.h"
 
 namespace digidash {
 
 class DisplayDriver;
 
+/**
+ * @brief Available tile rendering strategies
+ */
+enum class RenderStrategy : uint8_t {
+    TileHeight = 0,     // RGBA tile intermediate, composited into the back buffer
+    DirectRgb565 = 1    // Rasterize straight into the RGB565 back buffer
+};
+
 /**
  * @brief Main rendering engine adapter
  * 
@@ -17,11 +27,19 @@ class DisplayDriver;
  */
 class RenderEngine {
 public:
-    RenderEngine(DisplayDriver& display, uint32_t tile_height = 60);
+    RenderEngine(DisplayDriver& display, uint32_t tile_height = 60,
+                 RenderStrategy strategy = RenderStrategy::TileHeight);
     ~RenderEngine();
 
     bool initialize();
     bool load_gauge(const uint8_t* data, size_t size);
+    bool map_gauge(const uint8_t* data, size_t size);
+    bool load_gauge(ByteSource& source);
+    bool load_gauge(const GaugeView& view);
+    void set_tessellation_cache(const uint8_t* data, size_t size);
+    bool save_tessellation(std::vector<uint8_t>& out);
+    bool show_static_frame(const uint8_t* data, size_t size);
+    bool save_static_frame(std::vector<uint8_t>& out);
     void render_frame();
     void set_pid_value(uint32_t pid_id, float value);
     
@@ -29,6 +47,7 @@ public:
     
 private:
     DisplayDriver& display_;
+    std::unique_ptr<TaskExecutor> executor_;     // Declared before renderer_: must outlive it
     std::unique_ptr<TileRenderer> renderer_;
 };
 
@@ -1,7 +1,11 @@
 #pragma once
 
-#include "tile_renderer.h"
+#include "gauge_tile_renderer.h"
+#include "async_memcpy.h"
+#include "digidash/damage_tracker.h"
 #include "digidash/gauge_scene.h"
+#include "digidash/render_quality_governor.h"
+#include "digidash/task_executor.h"
 #include <memory>
 #include <functional>
 #include <cstdint>
@@ -17,39 +21,97 @@ class DisplayDriver;
  * Renders the gauge in horizontal tiles of fixed height.
  * Memory efficient for large displays.
  * Implements the TileRenderer interface (Dependency Inversion Principle).
+ *
+ * Tiles cover disjoint back-buffer rows, so they are handed to a
+ * TaskExecutor and rendered concurrently; each executor worker owns its own
+ * tile buffers and render context.
+ *
+ * With a pipeline depth of two or more, a worker composes each tile into one
+ * of several rotating RGB565 staging buffers and hands the copy into the
+ * back buffer to an AsyncMemcpy, so the copy of tile N overlaps rasterizing
+ * tile N+1.
+ *
+ * Once the static cache is in place, only damaged rectangles are redrawn:
+ * tiles without damage keep the back buffer's pixels, and partially damaged
+ * tiles restore, render and composite just the damaged columns in place.
+ * A static layer baked into the gauge at the display's size is decoded
+ * straight into that cache; the static paths are then never flattened or
+ * rasterized.
  */
-class TileHeightRenderer : public TileRenderer {
+class TileHeightRenderer : public GaugeTileRenderer {
 public:
-    TileHeightRenderer(DisplayDriver& display, uint32_t tile_height = 60);
+    /**
+     * @param executor Runs tiles in parallel; null renders every tile on the
+     *        calling task. Must outlive the renderer.
+     */
+    TileHeightRenderer(DisplayDriver& display, uint32_t tile_height = 60, TaskExecutor* executor = nullptr);
     ~TileHeightRenderer() override;
 
+    /**
+     * @brief Number of rotating staging buffers per worker; below 2 disables pipelining
+     *
+     * Takes effect at initialize().
+     */
+    void set_pipeline_depth(uint32_t depth) { pipeline_depth_ = depth; }
+
     bool initialize() override;
-    bool load_gauge(const uint8_t* data, size_t size) override;
     void render_frame() override;
-    void set_pid_value(uint32_t pid_id, float value) override;
-    uint32_t get_frame_count() const override { return frame_count_; }
 
-    // Test hook: provide a function to render into the RGBA tile buffer for tests
+    // Test hook: provide a function to render into the RGBA tile buffer for tests.
+    // Called from executor workers, so it must be safe to run concurrently.
     void set_test_render_callback(std::function<void(uint8_t* target, int width, int height, int stride, int y_offset)> cb) { test_render_cb_ = std::move(cb); }
 
 private:
+    /**
+     * @brief RGB565 tile whose copy into the back buffer may still be in flight
+     */
+    struct StagingSlot {
+        uint16_t* buffer = nullptr;
+        AsyncMemcpy::Ticket ticket = 0;
+        bool pending = false;
+    };
+
+    /**
+     * @brief Scratch state owned by a single executor worker
+     */
+    struct WorkerState {
+        uint8_t* rgba_tile_buffer = nullptr;
+        uint16_t* rgb565_tile_buffer = nullptr;     // Sequential mode only
+        std::unique_ptr<GaugeScene::RenderContext> context;
+        std::vector<PixelRect> damage_rects;        // Damage within the current tile
+
+        // Pipelined mode
+        std::vector<StagingSlot> staging;
+        size_t next_staging = 0;
+        std::unique_ptr<AsyncMemcpy> copier;
+
+        // Per-frame profiling (microseconds)
+        uint64_t t_static_copy = 0;
+        uint64_t t_render_paths = 0;
+        uint64_t t_convert = 0;
+        uint64_t t_tile_copy = 0;
+        uint64_t t_copy_wait = 0;   // Stalled on the copy engine
+        uint32_t dynamic_tiles = 0;
+    };
+
+    bool allocate_worker(WorkerState& worker, size_t worker_index, uint32_t width);
+    void release_workers();
+    void render_tile(uint32_t tile, WorkerState& worker, uint16_t* back_buffer);
+    void render_damage_rects(uint32_t tile_y, uint32_t tile_h, WorkerState& worker, uint16_t* back_buffer);
     void convert_rgba_to_rgb565(const uint8_t* rgba_buffer, uint16_t* rgb565_buffer, size_t pixel_count);
-    void build_static_cache(uint32_t width, uint32_t height);
+    void build_static_cache(uint32_t width, uint32_t height, bool layer_decoded) override;
 
-    DisplayDriver& display_;
     uint32_t tile_height_;
     uint32_t num_tiles_;
+    uint32_t pipeline_depth_;
 
-    std::unique_ptr<GaugeScene> gauge_scene_;
-    uint8_t* rgba_tile_buffer_;
-    uint8_t* static_rgba_frame_buffer_;
-    uint16_t* static_rgb565_frame_buffer_;
-    uint16_t* rgb565_tile_buffer_;
+    RenderQualityGovernor quality_governor_;
+    std::vector<WorkerState> workers_;
+    std::vector<uint8_t> tile_has_dynamic_;     // Per tile, refreshed every frame
+    DamageTracker damage_;
+    std::vector<PixelRect> scene_damage_;
+    bool damage_tracking_;      // This frame redraws damaged rectangles only
     std::function<void(uint8_t* target, int width, int height, int stride, int y_offset)> test_render_cb_;
-
-    uint32_t frame_count_;
-    bool initialized_;
-    bool static_cache_ready_;
 };
 
 } // namespace digidash
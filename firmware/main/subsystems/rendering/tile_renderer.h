@@ -2,9 +2,13 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace digidash {
 
+class ByteSource;
+struct GaugeView;
+
 /**
  * @brief Abstract tile rendering strategy (Strategy Pattern)
  * 
@@ -26,6 +30,64 @@ public:
      */
     virtual bool load_gauge(const uint8_t* data, size_t size) = 0;
 
+    /**
+     * @brief Load a v3 gauge whose bytes stay mapped while the renderer lives
+     *
+     * For a flash-mapped gauge partition: path commands and the baked static
+     * layer are read in place instead of being copied to RAM.
+     */
+    virtual bool map_gauge(const uint8_t* data, size_t size) = 0;
+
+    /**
+     * @brief Load a gauge read front to back from @p source, without buffering the file
+     *
+     * Only sectioned (v3) gauges can be streamed; use the buffer overload
+     * for older files.
+     */
+    virtual bool load_gauge(ByteSource& source) = 0;
+
+    /**
+     * @brief Load a gauge compiled into the firmware
+     *
+     * For the constexpr view svg_preprocessor --embed writes: it is only
+     * checked, never parsed, and its arrays are borrowed from flash rodata.
+     */
+    virtual bool load_gauge(const GaugeView& view) = 0;
+
+    /**
+     * @brief Offer flattened paths saved by save_tessellation() to the next load
+     *
+     * Used if they match the gauge, display and settings, see
+     * GaugeScene::set_tessellation_cache(). @p data must stay valid until a
+     * load succeeds or the offer is withdrawn with null.
+     */
+    virtual void set_tessellation_cache(const uint8_t* data, size_t size) = 0;
+
+    /**
+     * @brief Flattened paths of the loaded gauge, for storing as the cache
+     *
+     * @return false if no gauge is loaded or its paths came from the cache
+     */
+    virtual bool save_tessellation(std::vector<uint8_t>& out) = 0;
+
+    /**
+     * @brief Show a frame saved by save_static_frame() on both framebuffers
+     *
+     * A boot splash: it stays up until the first frame is rendered, and
+     * does not touch the renderer's state, so a gauge may load meanwhile.
+     *
+     * @return false if the display is not up, or if @p data does not
+     *         decode to exactly one display frame
+     */
+    virtual bool show_static_frame(const uint8_t* data, size_t size) = 0;
+
+    /**
+     * @brief Composed static layer of the loaded gauge, RLE565 encoded
+     *
+     * @return false if no static layer is composed
+     */
+    virtual bool save_static_frame(std::vector<uint8_t>& out) = 0;
+
     /**
      * @brief Render a single frame
      */
@@ -4,6 +4,7 @@
 #include "esp_spiffs.h"
 #include <cstdio>
 #include <dirent.h>
+#include <string>
 
 static const char* TAG = "StorageManager";
 
@@ -16,6 +17,9 @@ StorageManager::StorageManager()
 }
 
 StorageManager::~StorageManager() {
+    for (esp_partition_mmap_handle_t handle : mappings_) {
+        esp_partition_munmap(handle);
+    }
     if (initialized_) {
         esp_vfs_spiffs_unregister("spiffs");
     }
@@ -105,6 +109,76 @@ bool StorageManager::read_file(const char* path, std::vector<uint8_t>& data) {
     return true;
 }
 
+FILE* StorageManager::open_file(const char* path) {
+    if (!initialized_) {
+        ESP_LOGE(TAG, "Storage not initialized");
+        return nullptr;
+    }
+
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        ESP_LOGE(TAG, "Failed to open file: %s", path);
+    }
+    return file;
+}
+
+bool StorageManager::write_file(const char* path, const uint8_t* data, size_t size) {
+    if (!initialized_) {
+        ESP_LOGE(TAG, "Storage not initialized");
+        return false;
+    }
+
+    // Written aside first, so a reset mid-write never leaves a torn file
+    const std::string temp_path = std::string(path) + ".tmp";
+    FILE* file = fopen(temp_path.c_str(), "wb");
+    if (!file) {
+        ESP_LOGE(TAG, "Failed to create file: %s", temp_path.c_str());
+        return false;
+    }
+    const size_t bytes_written = fwrite(data, 1, size, file);
+    const bool closed = fclose(file) == 0;
+    if (bytes_written != size || !closed) {
+        ESP_LOGE(TAG, "Failed to write file: %s (expected %zu, wrote %zu)", path, size, bytes_written);
+        remove(temp_path.c_str());
+        return false;
+    }
+
+    // SPIFFS does not rename over an existing file
+    remove(path);
+    if (rename(temp_path.c_str(), path) != 0) {
+        ESP_LOGE(TAG, "Failed to replace file: %s", path);
+        remove(temp_path.c_str());
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Wrote file: %s (%zu bytes)", path, size);
+    return true;
+}
+
+bool StorageManager::map_partition(const char* label, const uint8_t*& data, size_t& size) {
+    const esp_partition_t* partition =
+        esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (!partition) {
+        ESP_LOGW(TAG, "No partition labelled %s", label);
+        return false;
+    }
+
+    const void* mapped = nullptr;
+    esp_partition_mmap_handle_t handle;
+    esp_err_t ret = esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA, &mapped, &handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to map partition %s (%s)", label, esp_err_to_name(ret));
+        return false;
+    }
+    mappings_.push_back(handle);
+
+    data = static_cast<const uint8_t*>(mapped);
+    size = partition->size;
+    ESP_LOGI(TAG, "Mapped partition %s: %lu bytes at 0x%lx", label,
+             (unsigned long)partition->size, (unsigned long)partition->address);
+    return true;
+}
+
 bool StorageManager::file_exists(const char* path) {
     FILE* file = fopen(path, "rb");
     if (file) {
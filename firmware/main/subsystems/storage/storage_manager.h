@@ -1,6 +1,8 @@
 #pragma once
 
+#include "esp_partition.h"
 #include <cstdint>
+#include <cstdio>
 #include <vector>
 
 namespace digidash {
@@ -12,6 +14,12 @@ public:
 
     bool initialize();
     bool read_file(const char* path, std::vector<uint8_t>& data);
+    FILE* open_file(const char* path);      // For streaming; caller closes
+    bool write_file(const char* path, const uint8_t* data, size_t size);
+
+    // Maps a raw data partition read-only through the flash cache; the
+    // bytes stay valid until the manager is destroyed
+    bool map_partition(const char* label, const uint8_t*& data, size_t& size);
     bool file_exists(const char* path);
     
     size_t get_total_bytes() const { return total_bytes_; }
@@ -21,6 +29,7 @@ private:
     bool initialized_;
     size_t total_bytes_;
     size_t used_bytes_;
+    std::vector<esp_partition_mmap_handle_t> mappings_;
 };
 
 } // namespace digidash
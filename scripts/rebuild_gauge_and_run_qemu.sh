@@ -28,7 +28,7 @@ echo ""
 # Step 3: Regenerate spiffs.bin
 echo "🔨 Rebuilding SPIFFS partition..."
 python3 $HOME/esp/esp-idf/components/spiffs/spiffsgen.py \
-  0x120000 firmware/spiffs_image \
+  0xe0000 firmware/spiffs_image \
   firmware/build/spiffs.bin > /dev/null 2>&1
 echo "   ✅ SPIFFS rebuilt"
 echo ""
@@ -36,6 +36,8 @@ echo ""
 # Step 4: Merge partitions into qemu_flash.bin
 echo "⚙️  Rebuilding qemu_flash.bin..."
 python3 << 'EOF'
+import os
+
 # Create a 2MB qemu_flash.bin
 qemu_flash = bytearray(0x200000)  # 2MB
 
@@ -59,6 +61,12 @@ with open('firmware/build/spiffs.bin', 'rb') as f:
     data = f.read()
     qemu_flash[0xe0000:0xe0000+len(data)] = data
 
+# Read the raw gauge partition
+if os.path.exists('firmware/spiffs_image/dashboard_tiny.gauge'):
+    with open('firmware/spiffs_image/dashboard_tiny.gauge', 'rb') as f:
+        data = f.read()
+        qemu_flash[0x1c0000:0x1c0000+len(data)] = data
+
 # Write qemu_flash.bin
 with open('firmware/build/qemu_flash.bin', 'wb') as f:
     f.write(qemu_flash)
@@ -5,7 +5,7 @@ set -e
 
 PROJECT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
 FIRMWARE_DIR="${PROJECT_DIR}/firmware"
-SPIFFS_SIZE=0x120000
+SPIFFS_SIZE=0xe0000
 QEMU_BIN="${QEMU_BIN:-qemu-system-xtensa}"
 
 if [ -z "$IDF_PATH" ]; then
@@ -39,7 +39,8 @@ python3 "$IDF_PATH/components/spiffs/spiffsgen.py" \
   build/spiffs.bin > /dev/null 2>&1
 
 python3 << 'EOF'
-# Build 2MB qemu_flash.bin from bootloader, partition table, app, and spiffs
+# Build 2MB qemu_flash.bin from bootloader, partition table, app, spiffs and gauge
+import os
 qemu_flash = bytearray(0x200000)  # 2MB
 
 with open('build/bootloader/bootloader.bin', 'rb') as f:
@@ -58,6 +59,12 @@ with open('build/spiffs.bin', 'rb') as f:
     data = f.read()
     qemu_flash[0xe0000:0xe0000+len(data)] = data
 
+# Raw gauge partition, mapped in place by the firmware
+if os.path.exists('spiffs_image/dashboard_tiny.gauge'):
+    with open('spiffs_image/dashboard_tiny.gauge', 'rb') as f:
+        data = f.read()
+        qemu_flash[0x1c0000:0x1c0000+len(data)] = data
+
 with open('build/qemu_flash.bin', 'wb') as f:
     f.write(qemu_flash)
 EOF
@@ -3,12 +3,15 @@
 #include "fake_pid_provider.h"
 #include "digidash/gauge_scene.h"
 #include "digidash/binary_gauge_loader.h"
+#include "digidash/task_executor.h"
 #include "digidash/platform_input.h"
 
+#include <algorithm>
 #include <iostream>
 #include <chrono>
 #include <cstring>
 #include <thread>
+#include <vector>
 #include <SDL2/SDL.h>
 
 using namespace digidash;
@@ -31,25 +34,37 @@ int main(int argc, char* argv[]) {
     // Initialize input
     auto input = std::make_unique<SDLInput>();
 
-    // Load gauge asset
+    // Map v3 gauges and read their paths in place, as the firmware does
+    // from its gauge partition; older formats are parsed into an asset
     BinaryGaugeLoader loader;
+    MappedFile gauge_mapping;
+    GaugeView view;
     BinaryGaugeLoader::GaugeAsset asset;
-    
-    if (!loader.load_from_file(gauge_file, asset)) {
+    const bool mapped = loader.map_file(gauge_file, gauge_mapping, view);
+
+    if (!mapped && !loader.load_from_file(gauge_file, asset)) {
         std::cerr << "Failed to load gauge file: " << gauge_file << "\n";
         std::cerr << "Make sure you've run: python3 tools/svg_preprocessor/svg_parser.py assets/dashboard_tiny.svg\n";
         return 1;
     }
     
-    std::cout << "Loaded gauge: " << asset.width << "x" << asset.height << "\n";
+    std::cout << "Loaded gauge: " << (mapped ? view.width : asset.width) << "x"
+              << (mapped ? view.height : asset.height) << (mapped ? " (mapped)" : "") << "\n";
 
-    // Initialize gauge scene
+    // Initialize gauge scene; declared after the mapping it may borrow from
     auto gauge = std::make_unique<GaugeScene>();
-    if (!gauge->load_gauge(asset)) {
+    const bool scene_loaded = mapped ? gauge->load_gauge(view, GaugeScene::CommandStorage::Borrow)
+                                     : gauge->load_gauge(asset);
+    if (!scene_loaded) {
         std::cerr << "Failed to load gauge into scene\n";
         return 1;
     }
 
+    // Render horizontal bands in parallel, one scratch context per worker
+    ThreadPoolTaskExecutor executor;
+    std::vector<GaugeScene::RenderContext> render_contexts(executor.worker_count());
+    const int band_height = 60;
+
     // Initialize fake PID provider
     FakePIDProvider pid_provider;
 
@@ -103,8 +118,16 @@ int main(int argc, char* argv[]) {
             // Render
             display->clear(0xFF000000); // Black background
             uint8_t* fb = display->lock_framebuffer();
-            gauge->render(fb, display->get_width(), display->get_height(),
-                         display->get_stride());
+            const int width = display->get_width();
+            const int height = display->get_height();
+            const int stride = display->get_stride();
+            const size_t band_count = (height + band_height - 1) / band_height;
+            executor.parallel_for(band_count, [&](size_t band, size_t worker) {
+                const int y = static_cast<int>(band) * band_height;
+                const int h = std::min(band_height, height - y);
+                gauge->render(render_contexts[worker], fb + static_cast<size_t>(y) * stride,
+                              width, h, stride, y);
+            });
             display->unlock_and_update();
         }
 
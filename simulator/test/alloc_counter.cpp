@@ -0,0 +1,42 @@
+#include "alloc_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<size_t> g_allocations{0};
+
+void* counted_alloc(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+namespace digidash {
+namespace test {
+
+size_t allocation_count() {
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+} // namespace test
+} // namespace digidash
+
+// Array and nothrow forms forward to these by default
+void* operator new(std::size_t size) {
+    return counted_alloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
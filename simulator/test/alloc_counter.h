@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+
+namespace digidash {
+namespace test {
+
+/**
+ * @brief Number of heap allocations made through operator new so far
+ *
+ * alloc_counter.cpp replaces the global allocation functions of the test
+ * binary. Take the difference around a block of code to count the
+ * allocations it makes, e.g. to check a steady-state frame loop never
+ * touches the heap.
+ */
+size_t allocation_count();
+
+} // namespace test
+} // namespace digidash
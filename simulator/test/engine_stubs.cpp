@@ -1,9 +0,0 @@
-#include "digidash/vector_renderer.h"
-#include "digidash/animation_engine.h"
-
-namespace digidash {
-
-VectorRenderer::~VectorRenderer() {}
-AnimationEngine::~AnimationEngine() {}
-
-} // namespace digidash
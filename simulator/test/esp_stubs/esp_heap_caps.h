@@ -8,7 +8,17 @@
 #ifndef MALLOC_CAP_INTERNAL
 #define MALLOC_CAP_INTERNAL 0
 #endif
+#ifndef MALLOC_CAP_SPIRAM
+#define MALLOC_CAP_SPIRAM 0
+#endif
+#ifndef MALLOC_CAP_DMA
+#define MALLOC_CAP_DMA 0
+#endif
 
 inline void* heap_caps_malloc(size_t size, int /*caps*/) {
     return malloc(size);
 }
+
+inline void* heap_caps_aligned_alloc(size_t alignment, size_t size, int /*caps*/) {
+    return aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <cstdint>
+
+// Microseconds on the host's steady clock
+int64_t esp_timer_get_time();
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+// Minimal FreeRTOS types and port macros for host tests. Tasks are
+// std::threads and ticks are milliseconds (see freertos_stubs.cpp).
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdFAIL 0
+#define pdPASS 1
+#define portMAX_DELAY 0xFFFFFFFFu
+#define portTICK_PERIOD_MS 1
+#define portNUM_PROCESSORS 2
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+// Runs fn on a detached std::thread; stack size, priority and core are ignored
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack_size, void* arg,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core);
+
+// Only deleting the calling task is supported; its thread ends when fn returns
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount();
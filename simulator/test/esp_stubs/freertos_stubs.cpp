@@ -0,0 +1,90 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+struct StubSemaphore {
+    std::mutex mutex;
+    std::condition_variable available;
+    UBaseType_t count;
+    UBaseType_t max_count;
+};
+
+namespace {
+
+const std::chrono::steady_clock::time_point g_boot = std::chrono::steady_clock::now();
+
+} // namespace
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack_size, void* arg,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+    (void)name;
+    (void)stack_size;
+    (void)priority;
+    (void)core;
+    std::thread(fn, arg).detach();
+    if (handle) {
+        *handle = nullptr;
+    }
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    (void)task;
+}
+
+void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+TickType_t xTaskGetTickCount() {
+    return static_cast<TickType_t>(esp_timer_get_time() / 1000);
+}
+
+int64_t esp_timer_get_time() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - g_boot).count();
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return xSemaphoreCreateCounting(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max_count, UBaseType_t initial_count) {
+    SemaphoreHandle_t semaphore = new StubSemaphore();
+    semaphore->count = initial_count;
+    semaphore->max_count = max_count;
+    return semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(semaphore->mutex);
+    auto ready = [semaphore] { return semaphore->count > 0; };
+    if (ticks == portMAX_DELAY) {
+        semaphore->available.wait(lock, ready);
+    } else if (!semaphore->available.wait_for(lock, std::chrono::milliseconds(ticks), ready)) {
+        return pdFALSE;
+    }
+    --semaphore->count;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    // Notified under the lock, so a taker may delete the semaphore as soon
+    // as it returns
+    std::lock_guard<std::mutex> lock(semaphore->mutex);
+    if (semaphore->count >= semaphore->max_count) {
+        return pdFALSE;
+    }
+    ++semaphore->count;
+    semaphore->available.notify_one();
+    return pdTRUE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    delete semaphore;
+}
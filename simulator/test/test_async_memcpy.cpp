@@ -0,0 +1,52 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "subsystems/rendering/async_memcpy.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace digidash;
+
+TEST_CASE("ThreadAsyncMemcpy completes copies in order", "[async_memcpy]") {
+    ThreadAsyncMemcpy copier;
+    REQUIRE(copier.initialize());
+
+    const size_t chunk = 4096;
+    const size_t chunks = 16;
+    std::vector<uint8_t> src(chunk * chunks);
+    std::vector<uint8_t> dst(chunk * chunks, 0);
+    for (size_t i = 0; i < src.size(); ++i) {
+        src[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+
+    std::vector<AsyncMemcpy::Ticket> tickets;
+    for (size_t c = 0; c < chunks; ++c) {
+        tickets.push_back(copier.copy(&dst[c * chunk], &src[c * chunk], chunk));
+    }
+
+    // Waiting on a ticket guarantees that copy and every earlier one landed
+    copier.wait(tickets[chunks / 2]);
+    for (size_t i = 0; i <= (chunks / 2) * chunk + chunk - 1; ++i) {
+        REQUIRE(dst[i] == src[i]);
+    }
+
+    copier.wait_all();
+    REQUIRE(dst == src);
+
+    const AsyncMemcpy::Stats stats = copier.take_stats();
+    REQUIRE(stats.copies == chunks);
+    REQUIRE(stats.bytes == chunk * chunks);
+    REQUIRE(copier.take_stats().copies == 0);
+}
+
+TEST_CASE("ThreadAsyncMemcpy copies synchronously before initialize", "[async_memcpy]") {
+    ThreadAsyncMemcpy copier;
+
+    uint32_t src[4] = {1, 2, 3, 4};
+    uint32_t dst[4] = {0, 0, 0, 0};
+    const AsyncMemcpy::Ticket ticket = copier.copy(dst, src, sizeof(src));
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(dst[i] == src[i]);
+    }
+    copier.wait(ticket);
+}
@@ -1,7 +1,12 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <digidash/binary_gauge_loader.h>
+#include "v3_gauge_builder.h"
 
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
 #include <vector>
 #include <cstring>
 
@@ -176,3 +181,180 @@ TEST_CASE("BinaryGaugeLoader parses multiple paths with commands") {
     REQUIRE(asset.paths.size() == 1);
     REQUIRE(asset.paths[0].commands.size() == 1);
 }
+
+TEST_CASE("BinaryGaugeLoader reads pre-rendered static layers") {
+    std::vector<uint8_t> buf;
+    append_u32(buf, 0x45474744);
+    append_u16(buf, 2);
+    append_u16(buf, 1); // 1 path
+    append_u16(buf, 100);
+    append_u16(buf, 100);
+
+    const char* id = "p0";
+    append_u8(buf, (uint8_t)strlen(id));
+    buf.insert(buf.end(), id, id + strlen(id));
+    append_f32(buf, 1.0f);
+    append_u8(buf, 255); append_u8(buf,255); append_u8(buf,255); append_u8(buf,255);
+    append_u8(buf, 0);
+    append_u8(buf, 0);
+    append_u8(buf, 0); append_u8(buf,0); append_u8(buf,0); append_u8(buf,0);
+    append_u16(buf, 0);
+
+    append_u16(buf, 0); // no animations
+
+    // "S565" chunk with layers for 320x240 and 480x480
+    append_u32(buf, 0x35363553);
+    append_u8(buf, 2);
+    append_u16(buf, 320); append_u16(buf, 240);
+    append_u32(buf, 3);
+    append_u8(buf, 0xC0); append_u8(buf, 0x00); append_u8(buf, 0x00);
+    append_u16(buf, 480); append_u16(buf, 480);
+    append_u32(buf, 1);
+    append_u8(buf, 0x80);
+
+    BinaryGaugeLoader loader;
+    BinaryGaugeLoader::GaugeAsset asset;
+    REQUIRE(loader.load_from_buffer(buf.data(), buf.size(), asset) == true);
+    REQUIRE(asset.static_layers.size() == 2);
+    REQUIRE(asset.static_layers[0].rle565.size() == 3);
+
+    const StaticLayer* layer = BinaryGaugeLoader::find_static_layer(asset, 480, 480);
+    REQUIRE(layer != nullptr);
+    REQUIRE(layer->rle565.size() == 1);
+    REQUIRE(BinaryGaugeLoader::find_static_layer(asset, 720, 720) == nullptr);
+
+    // A truncated chunk drops the layers but keeps the paths
+    buf.pop_back();
+    REQUIRE(loader.load_from_buffer(buf.data(), buf.size(), asset) == true);
+    REQUIRE(asset.paths.size() == 1);
+    REQUIRE(asset.static_layers.empty());
+}
+
+namespace {
+
+// Sectioned v3 file: one path of two commands and a trim-sweep animation
+std::vector<uint8_t> make_v3_gauge() {
+    using namespace gauge_format;
+    const std::string strings = "arcengine_rpm";
+
+    std::vector<PathRecord> paths(1);
+    paths[0].id = {0, 3};
+    paths[0].command_count = 2;
+    paths[0].stroke_width = 4.0f;
+    paths[0].stroke_rgba[0] = 255; paths[0].stroke_rgba[3] = 255;
+    paths[0].stroke_cap = 1;
+
+    const std::vector<CommandRecord> commands = {
+        test::command_record(0, 10.0f, 20.0f),
+        test::command_record(2, 30.0f, 40.0f, 50.0f, 60.0f, 70.0f, 80.0f),
+    };
+
+    std::vector<AnimationRecord> animations(1);
+    animations[0].path_id = {0, 3};
+    animations[0].pid_name = {3, 10};
+    animations[0].type = 1;
+    animations[0].max_value = 8000.0f;
+
+    return test::layout_v3_gauge({{SectionId::Paths, test::section_bytes(paths)},
+                                  {SectionId::Commands, test::section_bytes(commands)},
+                                  {SectionId::Animations, test::section_bytes(animations)},
+                                  {SectionId::Strings, test::section_bytes(strings)}},
+                                 100, 100);
+}
+
+} // namespace
+
+TEST_CASE("BinaryGaugeLoader maps v3 gauges without copying") {
+    const std::vector<uint8_t> buf = make_v3_gauge();
+
+    BinaryGaugeLoader loader;
+    GaugeView view;
+    REQUIRE(loader.map_view(buf.data(), buf.size(), view));
+    REQUIRE(view.width == 100);
+    REQUIRE(view.path_count == 1);
+    REQUIRE(view.string(view.paths[0].id) == "arc");
+    REQUIRE(reinterpret_cast<const uint8_t*>(view.commands) ==
+            buf.data() + test::section_offset(buf, gauge_format::SectionId::Commands));
+    REQUIRE(view.commands[1].type == PathCommand::Type::CubicTo);
+    REQUIRE(view.commands[1].y3 == 80.0f);
+    REQUIRE(view.animation_count == 1);
+    REQUIRE(view.string(view.animations[0].pid_name) == "engine_rpm");
+
+    // The copying path reads the same file, also from unaligned bytes
+    std::vector<uint8_t> shifted(buf.size() + 1);
+    std::memcpy(shifted.data() + 1, buf.data(), buf.size());
+    BinaryGaugeLoader::GaugeAsset asset;
+    REQUIRE(loader.load_from_buffer(shifted.data() + 1, buf.size(), asset));
+    REQUIRE(asset.paths.size() == 1);
+    REQUIRE(asset.paths[0].id == "arc");
+    REQUIRE(asset.paths[0].stroke.cap == StrokeLineCap::Round);
+    REQUIRE(asset.paths[0].commands.size() == 2);
+    REQUIRE(asset.paths[0].commands[1].x2 == 50.0f);
+    REQUIRE(asset.path_animations.size() == 1);
+    REQUIRE(asset.path_animations[0].pid_name == "engine_rpm");
+
+    // Older formats are left to load_from_buffer()
+    std::vector<uint8_t> v2;
+    append_u32(v2, 0x45474744);
+    append_u16(v2, 2);
+    append_u16(v2, 0);
+    append_u16(v2, 1); append_u16(v2, 1);
+    REQUIRE_FALSE(loader.map_view(v2.data(), v2.size(), view));
+}
+
+TEST_CASE("BinaryGaugeLoader rejects v3 references outside their sections") {
+    BinaryGaugeLoader loader;
+    GaugeView view;
+
+    // Commands past the end of the command section
+    std::vector<uint8_t> buf = make_v3_gauge();
+    uint32_t count = 3;
+    std::memcpy(buf.data() + test::section_offset(buf, gauge_format::SectionId::Paths) +
+                    offsetof(gauge_format::PathRecord, command_count),
+                &count, sizeof(count));
+    REQUIRE_FALSE(loader.map_view(buf.data(), buf.size(), view));
+
+    // A string past the end of the string table
+    buf = make_v3_gauge();
+    uint32_t length = 11;
+    std::memcpy(buf.data() + test::section_offset(buf, gauge_format::SectionId::Animations) +
+                    offsetof(gauge_format::AnimationRecord, pid_name) + sizeof(uint32_t),
+                &length, sizeof(length));
+    REQUIRE_FALSE(loader.map_view(buf.data(), buf.size(), view));
+
+    // A section running off the end of the file: the string table is last,
+    // followed only by alignment padding
+    buf = make_v3_gauge();
+    const size_t strings_end = test::section_offset(buf, gauge_format::SectionId::Strings) + 13;
+    REQUIRE(loader.map_view(buf.data(), strings_end, view));
+    REQUIRE_FALSE(loader.map_view(buf.data(), strings_end - 1, view));
+}
+
+TEST_CASE("BinaryGaugeLoader maps v3 gauge files in place") {
+    const std::vector<uint8_t> buf = make_v3_gauge();
+    const std::string path = (std::filesystem::temp_directory_path() / "digidash_mapped.gauge").string();
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(buf.data()), static_cast<std::streamsize>(buf.size()));
+    }
+
+    BinaryGaugeLoader loader;
+    MappedFile mapping;
+    GaugeView view;
+    REQUIRE(loader.map_file(path, mapping, view));
+    REQUIRE(mapping.size() == buf.size());
+    REQUIRE(reinterpret_cast<const uint8_t*>(view.commands) ==
+            mapping.data() + test::section_offset(buf, gauge_format::SectionId::Commands));
+    REQUIRE(view.string(view.paths[0].id) == "arc");
+
+    // The asset path reads the same mapping
+    BinaryGaugeLoader::GaugeAsset asset;
+    REQUIRE(loader.load_from_file(path, asset));
+    REQUIRE(asset.paths.size() == 1);
+    REQUIRE(asset.paths[0].commands[1].y3 == 80.0f);
+
+    mapping.close();
+    REQUIRE(mapping.data() == nullptr);
+    std::filesystem::remove(path);
+    REQUIRE_FALSE(loader.map_file(path, mapping, view));
+}
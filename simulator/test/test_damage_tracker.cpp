@@ -0,0 +1,108 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "digidash/damage_tracker.h"
+
+#include <vector>
+
+using namespace digidash;
+
+namespace {
+
+bool covers(const std::vector<PixelRect>& rects, int x, int y) {
+    for (const auto& rect : rects) {
+        if (x >= rect.x0 && x < rect.x1 && y >= rect.y0 && y < rect.y1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+TEST_CASE("DamageTracker redraws everything until each buffer was drawn", "[damage_tracker]") {
+    DamageTracker tracker(2);
+    tracker.reset(100, 80);
+
+    const std::vector<PixelRect> none;
+    tracker.begin_frame(none);
+    REQUIRE(tracker.area() == 100u * 80u);
+    tracker.begin_frame(none);
+    REQUIRE(tracker.area() == 100u * 80u);
+    tracker.begin_frame(none);
+    REQUIRE(tracker.area() == 0u);
+}
+
+TEST_CASE("DamageTracker carries damage over to the older back buffer", "[damage_tracker]") {
+    DamageTracker tracker(2);
+    tracker.reset(100, 80);
+    const std::vector<PixelRect> none;
+    tracker.begin_frame(none);
+    tracker.begin_frame(none);
+
+    // Changed in frame 3: both buffers have to pick it up
+    tracker.begin_frame({PixelRect{10, 10, 20, 20}});
+    REQUIRE(tracker.area() == 100u);
+    tracker.begin_frame(none);
+    REQUIRE(tracker.area() == 100u);
+    tracker.begin_frame(none);
+    REQUIRE(tracker.area() == 0u);
+
+    // An overlay is only erased from the buffer it was drawn into
+    tracker.add_overlay(PixelRect{50, 50, 60, 55});
+    tracker.begin_frame(none);
+    REQUIRE(tracker.area() == 0u);
+    tracker.begin_frame(none);
+    REQUIRE(tracker.area() == 50u);
+    REQUIRE(covers(tracker.rects(), 55, 52));
+}
+
+TEST_CASE("DamageTracker clips, merges and bands rectangles", "[damage_tracker]") {
+    DamageTracker tracker(1);
+    tracker.reset(100, 80);
+    tracker.begin_frame({});
+
+    tracker.begin_frame({PixelRect{-5, -5, 10, 10},     // Clipped to the frame
+                         PixelRect{8, 8, 20, 20},       // Overlaps the first
+                         PixelRect{70, 60, 120, 100}}); // Separate, clipped
+    const auto& rects = tracker.rects();
+    REQUIRE(rects.size() == 2);
+    for (size_t i = 0; i < rects.size(); ++i) {
+        REQUIRE(rects[i].x0 >= 0);
+        REQUIRE(rects[i].y0 >= 0);
+        REQUIRE(rects[i].x1 <= 100);
+        REQUIRE(rects[i].y1 <= 80);
+        for (size_t j = i + 1; j < rects.size(); ++j) {
+            const bool disjoint = rects[i].x1 <= rects[j].x0 || rects[j].x1 <= rects[i].x0 ||
+                                  rects[i].y1 <= rects[j].y0 || rects[j].y1 <= rects[i].y0;
+            REQUIRE(disjoint);
+        }
+    }
+    REQUIRE(covers(rects, 0, 0));
+    REQUIRE(covers(rects, 19, 19));
+    REQUIRE(covers(rects, 99, 79));
+
+    std::vector<PixelRect> band;
+    tracker.rects_in_band(10, 10, band);
+    REQUIRE(band.size() == 1);
+    REQUIRE(band[0].y0 == 10);
+    REQUIRE(band[0].y1 == 20);
+
+    band.clear();
+    tracker.rects_in_band(40, 10, band);
+    REQUIRE(band.empty());
+}
+
+TEST_CASE("DamageTracker redraws a back buffer it has no history for", "[damage_tracker]") {
+    DamageTracker tracker(2);
+    tracker.reset(100, 80);
+    int buffers[2];
+    const std::vector<PixelRect> none;
+    tracker.begin_frame(none, &buffers[0]);
+    tracker.begin_frame(none, &buffers[1]);
+    tracker.begin_frame(none, &buffers[0]);
+    REQUIRE(tracker.area() == 0u);
+
+    // The display failed to swap and handed out the same buffer again
+    tracker.begin_frame(none, &buffers[0]);
+    REQUIRE(tracker.area() == 100u * 80u);
+}
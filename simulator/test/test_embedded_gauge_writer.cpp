@@ -0,0 +1,328 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "embedded_gauge_writer.hpp"
+#include "digidash/gauge_scene.h"
+#include "v3_gauge_builder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace digidash;
+
+namespace {
+
+constexpr int kSize = 100;
+
+// Sectioned v3 file: an arch whose lowest point lies inside its one cubic,
+// trim-swept by engine_rpm, and a filled, closed box
+std::vector<uint8_t> make_gauge() {
+    using namespace gauge_format;
+    using test::command_record;
+    const std::string strings = "arcboxengine_rpm";
+
+    std::vector<PathRecord> paths(2);
+    paths[0].id = {0, 3};
+    paths[0].command_count = 2;
+    paths[0].stroke_width = 4.0f;
+    paths[0].stroke_rgba[0] = 255; paths[0].stroke_rgba[1] = 80; paths[0].stroke_rgba[3] = 255;
+    paths[1].id = {3, 3};
+    paths[1].command_offset = 2;
+    paths[1].command_count = 5;
+    paths[1].fill_rgba[0] = 20; paths[1].fill_rgba[1] = 20; paths[1].fill_rgba[2] = 30; paths[1].fill_rgba[3] = 255;
+    paths[1].fill_enabled = 1;
+
+    const std::vector<CommandRecord> commands = {
+        command_record(0, 0.0f, 0.0f), command_record(2, 0.0f, 100.0f, 100.0f, 100.0f, 100.0f, 0.0f),
+        command_record(0, 20.0f, 20.0f), command_record(1, 80.0f, 20.0f), command_record(1, 80.0f, 40.0f),
+        command_record(1, 20.0f, 40.0f), command_record(3),
+    };
+
+    std::vector<AnimationRecord> animations(1);
+    animations[0].path_id = {0, 3};
+    animations[0].pid_name = {6, 10};
+    animations[0].type = 1;
+    animations[0].max_value = 8000.0f;
+
+    return test::layout_v3_gauge({{SectionId::Paths, test::section_bytes(paths)},
+                                  {SectionId::Commands, test::section_bytes(commands)},
+                                  {SectionId::Animations, test::section_bytes(animations)},
+                                  {SectionId::Strings, test::section_bytes(strings)}},
+                                 kSize, kSize);
+}
+
+std::string read_text(const std::string& path) {
+    std::ifstream file(path);
+    std::ostringstream os;
+    os << file.rdbuf();
+    return os.str();
+}
+
+// Text between "<name>[] = {" or "<name> = {" and the closing "};"
+std::string initializer(const std::string& header, const std::string& name) {
+    size_t start = header.find(name + "[] = {");
+    if (start == std::string::npos) {
+        start = header.find(name + " = {");
+    }
+    if (start == std::string::npos) {
+        return {};
+    }
+    const size_t open = header.find('{', start);
+    const size_t close = header.find("\n};", open);
+    return header.substr(open + 1, close - open - 1);
+}
+
+std::vector<float> numbers(const std::string& text) {
+    std::vector<float> values;
+    const char* at = text.c_str();
+    while (*at) {
+        if (std::isdigit(static_cast<unsigned char>(*at)) || *at == '-' || *at == '.') {
+            char* end = nullptr;
+            values.push_back(std::strtof(at, &end));
+            at = end;
+        } else {
+            ++at;
+        }
+    }
+    return values;
+}
+
+size_t count_of(const std::string& text, const std::string& word) {
+    size_t count = 0;
+    for (size_t at = text.find(word); at != std::string::npos; at = text.find(word, at + word.size())) {
+        ++count;
+    }
+    return count;
+}
+
+std::string write_embedded(const std::vector<uint8_t>& bytes) {
+    const std::string path = (std::filesystem::temp_directory_path() / "digidash_embedded_gauge_test.h").string();
+    EmbeddedGaugeWriter().write_header(bytes, kSize, kSize, "test-gauge", path);
+    const std::string header = read_text(path);
+    std::filesystem::remove(path);
+    return header;
+}
+
+// The kFlattened* arrays of a written header, read back as GaugeView expects them
+struct FlattenedArrays {
+    std::vector<FlattenedPathRange> paths;
+    std::vector<VectorRenderer::Point> points;
+    std::vector<uint32_t> contours;
+};
+
+FlattenedArrays flattened_arrays(const std::string& header) {
+    const std::vector<float> ranges = numbers(initializer(header, "kFlattenedPaths"));
+    const std::vector<float> coordinates = numbers(initializer(header, "kFlattenedPoints"));
+    const std::vector<float> contour_values = numbers(initializer(header, "kFlattenedContours"));
+    REQUIRE(ranges.size() % 4 == 0);
+    REQUIRE(coordinates.size() % 2 == 0);
+
+    FlattenedArrays arrays;
+    for (size_t i = 0; i < ranges.size(); i += 4) {
+        arrays.paths.push_back({static_cast<uint32_t>(ranges[i]), static_cast<uint32_t>(ranges[i + 1]),
+                                static_cast<uint32_t>(ranges[i + 2]), static_cast<uint32_t>(ranges[i + 3])});
+    }
+    for (size_t i = 0; i < coordinates.size(); i += 2) {
+        arrays.points.push_back({coordinates[i], coordinates[i + 1]});
+    }
+    arrays.contours.assign(contour_values.begin(), contour_values.end());
+    return arrays;
+}
+
+void attach_flattened(GaugeView& view, const FlattenedArrays& arrays) {
+    view.flattened_width = kSize;
+    view.flattened_height = kSize;
+    view.flattened_paths = arrays.paths.data();
+    view.flattened_points = arrays.points.data();
+    view.flattened_point_count = arrays.points.size();
+    view.flattened_contours = arrays.contours.data();
+    view.flattened_contour_count = arrays.contours.size();
+}
+
+// The arch after the fit: 100x75 units drawn at scale 1, centred vertically
+float arc_x(float t) { return 300.0f * t * t - 200.0f * t * t * t; }
+float arc_y(float t) { return 300.0f * t * (1.0f - t) + 12.5f; }
+
+float distance_to_segment(VectorRenderer::Point p, VectorRenderer::Point a, VectorRenderer::Point b) {
+    const float dx = b.x - a.x, dy = b.y - a.y;
+    const float length_sq = dx * dx + dy * dy;
+    const float t = length_sq > 0.0f ? std::clamp(((p.x - a.x) * dx + (p.y - a.y) * dy) / length_sq, 0.0f, 1.0f)
+                                     : 0.0f;
+    return std::hypot(p.x - (a.x + t * dx), p.y - (a.y + t * dy));
+}
+
+float distance_to_polyline(VectorRenderer::Point p, const VectorRenderer::Point* points, size_t count) {
+    float nearest = std::hypot(p.x - points[0].x, p.y - points[0].y);
+    for (size_t i = 0; i + 1 < count; ++i) {
+        nearest = std::min(nearest, distance_to_segment(p, points[i], points[i + 1]));
+    }
+    return nearest;
+}
+
+} // namespace
+
+TEST_CASE("EmbeddedGaugeWriter emits a flattened constexpr view", "[embedded_gauge_writer]") {
+    const std::vector<uint8_t> bytes = make_gauge();
+    const std::string header = write_embedded(bytes);
+
+    REQUIRE(header.find("namespace test_gauge {") != std::string::npos);
+
+    const FlattenedArrays arrays = flattened_arrays(header);
+    const std::vector<FlattenedPathRange>& flattened_paths = arrays.paths;
+    const std::vector<VectorRenderer::Point>& points = arrays.points;
+    const std::vector<uint32_t>& contours = arrays.contours;
+    REQUIRE(flattened_paths.size() == 2);
+
+    const FlattenedPathRange& arc = flattened_paths[0];
+    const FlattenedPathRange& box = flattened_paths[1];
+    REQUIRE(arc.contour_count == 1);
+    REQUIRE(box.contour_count == 1);
+    REQUIRE(box.point_offset == arc.point_count);
+    REQUIRE(points.size() == arc.point_count + box.point_count);
+
+    // One contour per path, in path order, each starting at its path's
+    // first point; contour starts are relative to the path's points
+    REQUIRE(contours.size() == 2);
+    REQUIRE(arc.contour_offset == 0);
+    REQUIRE(box.contour_offset == 1);
+    REQUIRE(contours[arc.contour_offset] == 0);
+    REQUIRE(contours[box.contour_offset] == 0);
+
+    SECTION("the cubic is split at its extreme and flattened within tolerance") {
+        const VectorRenderer::Point* arc_points = points.data() + arc.point_offset;
+        REQUIRE(arc.point_count > 8);
+        REQUIRE(std::fabs(arc_points[0].x) < 1e-4f);
+        REQUIRE(std::fabs(arc_points[0].y - 12.5f) < 1e-4f);
+        REQUIRE(std::fabs(arc_points[arc.point_count - 1].x - 100.0f) < 1e-4f);
+
+        // The lowest point is a flattened point, so the fit matches the curve's
+        float lowest = 0.0f;
+        for (uint32_t i = 0; i < arc.point_count; ++i) {
+            lowest = std::max(lowest, arc_points[i].y);
+        }
+        REQUIRE(std::fabs(lowest - 87.5f) < 1e-3f);
+
+        // Every point lies on the curve, and the curve strays no further
+        // from the points than the flatten plus simplify tolerances
+        std::vector<VectorRenderer::Point> curve;
+        for (int i = 0; i <= 2000; ++i) {
+            const float t = static_cast<float>(i) / 2000.0f;
+            curve.push_back({arc_x(t), arc_y(t)});
+        }
+        for (uint32_t i = 0; i < arc.point_count; ++i) {
+            REQUIRE(distance_to_polyline(arc_points[i], curve.data(), curve.size()) < 1e-2f);
+        }
+        for (const VectorRenderer::Point& on_curve : curve) {
+            REQUIRE(distance_to_polyline(on_curve, arc_points, arc.point_count) <= 0.3f + 1e-3f);
+        }
+    }
+
+    SECTION("the closed box keeps its corners and repeats its first point") {
+        const VectorRenderer::Point* box_points = points.data() + box.point_offset;
+        REQUIRE(box.point_count == 5);
+        REQUIRE(box_points[0].x == box_points[4].x);
+        REQUIRE(box_points[0].y == box_points[4].y);
+        REQUIRE(std::fabs(box_points[0].x - 20.0f) < 1e-4f);
+        REQUIRE(std::fabs(box_points[2].y - 52.5f) < 1e-4f);
+    }
+
+    SECTION("commands retrace the flattened points and kView names every array") {
+        const std::string commands = initializer(header, "kCommands");
+        REQUIRE(count_of(commands, "MoveTo") == 2);
+        REQUIRE(count_of(commands, "LineTo") == points.size() - 2);
+        REQUIRE(count_of(commands, "CubicTo") == 0);
+
+        const std::string view = initializer(header, "GaugeView kView");
+        const std::string expected = "\n    100, 100,\n"
+                                     "    kPaths, 2,\n"
+                                     "    kCommands, " + std::to_string(points.size()) + ",\n"
+                                     "    kAnimations, 1,\n";
+        REQUIRE(view.find(expected) == 0);
+        REQUIRE(view.find("    nullptr, 0,\n    nullptr, 0,\n    100, 100,\n    kFlattenedPaths,\n") !=
+                std::string::npos);
+        REQUIRE(view.find("kFlattenedPoints, " + std::to_string(points.size()) + ",") != std::string::npos);
+        REQUIRE(view.find("kFlattenedContours, 2,") != std::string::npos);
+    }
+
+    SECTION("the arrays round-trip through GaugeView and draw like the gauge file") {
+        BinaryGaugeLoader loader;
+        GaugeView view;
+        REQUIRE(loader.map_view(bytes.data(), bytes.size(), view));
+        GaugeScene flattened;
+        REQUIRE(flattened.load_gauge(view));
+        flattened.set_viewport(kSize, kSize);
+
+        attach_flattened(view, arrays);
+        REQUIRE(BinaryGaugeLoader::validate_view(view));
+        GaugeScene embedded(view);
+        REQUIRE(embedded.is_geometry_borrowed());
+
+        std::vector<uint8_t> expected(static_cast<size_t>(kSize) * kSize * 4, 0);
+        std::vector<uint8_t> actual(expected.size(), 0);
+        for (GaugeScene* scene : {&flattened, &embedded}) {
+            scene->set_pid_value(0, 8000.0f);
+            scene->update(16);
+        }
+        flattened.render(expected.data(), kSize, kSize, kSize * 4);
+        embedded.render(actual.data(), kSize, kSize, kSize * 4);
+
+        // Both flatten to 0.2 pixel, along different points, so only
+        // antialiased edges may differ, and only slightly
+        int largest = 0;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            largest = std::max(largest, std::abs(expected[i] - actual[i]));
+        }
+        REQUIRE(largest <= 48);
+    }
+}
+
+TEST_CASE("Embedded geometry stays with its path when an empty path is dropped", "[embedded_gauge_writer]") {
+    using namespace gauge_format;
+    using test::command_record;
+    const std::string strings = "gapbox";
+
+    // A path of only a Close draws nothing, so GaugeScene drops it, but the
+    // writer still emits its (empty) range ahead of the box's
+    std::vector<PathRecord> paths(2);
+    paths[0].id = {0, 3};
+    paths[0].command_count = 1;
+    paths[1].id = {3, 3};
+    paths[1].command_offset = 1;
+    paths[1].command_count = 5;
+    paths[1].fill_rgba[0] = 200; paths[1].fill_rgba[3] = 255;
+    paths[1].fill_enabled = 1;
+    const std::vector<CommandRecord> commands = {
+        command_record(3),
+        command_record(0, 0.0f, 0.0f), command_record(1, 100.0f, 0.0f), command_record(1, 100.0f, 100.0f),
+        command_record(1, 0.0f, 100.0f), command_record(3),
+    };
+    const std::vector<uint8_t> bytes =
+        test::layout_v3_gauge({{SectionId::Paths, test::section_bytes(paths)},
+                               {SectionId::Commands, test::section_bytes(commands)},
+                               {SectionId::Strings, test::section_bytes(strings)}},
+                              kSize, kSize);
+
+    const FlattenedArrays arrays = flattened_arrays(write_embedded(bytes));
+    REQUIRE(arrays.paths.size() == 2);
+    REQUIRE(arrays.paths[0].point_count == 0);
+    REQUIRE(arrays.paths[1].point_count > 0);
+
+    BinaryGaugeLoader loader;
+    GaugeView view;
+    REQUIRE(loader.map_view(bytes.data(), bytes.size(), view));
+    attach_flattened(view, arrays);
+    REQUIRE(BinaryGaugeLoader::validate_view(view));
+    GaugeScene embedded(view);
+    REQUIRE(embedded.is_geometry_borrowed());
+
+    std::vector<uint8_t> frame(static_cast<size_t>(kSize) * kSize * 4, 0);
+    embedded.update(16);
+    embedded.render(frame.data(), kSize, kSize, kSize * 4);
+    REQUIRE(frame[(50 * kSize + 50) * 4 + 3] == 255);
+}
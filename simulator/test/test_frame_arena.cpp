@@ -0,0 +1,45 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "digidash/frame_arena.h"
+
+#include <cstdint>
+
+using namespace digidash;
+
+TEST_CASE("FrameArena hands out aligned storage from one block", "[frame_arena]") {
+    FrameArena arena(256);
+    REQUIRE(arena.capacity() >= 256);
+
+    uint8_t* bytes = arena.allocate<uint8_t>(3);
+    float* floats = arena.allocate<float>(4);
+    REQUIRE(bytes != nullptr);
+    REQUIRE(reinterpret_cast<uintptr_t>(floats) % alignof(float) == 0);
+    REQUIRE(reinterpret_cast<uint8_t*>(floats) >= bytes + 3);
+    REQUIRE(arena.used() <= arena.capacity());
+
+    // Storage is reused from the start after a reset
+    arena.reset();
+    REQUIRE(arena.used() == 0);
+    REQUIRE(arena.allocate<uint8_t>(1) == bytes);
+}
+
+TEST_CASE("FrameArena grows to the largest frame after overflowing", "[frame_arena]") {
+    FrameArena arena(64);
+    const size_t capacity = arena.capacity();
+
+    // A frame larger than the block still gets distinct, usable storage
+    uint32_t* first = arena.allocate<uint32_t>(capacity / sizeof(uint32_t));
+    uint32_t* second = arena.allocate<uint32_t>(32);
+    REQUIRE(first != second);
+    for (uint32_t i = 0; i < 32; ++i) {
+        second[i] = i;
+    }
+    REQUIRE(arena.used() > capacity);
+
+    // The next frame of the same size fits in the grown block
+    arena.reset();
+    REQUIRE(arena.capacity() >= capacity + 32 * sizeof(uint32_t));
+    arena.allocate<uint32_t>(capacity / sizeof(uint32_t));
+    arena.allocate<uint32_t>(32);
+    REQUIRE(arena.used() <= arena.capacity());
+}
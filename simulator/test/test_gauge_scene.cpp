@@ -0,0 +1,568 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "digidash/gauge_scene.h"
+#include "alloc_counter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace digidash;
+
+namespace {
+
+constexpr int kWidth = 160;
+constexpr int kHeight = 120;
+constexpr int kTileHeight = 16;
+
+PathCommand command(PathCommand::Type type, float x1 = 0, float y1 = 0, float x2 = 0, float y2 = 0,
+                    float x3 = 0, float y3 = 0) {
+    PathCommand cmd;
+    cmd.type = type;
+    cmd.x1 = x1; cmd.y1 = y1;
+    cmd.x2 = x2; cmd.y2 = y2;
+    cmd.x3 = x3; cmd.y3 = y3;
+    return cmd;
+}
+
+// Background, a static ring and a 270 degree arc swept by engine_rpm
+BinaryGaugeLoader::GaugeAsset make_asset() {
+    BinaryGaugeLoader::GaugeAsset asset;
+    asset.name = "test";
+    asset.width = 160;
+    asset.height = 120;
+
+    Path background;
+    background.id = "bg";
+    background.stroke = {0.0f, {0, 0, 0, 0}, StrokeLineCap::Butt};
+    background.fill = {true, {20, 20, 30, 255}};
+    background.commands = {command(PathCommand::Type::MoveTo, 0, 0), command(PathCommand::Type::LineTo, 160, 0),
+                           command(PathCommand::Type::LineTo, 160, 120), command(PathCommand::Type::LineTo, 0, 120),
+                           command(PathCommand::Type::Close)};
+    asset.paths.push_back(background);
+
+    Path arc;
+    arc.id = "rpm_arc";
+    arc.stroke = {8.0f, {255, 80, 0, 255}, StrokeLineCap::Round};
+    arc.fill = {false, {0, 0, 0, 0}};
+    const float cx = 80.0f, cy = 60.0f, r = 45.0f;
+    const int segments = 6;
+    const float start = 2.356f, sweep = 4.712f / segments;
+    const float k = 4.0f / 3.0f * std::tan(sweep / 4.0f);
+    arc.commands.push_back(command(PathCommand::Type::MoveTo, cx + r * std::cos(start), cy + r * std::sin(start)));
+    for (int i = 0; i < segments; ++i) {
+        const float a0 = start + sweep * i, a1 = a0 + sweep;
+        arc.commands.push_back(command(PathCommand::Type::CubicTo,
+                                       cx + r * (std::cos(a0) - k * std::sin(a0)), cy + r * (std::sin(a0) + k * std::cos(a0)),
+                                       cx + r * (std::cos(a1) + k * std::sin(a1)), cy + r * (std::sin(a1) - k * std::cos(a1)),
+                                       cx + r * std::cos(a1), cy + r * std::sin(a1)));
+    }
+    asset.paths.push_back(arc);
+
+    PathAnimationBinding binding;
+    binding.path_id = "rpm_arc";
+    binding.type = PathAnimationBinding::Type::TrimSweep;
+    binding.min_value = 0.0f;
+    binding.max_value = 8000.0f;
+    binding.pid_name = "engine_rpm";
+    asset.path_animations.push_back(binding);
+    return asset;
+}
+
+float rpm_at(int frame) {
+    return 4000.0f + 3900.0f * std::sin(frame * 0.2f);
+}
+
+void render_tiles(const GaugeScene& scene, GaugeScene::RenderContext& context, std::vector<uint8_t>& frame) {
+    for (int y = 0; y < kHeight; y += kTileHeight) {
+        scene.render(context, frame.data() + static_cast<size_t>(y) * kWidth * 4, kWidth, kTileHeight,
+                     kWidth * 4, y);
+    }
+}
+
+} // namespace
+
+TEST_CASE("GaugeScene frames do not allocate once warmed up", "[gauge_scene]") {
+    for (auto mode : {GaugeScene::SweepRenderMode::Geometry, GaugeScene::SweepRenderMode::ParameterMap}) {
+        GaugeScene scene;
+        scene.set_sweep_render_mode(mode);
+        REQUIRE(scene.load_gauge(make_asset()));
+        scene.set_viewport(kWidth, kHeight);
+
+        GaugeScene::RenderContext context;
+        std::vector<uint8_t> frame(static_cast<size_t>(kWidth) * kHeight * 4);
+        std::vector<PixelRect> damage;
+        damage.reserve(64);
+
+        // One full period of the animation sizes every scratch buffer
+        const int period = 32;
+        for (int f = 0; f < period; ++f) {
+            scene.set_pid_value(0, rpm_at(f));
+            scene.update(16);
+            damage.clear();
+            scene.take_damage(damage);
+            render_tiles(scene, context, frame);
+        }
+
+        const size_t before = test::allocation_count();
+        for (int f = period; f < 2 * period; ++f) {
+            scene.set_pid_value(0, rpm_at(f));
+            scene.update(16);
+            damage.clear();
+            scene.take_damage(damage);
+            render_tiles(scene, context, frame);
+        }
+        REQUIRE(test::allocation_count() == before);
+    }
+}
+
+TEST_CASE("GaugeScene damage-limited redraws match full redraws", "[gauge_scene]") {
+    // Small steps up, a reversal back past the start, jumps both ways
+    const float values[] = {0.0f,    150.0f,  400.0f,  1000.0f, 2500.0f, 2600.0f, 2550.0f, 2000.0f, 900.0f,
+                            40.0f,   0.0f,    300.0f,  7000.0f, 7950.0f, 8000.0f, 7600.0f, 3000.0f, 3100.0f};
+    const size_t frame_size = static_cast<size_t>(kWidth) * kHeight * 4;
+    const int stride = kWidth * 4;
+
+    for (auto cap : {StrokeLineCap::Round, StrokeLineCap::Butt}) {
+        for (auto mode : {GaugeScene::SweepRenderMode::Geometry, GaugeScene::SweepRenderMode::ParameterMap}) {
+            BinaryGaugeLoader::GaugeAsset asset = make_asset();
+            asset.paths[1].stroke.cap = cap;
+            GaugeScene scene;
+            scene.set_sweep_render_mode(mode);
+            REQUIRE(scene.load_gauge(asset));
+            scene.set_viewport(kWidth, kHeight);
+
+            GaugeScene::RenderContext context;
+            std::vector<uint8_t> static_layer(frame_size, 0);
+            scene.render_static(context, static_layer.data(), kWidth, kHeight, stride);
+            std::vector<uint8_t> frame = static_layer;
+            scene.render_dynamic(context, frame.data(), kWidth, kHeight, stride);
+            std::vector<PixelRect> damage;
+            scene.take_damage(damage);
+
+            float previous = 0.0f;
+            for (const float value : values) {
+                scene.set_pid_value(0, value);
+                scene.update(16);
+                damage.clear();
+                scene.take_damage(damage);
+                if (value != previous) {
+                    REQUIRE_FALSE(damage.empty());
+                }
+                previous = value;
+
+                // Each damaged rectangle is restored from the static layer
+                // and only its pixels are drawn again
+                for (PixelRect rect : damage) {
+                    rect = {std::max(rect.x0, 0), std::max(rect.y0, 0), std::min(rect.x1, kWidth),
+                            std::min(rect.y1, kHeight)};
+                    if (rect.empty()) {
+                        continue;
+                    }
+                    for (int y = rect.y0; y < rect.y1; ++y) {
+                        const size_t offset = static_cast<size_t>(y) * stride + static_cast<size_t>(rect.x0) * 4;
+                        std::memcpy(frame.data() + offset, static_layer.data() + offset,
+                                    static_cast<size_t>(rect.x1 - rect.x0) * 4);
+                    }
+                    scene.render_dynamic_rect(context, rect, frame.data(), kWidth, kHeight, stride);
+                }
+
+                std::vector<uint8_t> expected = static_layer;
+                scene.render_dynamic(context, expected.data(), kWidth, kHeight, stride);
+                REQUIRE(frame == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("GaugeScene parameter map matches geometry for a full sweep", "[gauge_scene]") {
+    GaugeScene geometry;
+    GaugeScene mapped;
+    mapped.set_sweep_render_mode(GaugeScene::SweepRenderMode::ParameterMap);
+    for (GaugeScene* scene : {&geometry, &mapped}) {
+        REQUIRE(scene->load_gauge(make_asset()));
+        scene->set_viewport(kWidth, kHeight);
+        scene->set_pid_value(0, 8000.0f);
+        scene->update(16);
+    }
+
+    GaugeScene::RenderContext context;
+    std::vector<uint8_t> expected(static_cast<size_t>(kWidth) * kHeight * 4, 0);
+    std::vector<uint8_t> actual(expected.size(), 0);
+    render_tiles(geometry, context, expected);
+    render_tiles(mapped, context, actual);
+    REQUIRE(actual == expected);
+
+    // A partial sweep only differs where the map cuts square instead of
+    // drawing the round cap: within the cap radius plus the edge ramp
+    for (float rpm : {1000.0f, 4000.0f, 6500.0f}) {
+        for (GaugeScene* scene : {&geometry, &mapped}) {
+            scene->set_pid_value(0, rpm);
+            scene->update(16);
+        }
+        std::fill(expected.begin(), expected.end(), 0);
+        std::fill(actual.begin(), actual.end(), 0);
+        render_tiles(geometry, context, expected);
+        render_tiles(mapped, context, actual);
+        REQUIRE(actual != std::vector<uint8_t>(expected.size(), 0));
+
+        const float angle = 2.356f + 4.712f * rpm / 8000.0f;
+        const float cut_x = 80.0f + 45.0f * std::cos(angle);
+        const float cut_y = 60.0f + 45.0f * std::sin(angle);
+        int differing = 0;
+        for (int y = 0; y < kHeight; ++y) {
+            for (int x = 0; x < kWidth; ++x) {
+                const size_t offset = (static_cast<size_t>(y) * kWidth + x) * 4;
+                if (std::memcmp(&actual[offset], &expected[offset], 4) == 0) {
+                    continue;
+                }
+                ++differing;
+                const float distance = std::hypot(x + 0.5f - cut_x, y + 0.5f - cut_y);
+                INFO("rpm " << rpm << " pixel " << x << "," << y);
+                REQUIRE(distance <= 6.0f);
+            }
+        }
+        REQUIRE(differing > 0);
+    }
+}
+
+TEST_CASE("GaugeScene fixed-point display points stay within a pixel fringe", "[gauge_scene]") {
+    GaugeScene exact;
+    GaugeScene fixed;
+    fixed.set_point_encoding(GaugeScene::PointEncoding::Fixed12_4);
+    for (GaugeScene* scene : {&exact, &fixed}) {
+        REQUIRE(scene->load_gauge(make_asset()));
+        scene->set_viewport(kWidth, kHeight);
+        scene->set_pid_value(0, 6000.0f);
+        scene->update(16);
+    }
+
+    GaugeScene::RenderContext context;
+    std::vector<uint8_t> expected(static_cast<size_t>(kWidth) * kHeight * 4, 0);
+    std::vector<uint8_t> actual(expected.size(), 0);
+    render_tiles(exact, context, expected);
+    render_tiles(fixed, context, actual);
+
+    // Points move by at most 1/32 pixel, which only shifts edge coverage
+    int max_difference = 0;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        max_difference = std::max(max_difference, std::abs(expected[i] - actual[i]));
+    }
+    REQUIRE(max_difference <= 16);
+}
+
+TEST_CASE("GaugeScene keeps float points for viewports beyond the fixed-point range", "[gauge_scene]") {
+    constexpr int kWide = 4800;
+    GaugeScene exact;
+    GaugeScene fixed;
+    fixed.set_point_encoding(GaugeScene::PointEncoding::Fixed12_4);
+    for (GaugeScene* scene : {&exact, &fixed}) {
+        REQUIRE(scene->load_gauge(make_asset()));
+        scene->set_viewport(kWide, kWide);
+    }
+
+    // A band through the middle of the gauge, where the arc reaches x > 2048
+    GaugeScene::RenderContext context;
+    std::vector<uint8_t> expected(static_cast<size_t>(kWide) * kTileHeight * 4, 0);
+    std::vector<uint8_t> actual(expected.size(), 0);
+    const int y = kWide / 2;
+    exact.render(context, expected.data(), kWide, kTileHeight, kWide * 4, y);
+    fixed.render(context, actual.data(), kWide, kTileHeight, kWide * 4, y);
+    REQUIRE(actual == expected);
+}
+
+TEST_CASE("GaugeScene flattens curves for the viewport size", "[gauge_scene]") {
+    GaugeScene scene;
+    REQUIRE(scene.load_gauge(make_asset()));
+    scene.set_viewport(kWidth, kHeight);
+    const size_t small = scene.get_point_count();
+
+    // A larger display needs more chords to stay within tolerance
+    scene.set_viewport(kWidth * 4, kHeight * 4);
+    const size_t large = scene.get_point_count();
+    REQUIRE(large > small);
+
+    // Commands are kept, so returning re-flattens to the same points
+    scene.set_viewport(kWidth, kHeight);
+    REQUIRE(scene.get_point_count() == small);
+}
+
+TEST_CASE("GaugeScene loaded before its viewport flattens once, at the viewport", "[gauge_scene]") {
+    GaugeScene first;
+    first.set_viewport(kWidth, kHeight);
+    REQUIRE(first.load_gauge(make_asset()));
+
+    // Nothing is flattened at the gauge's units while the fit is unknown
+    GaugeScene later;
+    REQUIRE(later.load_gauge(make_asset()));
+    REQUIRE(later.get_point_count() == 0);
+    later.set_viewport(kWidth, kHeight);
+    REQUIRE(later.get_point_count() == first.get_point_count());
+
+    // Without any viewport the first update flattens at the gauge's units
+    GaugeScene unfitted;
+    REQUIRE(unfitted.load_gauge(make_asset()));
+    unfitted.update(16);
+    REQUIRE(unfitted.get_point_count() > 0);
+}
+
+TEST_CASE("GaugeScene with a baked static layer flattens only dynamic paths", "[gauge_scene]") {
+    GaugeScene full;
+    GaugeScene baked;
+    baked.set_static_layer_baked(true);
+    for (GaugeScene* scene : {&full, &baked}) {
+        REQUIRE(scene->load_gauge(make_asset()));
+        scene->set_viewport(kWidth, kHeight);
+        scene->set_pid_value(0, 6000.0f);
+        scene->update(16);
+    }
+    REQUIRE(baked.get_point_count() < full.get_point_count());
+
+    // The fit still covers the static paths, so the sweep lands on the same pixels
+    GaugeScene::RenderContext context;
+    std::vector<uint8_t> expected(static_cast<size_t>(kWidth) * kHeight * 4, 0);
+    std::vector<uint8_t> actual(expected.size(), 0);
+    full.render_dynamic(context, expected.data(), kWidth, kHeight, kWidth * 4, 0);
+    baked.render_dynamic(context, actual.data(), kWidth, kHeight, kWidth * 4, 0);
+    REQUIRE(actual == expected);
+
+    std::vector<uint8_t> background(expected.size(), 0);
+    baked.render_static(context, background.data(), kWidth, kHeight, kWidth * 4, 0);
+    REQUIRE(std::all_of(background.begin(), background.end(), [](uint8_t v) { return v == 0; }));
+}
+
+TEST_CASE("GaugeScene loads a mapped v3 view like the parsed asset", "[gauge_scene]") {
+    using namespace gauge_format;
+    const BinaryGaugeLoader::GaugeAsset asset = make_asset();
+
+    // Lay the asset out as GaugeView arrays
+    std::string strings;
+    auto add_string = [&strings](const std::string& text) {
+        const StringRef ref{static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(text.size())};
+        strings += text;
+        return ref;
+    };
+    std::vector<PathRecord> paths;
+    std::vector<PathCommand> commands;
+    for (const auto& path : asset.paths) {
+        PathRecord record{};
+        record.id = add_string(path.id);
+        record.command_offset = static_cast<uint32_t>(commands.size());
+        record.command_count = static_cast<uint32_t>(path.commands.size());
+        record.stroke_width = path.stroke.width;
+        std::memcpy(record.stroke_rgba, &path.stroke.color, 4);
+        std::memcpy(record.fill_rgba, &path.fill.color, 4);
+        record.stroke_cap = static_cast<uint8_t>(path.stroke.cap);
+        record.fill_enabled = path.fill.enabled ? 1 : 0;
+        paths.push_back(record);
+        commands.insert(commands.end(), path.commands.begin(), path.commands.end());
+    }
+    AnimationRecord animation{};
+    animation.path_id = add_string(asset.path_animations[0].path_id);
+    animation.pid_name = add_string(asset.path_animations[0].pid_name);
+    animation.type = static_cast<uint8_t>(asset.path_animations[0].type);
+    animation.min_value = asset.path_animations[0].min_value;
+    animation.max_value = asset.path_animations[0].max_value;
+
+    GaugeView view;
+    view.width = asset.width;
+    view.height = asset.height;
+    view.paths = paths.data();
+    view.path_count = paths.size();
+    view.commands = commands.data();
+    view.command_count = commands.size();
+    view.animations = &animation;
+    view.animation_count = 1;
+    view.strings = strings.data();
+    view.strings_size = strings.size();
+
+    GaugeScene parsed;
+    GaugeScene mapped;
+    GaugeScene borrowed;
+    REQUIRE(parsed.load_gauge(asset));
+    REQUIRE(mapped.load_gauge(view));
+    REQUIRE(borrowed.load_gauge(view, GaugeScene::CommandStorage::Borrow));
+    for (GaugeScene* scene : {&parsed, &mapped, &borrowed}) {
+        scene->set_viewport(kWidth, kHeight);
+        scene->set_pid_value(0, 5000.0f);
+        scene->update(16);
+    }
+
+    GaugeScene::RenderContext context;
+    std::vector<uint8_t> expected(static_cast<size_t>(kWidth) * kHeight * 4, 0);
+    std::vector<uint8_t> actual(expected.size(), 0);
+    render_tiles(parsed, context, expected);
+    render_tiles(mapped, context, actual);
+    REQUIRE(actual == expected);
+
+    // Borrowed commands are read in place, and again for a new viewport
+    std::fill(actual.begin(), actual.end(), 0);
+    render_tiles(borrowed, context, actual);
+    REQUIRE(actual == expected);
+    borrowed.set_viewport(kWidth / 2, kHeight / 2);
+    mapped.set_viewport(kWidth / 2, kHeight / 2);
+    REQUIRE(borrowed.get_point_count() == mapped.get_point_count());
+}
+
+TEST_CASE("GaugeScene restores flattened paths from a tessellation cache", "[gauge_scene]") {
+    const BinaryGaugeLoader::GaugeAsset asset = make_asset();
+    GaugeScene flattened;
+    REQUIRE(flattened.load_gauge(asset));
+    flattened.set_viewport(kWidth, kHeight);
+    REQUIRE_FALSE(flattened.is_tessellation_cached());
+    std::vector<uint8_t> blob;
+    REQUIRE(flattened.save_tessellation(blob));
+
+    auto load_with = [](const BinaryGaugeLoader::GaugeAsset& gauge, const std::vector<uint8_t>& cache,
+                        GaugeScene& scene) {
+        scene.set_viewport(kWidth, kHeight);
+        scene.set_tessellation_cache(cache.data(), cache.size());
+        REQUIRE(scene.load_gauge(gauge));
+    };
+
+    GaugeScene cached;
+    load_with(asset, blob, cached);
+    REQUIRE(cached.is_tessellation_cached());
+    REQUIRE(cached.get_point_count() == flattened.get_point_count());
+    for (GaugeScene* scene : {&flattened, &cached}) {
+        scene->set_pid_value(0, 5000.0f);
+        scene->update(16);
+    }
+    GaugeScene::RenderContext context;
+    std::vector<uint8_t> expected(static_cast<size_t>(kWidth) * kHeight * 4, 0);
+    std::vector<uint8_t> actual(expected.size(), 0);
+    render_tiles(flattened, context, expected);
+    render_tiles(cached, context, actual);
+    REQUIRE(actual == expected);
+
+    // Another viewport is flattened afresh
+    cached.set_viewport(kWidth / 2, kHeight / 2);
+    REQUIRE_FALSE(cached.is_tessellation_cached());
+
+    SECTION("a changed gauge misses") {
+        BinaryGaugeLoader::GaugeAsset changed = asset;
+        changed.paths[1].commands[1].x3 += 1.0f;
+        GaugeScene scene;
+        load_with(changed, blob, scene);
+        REQUIRE_FALSE(scene.is_tessellation_cached());
+    }
+
+    SECTION("other settings miss") {
+        GaugeScene scene;
+        scene.set_point_encoding(GaugeScene::PointEncoding::Fixed12_4);
+        load_with(asset, blob, scene);
+        REQUIRE_FALSE(scene.is_tessellation_cached());
+
+        GaugeScene simplified;
+        simplified.set_simplify_tolerance(0.5f);
+        load_with(asset, blob, simplified);
+        REQUIRE_FALSE(simplified.is_tessellation_cached());
+    }
+
+    SECTION("a damaged blob is ignored") {
+        std::vector<uint8_t> damaged = blob;
+        damaged[damaged.size() - 3] ^= 0x40;
+        GaugeScene scene;
+        load_with(asset, damaged, scene);
+        REQUIRE_FALSE(scene.is_tessellation_cached());
+        REQUIRE(scene.get_point_count() == flattened.get_point_count());
+
+        damaged = blob;
+        damaged.pop_back();
+        GaugeScene truncated;
+        load_with(asset, damaged, truncated);
+        REQUIRE_FALSE(truncated.is_tessellation_cached());
+    }
+}
+
+namespace embedded_fixture {
+
+// Laid out as svg_preprocessor --embed writes it: display-space lines only
+constexpr char kStrings[] = "bgneedleneedleengine_rpm";
+constexpr gauge_format::PathRecord kPaths[] = {
+    {{0, 2}, 0, 5, 0.0f, {0, 0, 0, 0}, {20, 20, 30, 255}, 0, 1, {0, 0}},
+    {{2, 6}, 5, 3, 4.0f, {255, 80, 0, 255}, {0, 0, 0, 0}, 0, 0, {0, 0}},
+};
+constexpr PathCommand kCommands[] = {
+    {PathCommand::Type::MoveTo, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+    {PathCommand::Type::LineTo, 160.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+    {PathCommand::Type::LineTo, 160.0f, 120.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+    {PathCommand::Type::LineTo, 0.0f, 120.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+    {PathCommand::Type::LineTo, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+    {PathCommand::Type::MoveTo, 30.0f, 90.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+    {PathCommand::Type::LineTo, 80.0f, 60.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+    {PathCommand::Type::LineTo, 130.0f, 90.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+};
+constexpr gauge_format::AnimationRecord kAnimations[] = {
+    {{8, 6}, {14, 10}, 1, {0, 0, 0}, 0.0f, 8000.0f},
+};
+constexpr FlattenedPathRange kFlattenedPaths[] = {
+    {0, 5, 0, 1},
+    {5, 3, 1, 1},
+};
+constexpr VectorRenderer::Point kFlattenedPoints[] = {
+    {0.0f, 0.0f}, {160.0f, 0.0f}, {160.0f, 120.0f}, {0.0f, 120.0f}, {0.0f, 0.0f},
+    {30.0f, 90.0f}, {80.0f, 60.0f}, {130.0f, 90.0f},
+};
+constexpr uint32_t kFlattenedContours[] = {0, 0};
+constexpr GaugeView kView = {
+    160, 120,
+    kPaths, 2,
+    kCommands, 8,
+    kAnimations, 1,
+    kStrings, 24,
+    nullptr, 0,
+    nullptr, 0,
+    160, 120,
+    kFlattenedPaths,
+    kFlattenedPoints, 8,
+    kFlattenedContours, 2,
+};
+
+} // namespace embedded_fixture
+
+TEST_CASE("GaugeScene binds a constexpr embedded gauge", "[gauge_scene]") {
+    const GaugeView& view = embedded_fixture::kView;
+    static_assert(embedded_fixture::kView.command_count == 8, "the view is a constant expression");
+    REQUIRE(BinaryGaugeLoader::validate_view(view));
+
+    // At the embedded size the flattened points are drawn in place; a copy
+    // flattens the commands, as does the embedded scene at another size
+    GaugeScene embedded(view);
+    REQUIRE(embedded.is_geometry_borrowed());
+    REQUIRE(embedded.get_point_count() == 0);
+    std::vector<uint8_t> blob;
+    REQUIRE_FALSE(embedded.save_tessellation(blob));
+    GaugeScene copied;
+    REQUIRE(copied.load_gauge(view));
+    copied.set_viewport(kWidth, kHeight);
+    REQUIRE_FALSE(copied.is_geometry_borrowed());
+    REQUIRE(copied.get_point_count() == 8);
+    for (GaugeScene* scene : {&embedded, &copied}) {
+        scene->set_pid_value(0, 8000.0f);
+        scene->update(16);
+    }
+
+    GaugeScene::RenderContext context;
+    std::vector<uint8_t> expected(static_cast<size_t>(kWidth) * kHeight * 4, 0);
+    std::vector<uint8_t> actual(expected.size(), 0);
+    render_tiles(copied, context, expected);
+    render_tiles(embedded, context, actual);
+    REQUIRE(actual == expected);
+
+    // Display-space geometry is drawn where it lies: the fit is the identity.
+    // Pixels are little-endian ARGB words, so red is byte 2
+    auto pixel = [&actual](int x, int y) { return actual.data() + (static_cast<size_t>(y) * kWidth + x) * 4; };
+    REQUIRE(pixel(2, 2)[2] == 20);
+    REQUIRE(pixel(80, 61)[2] == 255);
+    REQUIRE(pixel(80, 75)[2] == 20);
+
+    embedded.set_viewport(kWidth * 2, kHeight * 2);
+    REQUIRE_FALSE(embedded.is_geometry_borrowed());
+    REQUIRE(embedded.get_point_count() == 8);
+    embedded.set_viewport(kWidth, kHeight);
+    REQUIRE(embedded.is_geometry_borrowed());
+}
@@ -0,0 +1,209 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "digidash/gauge_scene.h"
+#include "digidash/gauge_stream.h"
+#include "digidash/rle565.h"
+#include "v3_gauge_builder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace digidash;
+using namespace digidash::gauge_format;
+
+namespace {
+
+constexpr uint32_t kSize = 100;
+
+// A ring of cubics and a swept needle, plus a baked static layer. The
+// commands span several read-ahead windows.
+std::vector<uint8_t> make_gauge(bool commands_first = false) {
+    const std::string strings = "ringneedleengine_rpm";
+    std::vector<CommandRecord> commands;
+    auto add = [&commands](uint8_t type, float x1, float y1, float x2 = 0, float y2 = 0, float x3 = 0, float y3 = 0) {
+        commands.push_back(test::command_record(type, x1, y1, x2, y2, x3, y3));
+    };
+    constexpr int kArcs = 32;
+    add(0, 90.0f, 50.0f);
+    for (int i = 1; i <= kArcs; ++i) {
+        const float a0 = 6.2831853f * (i - 1) / kArcs, a1 = 6.2831853f * i / kArcs;
+        const float k = 40.0f * 4.0f / 3.0f * std::tan((a1 - a0) / 4.0f);
+        add(2, 50 + 40 * std::cos(a0) - k * std::sin(a0), 50 + 40 * std::sin(a0) + k * std::cos(a0),
+            50 + 40 * std::cos(a1) + k * std::sin(a1), 50 + 40 * std::sin(a1) - k * std::cos(a1),
+            50 + 40 * std::cos(a1), 50 + 40 * std::sin(a1));
+    }
+    const uint32_t ring_commands = static_cast<uint32_t>(commands.size());
+    add(0, 50.0f, 50.0f);
+    add(1, 80.0f, 20.0f);
+
+    std::vector<PathRecord> paths(2);
+    paths[0].id = {0, 4};
+    paths[0].command_count = ring_commands;
+    paths[0].stroke_width = 3.0f;
+    paths[0].stroke_rgba[2] = 255; paths[0].stroke_rgba[3] = 255;
+    paths[1].id = {4, 6};
+    paths[1].command_offset = ring_commands;
+    paths[1].command_count = 2;
+    paths[1].stroke_width = 4.0f;
+    paths[1].stroke_rgba[0] = 255; paths[1].stroke_rgba[3] = 255;
+    paths[1].stroke_cap = 1;
+
+    std::vector<AnimationRecord> animations(1);
+    animations[0].path_id = {4, 6};
+    animations[0].pid_name = {10, 10};
+    animations[0].type = 1;
+    animations[0].max_value = 8000.0f;
+
+    std::vector<uint16_t> pixels(kSize * kSize, 0x1234);
+    pixels[0] = 0xFFFF;
+    std::vector<uint8_t> layer_data;
+    rle565_encode(pixels.data(), pixels.size(), layer_data);
+    std::vector<StaticLayerRecord> layers(1);
+    layers[0] = {kSize, kSize, 0, static_cast<uint32_t>(layer_data.size()), 0};
+
+    std::vector<test::GaugeSection> sections = {
+        {SectionId::Strings, test::section_bytes(strings)},
+        {SectionId::Paths, test::section_bytes(paths)},
+        {SectionId::Animations, test::section_bytes(animations)},
+        {SectionId::StaticLayers, test::section_bytes(layers)},
+        {SectionId::Commands, test::section_bytes(commands)},
+        {SectionId::StaticLayerData, layer_data},
+    };
+    if (commands_first) {
+        std::rotate(sections.begin(), sections.begin() + 4, sections.begin() + 5);
+    }
+    return test::layout_v3_gauge(sections, kSize, kSize);
+}
+
+// Hands out a few bytes per read, like a slow SPI flash
+class TrickleSource : public ByteSource {
+public:
+    explicit TrickleSource(const std::vector<uint8_t>& bytes) : bytes_(bytes) {}
+
+    size_t read(void* dst, size_t size) override {
+        largest_request = std::max(largest_request, size);
+        const size_t count = std::min({size, size_t{7}, bytes_.size() - position_});
+        std::memcpy(dst, bytes_.data() + position_, count);
+        position_ += count;
+        return count;
+    }
+
+    size_t largest_request = 0;
+
+private:
+    const std::vector<uint8_t>& bytes_;
+    size_t position_ = 0;
+};
+
+std::vector<uint8_t> render(GaugeScene& scene) {
+    scene.set_viewport(kSize, kSize);
+    scene.set_pid_value(0, 5000.0f);
+    scene.update(16);
+    GaugeScene::RenderContext context;
+    std::vector<uint8_t> frame(kSize * kSize * 4, 0);
+    scene.render(context, frame.data(), kSize, kSize, kSize * 4);
+    return frame;
+}
+
+} // namespace
+
+TEST_CASE("GaugeStreamReader streams a gauge into GaugeScene like a mapped view", "[gauge_stream]") {
+    const std::vector<uint8_t> file = make_gauge();
+    GaugeView mapped_view;
+    BinaryGaugeLoader loader;
+    REQUIRE(loader.map_view(file.data(), file.size(), mapped_view));
+    GaugeScene mapped;
+    REQUIRE(mapped.load_gauge(mapped_view));
+
+    std::istringstream stream(std::string(file.begin(), file.end()));
+    StreamByteSource source(stream);
+    GaugeStreamReader reader(source);
+    REQUIRE(reader.open());
+    const GaugeView& view = reader.metadata();
+    REQUIRE(view.width == kSize);
+    REQUIRE(view.path_count == 2);
+    REQUIRE(view.commands == nullptr);
+    REQUIRE(view.command_count == mapped_view.command_count);
+    REQUIRE(view.string(view.paths[1].id) == "needle");
+    REQUIRE(view.string(view.animations[0].pid_name) == "engine_rpm");
+
+    GaugeScene streamed;
+    REQUIRE(streamed.load_gauge(reader));
+    REQUIRE(render(streamed) == render(mapped));
+
+    // The baked layer follows the commands
+    const StaticLayerRecord* record = view.find_static_layer(kSize, kSize);
+    REQUIRE(record != nullptr);
+    std::vector<uint8_t> layer;
+    REQUIRE(reader.read_static_layer(*record, layer));
+    std::vector<uint16_t> pixels(kSize * kSize);
+    REQUIRE(rle565_decode(layer.data(), layer.size(), pixels.data(), pixels.size()));
+    REQUIRE(pixels[0] == 0xFFFF);
+    REQUIRE(pixels[1] == 0x1234);
+}
+
+TEST_CASE("GaugeStreamReader reassembles records across short reads", "[gauge_stream]") {
+    const std::vector<uint8_t> file = make_gauge();
+    TrickleSource source(file);
+    GaugeStreamReader reader(source);
+    REQUIRE(reader.open());
+    REQUIRE(source.largest_request == GaugeStreamReader::kWindowSize);
+
+    std::vector<PathCommand> commands(reader.metadata().command_count);
+    REQUIRE(commands.size() * sizeof(PathCommand) > GaugeStreamReader::kWindowSize);
+    REQUIRE(reader.read_commands(commands.data(), 5));
+    REQUIRE(reader.read_commands(commands.data() + 5, commands.size() - 5));
+    REQUIRE_FALSE(reader.read_commands(commands.data(), 1));
+
+    GaugeView mapped;
+    BinaryGaugeLoader loader;
+    REQUIRE(loader.map_view(file.data(), file.size(), mapped));
+    REQUIRE(std::memcmp(commands.data(), mapped.commands, commands.size() * sizeof(PathCommand)) == 0);
+}
+
+TEST_CASE("GaugeStreamReader rejects files it cannot stream", "[gauge_stream]") {
+    SECTION("commands before the paths") {
+        const std::vector<uint8_t> file = make_gauge(true);
+        std::istringstream stream(std::string(file.begin(), file.end()));
+        StreamByteSource source(stream);
+        GaugeStreamReader reader(source);
+        REQUIRE_FALSE(reader.open());
+
+        // Still fine for the buffered loader
+        GaugeView view;
+        BinaryGaugeLoader loader;
+        REQUIRE(loader.map_view(file.data(), file.size(), view));
+    }
+
+    SECTION("file ending inside the commands") {
+        std::vector<uint8_t> file = make_gauge();
+        GaugeView view;
+        BinaryGaugeLoader loader;
+        REQUIRE(loader.map_view(file.data(), file.size(), view));
+        file.resize(reinterpret_cast<const uint8_t*>(view.commands + 10) - file.data());
+
+        std::istringstream stream(std::string(file.begin(), file.end()));
+        StreamByteSource source(stream);
+        GaugeStreamReader reader(source);
+        REQUIRE(reader.open());
+        GaugeScene scene;
+        REQUIRE_FALSE(scene.load_gauge(reader));
+        REQUIRE(scene.get_point_count() == 0);
+    }
+
+    SECTION("an older format") {
+        std::vector<uint8_t> file(16, 0);
+        const uint32_t magic = kMagic;
+        const uint16_t version = 2;
+        std::memcpy(file.data(), &magic, sizeof(magic));
+        std::memcpy(file.data() + 4, &version, sizeof(version));
+        std::istringstream stream(std::string(file.begin(), file.end()));
+        StreamByteSource source(stream);
+        GaugeStreamReader reader(source);
+        REQUIRE_FALSE(reader.open());
+    }
+}
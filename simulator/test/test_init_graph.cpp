@@ -0,0 +1,185 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "application/boot_graph.h"
+#include "application/init_graph.h"
+
+#include <atomic>
+#include <chrono>
+#include <initializer_list>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace digidash;
+
+namespace {
+
+// Order in which steps started and finished, across the step tasks
+class EventLog {
+public:
+    void record(InitGraph::StepId step, bool finished) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.push_back({step, finished});
+    }
+
+    // Position of a step's start or finish in the log
+    size_t position(InitGraph::StepId step, bool finished) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < events_.size(); ++i) {
+            if (events_[i].step == step && events_[i].finished == finished) {
+                return i;
+            }
+        }
+        return events_.size();
+    }
+
+private:
+    struct Event {
+        InitGraph::StepId step;
+        bool finished;
+    };
+
+    mutable std::mutex mutex_;
+    std::vector<Event> events_;
+};
+
+// Application's start-up graph, with each step recording itself
+struct BootGraph {
+    InitGraph graph;
+    EventLog log;
+    BootStepIds ids;
+
+    // Leaving storage out builds the compiled-in gauge's graph
+    explicit BootGraph(InitGraph::StepFn display = {}, InitGraph::StepFn storage = {}, InitGraph::StepFn gauge = {},
+                       bool with_storage = true) {
+        BootSteps steps;
+        steps.display = recorded(0, display);
+        steps.renderer = recorded(1, {});
+        if (with_storage) {
+            steps.storage = recorded(2, storage);
+            steps.static_frame = recorded(3, {});
+            steps.splash = recorded(4, {});
+        }
+        steps.gauge = recorded(5, gauge);
+        steps.first_frame = recorded(6, {});
+        ids = add_boot_steps(graph, std::move(steps));
+    }
+
+    // Log positions are keyed by step id, known only once add_boot_steps() returns
+    InitGraph::StepFn recorded(int slot, InitGraph::StepFn body) {
+        return [this, slot, body] {
+            const InitGraph::StepId id = slot_id(slot);
+            log.record(id, false);
+            const bool succeeded = body ? body() : true;
+            log.record(id, true);
+            return succeeded;
+        };
+    }
+
+    InitGraph::StepId slot_id(int slot) const {
+        const InitGraph::StepId by_slot[] = {ids.display, ids.renderer, ids.storage, ids.static_frame,
+                                             ids.splash, ids.gauge, ids.first_frame};
+        return by_slot[slot];
+    }
+
+    // Whether @p step started only after every one of @p before finished
+    bool after(InitGraph::StepId step, std::initializer_list<InitGraph::StepId> before) const {
+        for (InitGraph::StepId dependency : before) {
+            if (log.position(dependency, true) >= log.position(step, false) ||
+                graph.result(dependency).end_us > graph.result(step).start_us) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Whether @p step started only after every other step finished
+    bool last(InitGraph::StepId step) const {
+        for (InitGraph::StepId other = 0; other < graph.step_count(); ++other) {
+            if (other != step && !after(step, {other})) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+bool sleep_ms(int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("InitGraph starts each step after its dependencies finish", "[init_graph]") {
+    BootGraph boot([] { return sleep_ms(30); }, [] { return sleep_ms(10); }, [] { return sleep_ms(20); });
+    REQUIRE(boot.graph.step_count() == 7);
+    REQUIRE(boot.graph.run());
+
+    for (InitGraph::StepId step = 0; step < boot.graph.step_count(); ++step) {
+        const InitGraph::StepResult& result = boot.graph.result(step);
+        REQUIRE(result.ran);
+        REQUIRE(result.succeeded);
+        REQUIRE(result.start_us <= result.end_us);
+    }
+    REQUIRE(boot.after(boot.ids.static_frame, {boot.ids.storage}));
+    REQUIRE(boot.after(boot.ids.splash, {boot.ids.display, boot.ids.renderer, boot.ids.static_frame}));
+    REQUIRE(boot.after(boot.ids.gauge, {boot.ids.storage, boot.ids.renderer}));
+    REQUIRE(boot.last(boot.ids.first_frame));
+}
+
+TEST_CASE("InitGraph boots a compiled-in gauge without storage", "[init_graph]") {
+    BootGraph boot([] { return sleep_ms(20); }, {}, [] { return sleep_ms(10); }, false);
+    REQUIRE(boot.graph.step_count() == 4);
+    REQUIRE(boot.ids.storage == BootStepIds::kNoStep);
+    REQUIRE(boot.ids.splash == BootStepIds::kNoStep);
+    REQUIRE(boot.graph.run());
+
+    REQUIRE(boot.after(boot.ids.gauge, {boot.ids.renderer}));
+    REQUIRE(boot.last(boot.ids.first_frame));
+}
+
+TEST_CASE("InitGraph loads the gauge while the display comes up", "[init_graph]") {
+    // Display bring-up only finishes once the gauge load has started, which
+    // would time out if the two ran one after the other
+    std::atomic<bool> gauge_started(false);
+    std::atomic<bool> overlapped(false);
+    BootGraph boot([&] {
+        for (int i = 0; i < 2000 && !gauge_started; ++i) {
+            sleep_ms(1);
+        }
+        overlapped = gauge_started.load();
+        return true;
+    }, {}, [&] {
+        gauge_started = true;
+        return true;
+    });
+    REQUIRE(boot.graph.run());
+    REQUIRE(overlapped);
+    REQUIRE(boot.log.position(boot.ids.gauge, false) < boot.log.position(boot.ids.display, true));
+}
+
+TEST_CASE("InitGraph skips the steps depending on a failed one", "[init_graph]") {
+    BootGraph boot({}, [] { return false; });
+    REQUIRE_FALSE(boot.graph.run());
+
+    REQUIRE(boot.graph.result(boot.ids.storage).ran);
+    REQUIRE_FALSE(boot.graph.result(boot.ids.storage).succeeded);
+    for (InitGraph::StepId step : {boot.ids.static_frame, boot.ids.splash, boot.ids.gauge, boot.ids.first_frame}) {
+        REQUIRE_FALSE(boot.graph.result(step).ran);
+    }
+    for (InitGraph::StepId step : {boot.ids.display, boot.ids.renderer}) {
+        REQUIRE(boot.graph.result(step).succeeded);
+    }
+}
+
+TEST_CASE("InitGraph fails a step depending on a later one", "[init_graph]") {
+    InitGraph graph;
+    bool ran = false;
+    const InitGraph::StepId early = graph.add_step("early", [&] { ran = true; return true; }, {1});
+    graph.add_step("late", [] { return true; });
+    REQUIRE_FALSE(graph.run());
+    REQUIRE_FALSE(ran);
+    REQUIRE_FALSE(graph.result(early).succeeded);
+}
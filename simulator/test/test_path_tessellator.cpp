@@ -0,0 +1,276 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "digidash/path_tessellator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace digidash;
+
+namespace {
+
+PathCommand command(PathCommand::Type type, float x1 = 0, float y1 = 0, float x2 = 0, float y2 = 0,
+                    float x3 = 0, float y3 = 0) {
+    PathCommand cmd;
+    cmd.type = type;
+    cmd.x1 = x1; cmd.y1 = y1;
+    cmd.x2 = x2; cmd.y2 = y2;
+    cmd.x3 = x3; cmd.y3 = y3;
+    return cmd;
+}
+
+VectorRenderer::Point bernstein(const PathCommand& cubic, VectorRenderer::Point p0, float t) {
+    const float mt = 1.0f - t;
+    return {mt * mt * mt * p0.x + 3.0f * mt * mt * t * cubic.x1 + 3.0f * mt * t * t * cubic.x2 + t * t * t * cubic.x3,
+            mt * mt * mt * p0.y + 3.0f * mt * mt * t * cubic.y1 + 3.0f * mt * t * t * cubic.y2 + t * t * t * cubic.y3};
+}
+
+// The linear walk trim_polyline() replaced: sums segment lengths up to the cut
+std::vector<VectorRenderer::Point> linear_trim(const std::vector<VectorRenderer::Point>& points, float ratio) {
+    std::vector<VectorRenderer::Point> trimmed;
+    if (points.empty() || ratio <= 0.0f) {
+        return trimmed;
+    }
+    if (ratio >= 1.0f) {
+        return points;
+    }
+
+    float total_length = 0.0f;
+    for (size_t i = 1; i < points.size(); ++i) {
+        total_length += std::hypot(points[i].x - points[i - 1].x, points[i].y - points[i - 1].y);
+    }
+    const float target_length = total_length * ratio;
+    if (target_length <= 0.5f) {
+        return trimmed;
+    }
+
+    float accumulated = 0.0f;
+    trimmed.push_back(points.front());
+    for (size_t i = 1; i < points.size(); ++i) {
+        const float dx = points[i].x - points[i - 1].x;
+        const float dy = points[i].y - points[i - 1].y;
+        const float seg_length = std::sqrt(dx * dx + dy * dy);
+        if (accumulated + seg_length < target_length) {
+            trimmed.push_back(points[i]);
+            accumulated += seg_length;
+            continue;
+        }
+        const float t = std::clamp((target_length - accumulated) / seg_length, 0.0f, 1.0f);
+        trimmed.push_back({points[i - 1].x + dx * t, points[i - 1].y + dy * t});
+        break;
+    }
+    return trimmed;
+}
+
+std::vector<VectorRenderer::Point> binary_trim(const std::vector<VectorRenderer::Point>& points, float ratio) {
+    std::vector<float> distance(points.size(), 0.0f);
+    for (size_t i = 1; i < points.size(); ++i) {
+        const float dx = points[i].x - points[i - 1].x;
+        const float dy = points[i].y - points[i - 1].y;
+        distance[i] = distance[i - 1] + std::sqrt(dx * dx + dy * dy);
+    }
+    std::vector<VectorRenderer::Point> out(points.size());
+    out.resize(trim_polyline(points.data(), distance.data(), points.size(), ratio, out.data()));
+    return out;
+}
+
+bool same_points(const std::vector<VectorRenderer::Point>& a, const std::vector<VectorRenderer::Point>& b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const auto& p, const auto& q) {
+               return p.x == q.x && p.y == q.y;
+           });
+}
+
+} // namespace
+
+TEST_CASE("Tessellator chord count follows the curve's size", "[path_tessellator]") {
+    const VectorRenderer::Point a{0, 0}, b{10, 0}, c{20, 0}, d{30, 0};
+    REQUIRE(cubic_segment_count(a, b, c, d, 0.2f) == 1);
+
+    const int small = cubic_segment_count({0, 0}, {0, 50}, {50, 50}, {50, 0}, 0.2f);
+    const int large = cubic_segment_count({0, 0}, {0, 200}, {200, 200}, {200, 0}, 0.2f);
+    REQUIRE(large > small);
+    REQUIRE(large <= 2 * small + 1);   // Chords grow with the square root of size
+}
+
+TEST_CASE("Tessellator forward differencing tracks the Bernstein curve", "[path_tessellator]") {
+    const std::vector<PathCommand> commands = {
+        command(PathCommand::Type::MoveTo, 10, 200),
+        command(PathCommand::Type::CubicTo, 10, -150, 400, 450, 390, 20),
+    };
+    TessellationRange range{0, 2, 0, 0, 0, 0};
+    std::vector<VectorRenderer::Point> points;
+    std::vector<uint32_t> contours;
+    tessellate_paths(commands.data(), &range, 1, TessellationTransform{}, 0.2f, points, contours);
+
+    REQUIRE(points.size() == range.point_count);
+    const size_t segments = points.size() - 1;
+    REQUIRE(segments > 1);
+    for (size_t i = 1; i < points.size(); ++i) {
+        const VectorRenderer::Point expected =
+            bernstein(commands[1], {10, 200}, static_cast<float>(i) / static_cast<float>(segments));
+        REQUIRE(std::fabs(points[i].x - expected.x) < 0.01f);
+        REQUIRE(std::fabs(points[i].y - expected.y) < 0.01f);
+    }
+    // The end point is exact
+    REQUIRE(points.back().x == 390.0f);
+    REQUIRE(points.back().y == 20.0f);
+}
+
+TEST_CASE("Tessellator sizes contours and closes them", "[path_tessellator]") {
+    // A point before the first MoveTo, then a closed triangle
+    const std::vector<PathCommand> commands = {
+        command(PathCommand::Type::LineTo, 5, 5),
+        command(PathCommand::Type::MoveTo, 0, 0),
+        command(PathCommand::Type::LineTo, 10, 0),
+        command(PathCommand::Type::LineTo, 10, 10),
+        command(PathCommand::Type::Close),
+    };
+    TessellationRange range{0, static_cast<uint32_t>(commands.size()), 0, 0, 0, 0};
+    std::vector<VectorRenderer::Point> points;
+    std::vector<uint32_t> contours;
+    TessellationTransform transform;
+    transform.scale = 2.0f;
+    tessellate_paths(commands.data(), &range, 1, transform, 0.2f, points, contours);
+
+    REQUIRE(points.size() == 5);
+    REQUIRE(contours == std::vector<uint32_t>{0, 1});
+    REQUIRE(range.contour_count == 2);
+    REQUIRE(points[0].x == 10.0f);
+    REQUIRE(points[4].x == points[1].x);
+    REQUIRE(points[4].y == points[1].y);
+}
+
+TEST_CASE("Tessellator output does not depend on the worker count", "[path_tessellator]") {
+    std::vector<PathCommand> commands;
+    std::vector<TessellationRange> serial_ranges;
+    for (int p = 0; p < 64; ++p) {
+        const float r = 10.0f + 5.0f * p;
+        serial_ranges.push_back({static_cast<uint32_t>(commands.size()), 3, 0, 0, 0, 0});
+        commands.push_back(command(PathCommand::Type::MoveTo, r, 0));
+        commands.push_back(command(PathCommand::Type::CubicTo, r, r * 0.55f, r * 0.55f, r, 0, r));
+        commands.push_back(command(PathCommand::Type::Close));
+    }
+    std::vector<TessellationRange> parallel_ranges = serial_ranges;
+
+    std::vector<VectorRenderer::FixedPoint> serial_points, parallel_points;
+    std::vector<uint32_t> serial_contours, parallel_contours;
+    tessellate_paths(commands.data(), serial_ranges.data(), serial_ranges.size(), TessellationTransform{}, 0.2f,
+                     serial_points, serial_contours);
+    ThreadPoolTaskExecutor pool(4);
+    tessellate_paths(commands.data(), parallel_ranges.data(), parallel_ranges.size(), TessellationTransform{}, 0.2f,
+                     parallel_points, parallel_contours, &pool);
+
+    REQUIRE(parallel_points.size() == serial_points.size());
+    for (size_t i = 0; i < serial_points.size(); ++i) {
+        REQUIRE(parallel_points[i].x == serial_points[i].x);
+        REQUIRE(parallel_points[i].y == serial_points[i].y);
+    }
+    REQUIRE(parallel_contours == serial_contours);
+    for (size_t i = 0; i < serial_ranges.size(); ++i) {
+        REQUIRE(parallel_ranges[i].point_offset == serial_ranges[i].point_offset);
+        REQUIRE(parallel_ranges[i].point_count == serial_ranges[i].point_count);
+    }
+}
+
+TEST_CASE("Simplification collapses collinear runs and keeps contour ends", "[path_tessellator]") {
+    // An open polyline along a straight line, then a closed square with jitter
+    std::vector<PathCommand> commands;
+    commands.push_back(command(PathCommand::Type::MoveTo, 0, 0));
+    for (int i = 1; i <= 10; ++i) {
+        commands.push_back(command(PathCommand::Type::LineTo, 10.0f * i, 0.0f));
+    }
+    const uint32_t line_commands = static_cast<uint32_t>(commands.size());
+    commands.push_back(command(PathCommand::Type::MoveTo, 0, 50));
+    for (int i = 1; i <= 10; ++i) {
+        commands.push_back(command(PathCommand::Type::LineTo, 10.0f * i, 50.0f + ((i % 2) ? 0.02f : -0.02f)));
+    }
+    commands.push_back(command(PathCommand::Type::LineTo, 100, 150));
+    commands.push_back(command(PathCommand::Type::LineTo, 0, 150));
+    commands.push_back(command(PathCommand::Type::Close));
+
+    std::vector<TessellationRange> ranges = {
+        {0, line_commands, 0, 0, 0, 0},
+        {line_commands, static_cast<uint32_t>(commands.size()) - line_commands, 0, 0, 0, 0},
+    };
+    std::vector<VectorRenderer::Point> points;
+    std::vector<uint32_t> contours;
+    tessellate_paths(commands.data(), ranges.data(), ranges.size(), TessellationTransform{}, 0.2f, points,
+                     contours);
+    const std::vector<VectorRenderer::Point> original = points;
+    simplify_paths(ranges.data(), ranges.size(), 0.1f, points, contours);
+
+    // The line keeps only its ends
+    REQUIRE(ranges[0].point_count == 2);
+    REQUIRE(points[0].x == 0.0f);
+    REQUIRE(points[1].x == 100.0f);
+
+    // The square keeps its corners and stays closed
+    const TessellationRange& square = ranges[1];
+    REQUIRE(square.point_offset == 2);
+    REQUIRE(square.point_count == 5);
+    REQUIRE(points.size() == 7);
+    const VectorRenderer::Point first = points[square.point_offset];
+    const VectorRenderer::Point last = points[square.point_offset + square.point_count - 1];
+    REQUIRE(first.x == last.x);
+    REQUIRE(first.y == last.y);
+    REQUIRE(contours[square.contour_offset] == 0);
+
+    // No dropped point strays further than the tolerance from the result
+    for (size_t i = 12; i < original.size(); ++i) {
+        float best = 1e9f;
+        for (uint32_t k = 0; k + 1 < square.point_count; ++k) {
+            const VectorRenderer::Point a = points[square.point_offset + k];
+            const VectorRenderer::Point b = points[square.point_offset + k + 1];
+            const float dx = b.x - a.x, dy = b.y - a.y;
+            const float t = std::clamp(((original[i].x - a.x) * dx + (original[i].y - a.y) * dy) / (dx * dx + dy * dy),
+                                       0.0f, 1.0f);
+            best = std::min(best, std::hypot(a.x + dx * t - original[i].x, a.y + dy * t - original[i].y));
+        }
+        REQUIRE(best <= 0.1f);
+    }
+}
+
+TEST_CASE("Polyline trim by binary search matches the linear walk", "[path_tessellator]") {
+    // Segments of 8, 4, 12 and 8 pixels: 32 in all, so these ratios land exactly
+    const std::vector<VectorRenderer::Point> points = {{0, 0}, {8, 0}, {8, 4}, {20, 4}, {20, 12}};
+
+    SECTION("ratio 0 draws nothing") {
+        REQUIRE(binary_trim(points, 0.0f).empty());
+        REQUIRE(linear_trim(points, 0.0f).empty());
+        REQUIRE(binary_trim(points, 0.01f).empty());    // Under half a pixel
+    }
+
+    SECTION("ratio 1 keeps every point") {
+        REQUIRE(same_points(binary_trim(points, 1.0f), points));
+        REQUIRE(same_points(linear_trim(points, 1.0f), points));
+    }
+
+    SECTION("a cut on a vertex ends there") {
+        const std::vector<VectorRenderer::Point> trimmed = binary_trim(points, 0.75f);
+        REQUIRE(same_points(trimmed, linear_trim(points, 0.75f)));
+        REQUIRE(trimmed.size() == 4);
+        REQUIRE(trimmed.back().x == 20.0f);
+        REQUIRE(trimmed.back().y == 4.0f);
+    }
+
+    SECTION("a cut inside a segment interpolates one point") {
+        const std::vector<VectorRenderer::Point> trimmed = binary_trim(points, 0.3f);
+        REQUIRE(same_points(trimmed, linear_trim(points, 0.3f)));
+        REQUIRE(trimmed.size() == 3);
+        REQUIRE(trimmed.back().x == 8.0f);
+        REQUIRE(std::fabs(trimmed.back().y - 1.6f) < 1e-5f);
+    }
+
+    SECTION("any ratio along a curved polyline") {
+        std::vector<VectorRenderer::Point> arc;
+        for (int i = 0; i <= 40; ++i) {
+            const float angle = 0.1f * static_cast<float>(i) + 0.013f * static_cast<float>(i * i);
+            arc.push_back({60.0f + 45.0f * std::cos(angle), 60.0f + 45.0f * std::sin(angle)});
+        }
+        for (int step = 0; step <= 1000; ++step) {
+            const float ratio = static_cast<float>(step) / 1000.0f;
+            REQUIRE(same_points(binary_trim(arc, ratio), linear_trim(arc, ratio)));
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "digidash/render_quality_governor.h"
+
+#include <vector>
+
+using namespace digidash;
+
+namespace {
+
+constexpr int kNoAA = static_cast<int>(RenderQuality::NoAA);
+constexpr int kAnalytic = static_cast<int>(RenderQuality::Analytic);
+constexpr int kSupersampled = static_cast<int>(RenderQuality::Supersampled);
+
+} // namespace
+
+TEST_CASE("Governor steps down while frames exceed the budget", "[governor]") {
+    RenderQualityGovernor governor;
+    REQUIRE(governor.level() == kAnalytic);
+
+    // A fast sweep makes every frame expensive
+    for (int frame = 0; frame < 5; ++frame) {
+        governor.submit_frame_time(60.0f);
+    }
+    REQUIRE(governor.level() < kAnalytic);
+
+    for (int frame = 0; frame < 40; ++frame) {
+        governor.submit_frame_time(60.0f);
+    }
+    REQUIRE(governor.level() == kNoAA);
+
+    // Never below the configured floor
+    governor.submit_frame_time(200.0f);
+    REQUIRE(governor.level() == kNoAA);
+}
+
+TEST_CASE("Governor restores full quality once values settle", "[governor]") {
+    RenderQualityGovernor governor;
+    for (int frame = 0; frame < 40; ++frame) {
+        governor.submit_frame_time(60.0f);
+    }
+    REQUIRE(governor.level() == kNoAA);
+
+    // One calm frame is not enough to climb back
+    governor.submit_frame_time(8.0f);
+    REQUIRE(governor.level() == kNoAA);
+
+    for (int frame = 0; frame < 200; ++frame) {
+        governor.submit_frame_time(8.0f);
+    }
+    REQUIRE(governor.level() == kSupersampled);
+}
+
+TEST_CASE("Governor holds steady near the budget", "[governor]") {
+    RenderQualityGovernor governor;
+
+    // Between the upgrade threshold and the budget nothing changes
+    for (int frame = 0; frame < 500; ++frame) {
+        governor.submit_frame_time(28.0f);
+        REQUIRE(governor.level() == kAnalytic);
+    }
+}
+
+TEST_CASE("Governor backs off from a tier it cannot sustain", "[governor]") {
+    RenderQualityGovernor governor;
+
+    // Supersampling blows the budget, Analytic sits comfortably under it
+    std::vector<int> probes;
+    int previous = governor.level();
+    for (int frame = 0; frame < 3000; ++frame) {
+        const float cost = (governor.level() == kSupersampled) ? 45.0f : 15.0f;
+        governor.submit_frame_time(cost);
+        REQUIRE(governor.level() >= kAnalytic);
+        if (governor.level() == kSupersampled && previous != kSupersampled) {
+            probes.push_back(frame);
+        }
+        previous = governor.level();
+    }
+
+    // Each failed upgrade doubles the wait before the next probe, up to the cap
+    REQUIRE(probes.size() >= 3);
+    for (size_t i = 2; i < probes.size(); ++i) {
+        REQUIRE(probes[i] - probes[i - 1] >= probes[i - 1] - probes[i - 2]);
+    }
+    const auto& config = governor.config();
+    REQUIRE(probes.back() - probes[probes.size() - 2] >= static_cast<int>(config.max_upgrade_hold_frames));
+}
+
+TEST_CASE("Governor respects a custom tier range", "[governor]") {
+    RenderQualityGovernor::Config config;
+    config.min_level = 1;
+    config.max_level = 2;
+    config.initial_level = 3;
+    RenderQualityGovernor governor(config);
+    REQUIRE(governor.level() == 2);
+
+    for (int frame = 0; frame < 100; ++frame) {
+        governor.submit_frame_time(100.0f);
+    }
+    REQUIRE(governor.level() == 1);
+
+    governor.reset();
+    REQUIRE(governor.level() == 2);
+}
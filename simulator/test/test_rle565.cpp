@@ -0,0 +1,41 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "digidash/rle565.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace digidash;
+
+TEST_CASE("RLE565 round-trips runs and literals", "[rle565]") {
+    // A flat background, a gradient edge, and runs past the short and long packet limits
+    std::vector<uint16_t> pixels(20000, 0x0000);
+    for (size_t i = 100; i < 180; ++i) {
+        pixels[i] = static_cast<uint16_t>(i * 97);
+    }
+    for (size_t i = 180; i < 250; ++i) {
+        pixels[i] = 0xF800;
+    }
+    pixels.back() = 0x07E0;
+
+    std::vector<uint8_t> encoded;
+    rle565_encode(pixels.data(), pixels.size(), encoded);
+    REQUIRE(encoded.size() < 300);
+
+    std::vector<uint16_t> decoded(pixels.size(), 0xFFFF);
+    REQUIRE(rle565_decode(encoded.data(), encoded.size(), decoded.data(), decoded.size()));
+    REQUIRE(decoded == pixels);
+}
+
+TEST_CASE("RLE565 rejects streams of the wrong size", "[rle565]") {
+    const std::vector<uint16_t> pixels = {1, 2, 3, 3, 3, 3, 4};
+    std::vector<uint8_t> encoded;
+    rle565_encode(pixels.data(), pixels.size(), encoded);
+
+    std::vector<uint16_t> decoded(pixels.size() + 1);
+    REQUIRE(rle565_decode(encoded.data(), encoded.size(), decoded.data(), pixels.size()));
+    // Too few pixels, too many pixels, truncated packet
+    REQUIRE_FALSE(rle565_decode(encoded.data(), encoded.size(), decoded.data(), pixels.size() + 1));
+    REQUIRE_FALSE(rle565_decode(encoded.data(), encoded.size(), decoded.data(), pixels.size() - 1));
+    REQUIRE_FALSE(rle565_decode(encoded.data(), encoded.size() - 1, decoded.data(), pixels.size()));
+}
@@ -0,0 +1,163 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "digidash/span_blend.h"
+#include "digidash/color_utils.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace digidash;
+
+namespace {
+
+// Per-pixel divide-based src-over the renderer used before span blending
+void reference_blend(uint8_t* px, uint8_t src_r, uint8_t src_g, uint8_t src_b, uint8_t src_a) {
+    if (src_a == 0) {
+        return;
+    }
+    if (src_a == 255) {
+        px[0] = src_r;
+        px[1] = src_g;
+        px[2] = src_b;
+        px[3] = 255;
+        return;
+    }
+
+    const uint32_t dst_a = px[3];
+    const uint32_t inv_src_a = 255u - src_a;
+    const uint32_t out_a = src_a + ((dst_a * inv_src_a + 127u) / 255u);
+
+    const uint32_t out_r_p = src_r * src_a + ((px[0] * dst_a * inv_src_a + 127u) / 255u);
+    const uint32_t out_g_p = src_g * src_a + ((px[1] * dst_a * inv_src_a + 127u) / 255u);
+    const uint32_t out_b_p = src_b * src_a + ((px[2] * dst_a * inv_src_a + 127u) / 255u);
+
+    px[0] = static_cast<uint8_t>((out_r_p + (out_a / 2u)) / out_a);
+    px[1] = static_cast<uint8_t>((out_g_p + (out_a / 2u)) / out_a);
+    px[2] = static_cast<uint8_t>((out_b_p + (out_a / 2u)) / out_a);
+    px[3] = static_cast<uint8_t>(out_a);
+}
+
+int max_channel_error(SpanBlendKernel kernel, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::uniform_int_distribution<int> pick(0, 3);
+
+    const size_t count = 1027; // odd length exercises the scalar tail
+    std::vector<uint8_t> dst(count * 4);
+    std::vector<uint8_t> coverage(count);
+    for (size_t i = 0; i < count; ++i) {
+        // Mix the pixel classes the vector kernels special-case
+        static const uint8_t alphas[3] = {0, 255, 0};
+        const int cls = pick(rng);
+        dst[i * 4 + 0] = static_cast<uint8_t>(byte(rng));
+        dst[i * 4 + 1] = static_cast<uint8_t>(byte(rng));
+        dst[i * 4 + 2] = static_cast<uint8_t>(byte(rng));
+        dst[i * 4 + 3] = (cls < 3) ? alphas[cls] : static_cast<uint8_t>(byte(rng));
+        const int cov_cls = pick(rng);
+        coverage[i] = (cov_cls == 0) ? 0 : (cov_cls == 1) ? 255 : static_cast<uint8_t>(byte(rng));
+    }
+
+    const uint8_t r = static_cast<uint8_t>(byte(rng));
+    const uint8_t g = static_cast<uint8_t>(byte(rng));
+    const uint8_t b = static_cast<uint8_t>(byte(rng));
+    const uint8_t a = (seed % 3 == 0) ? 255 : static_cast<uint8_t>(byte(rng));
+
+    std::vector<uint8_t> expected = dst;
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t src_a = static_cast<uint8_t>((a * coverage[i] + 127) / 255);
+        reference_blend(&expected[i * 4], r, g, b, src_a);
+    }
+
+    REQUIRE(set_span_blend_kernel(kernel));
+    blend_span_rgba(dst.data(), coverage.data(), count, r, g, b, a);
+
+    int worst = 0;
+    for (size_t i = 0; i < dst.size(); ++i) {
+        worst = std::max(worst, std::abs(static_cast<int>(dst[i]) - static_cast<int>(expected[i])));
+    }
+    return worst;
+}
+
+} // namespace
+
+TEST_CASE("Span blend kernels match scalar src-over within 1 LSB", "[span_blend]") {
+    const SpanBlendKernel original = active_span_blend_kernel();
+    const SpanBlendKernel kernels[] = {
+        SpanBlendKernel::Scalar,
+        SpanBlendKernel::SSE2,
+        SpanBlendKernel::AVX2,
+        SpanBlendKernel::NEON,
+    };
+
+    for (SpanBlendKernel kernel : kernels) {
+        if (!span_blend_kernel_supported(kernel)) {
+            continue;
+        }
+        for (uint32_t seed = 1; seed <= 24; ++seed) {
+            INFO("kernel " << static_cast<int>(kernel) << " seed " << seed);
+            REQUIRE(max_channel_error(kernel, seed) <= 1);
+        }
+    }
+
+    REQUIRE(set_span_blend_kernel(original));
+}
+
+TEST_CASE("Span blend is exact for opaque and empty destinations", "[span_blend]") {
+    const SpanBlendKernel original = active_span_blend_kernel();
+    REQUIRE(span_blend_kernel_supported(SpanBlendKernel::Scalar));
+    REQUIRE_FALSE(span_blend_kernel_supported(SpanBlendKernel::PIE));
+
+    for (int dst_a : {0, 255}) {
+        for (int cov = 0; cov <= 255; ++cov) {
+            uint8_t px[4] = {40, 90, 200, static_cast<uint8_t>(dst_a)};
+            uint8_t expected[4] = {40, 90, 200, static_cast<uint8_t>(dst_a)};
+            const uint8_t coverage = static_cast<uint8_t>(cov);
+            reference_blend(expected, 250, 10, 128, static_cast<uint8_t>((200 * cov + 127) / 255));
+            blend_span_rgba(px, &coverage, 1, 250, 10, 128, 200);
+            for (int c = 0; c < 4; ++c) {
+                REQUIRE(px[c] == expected[c]);
+            }
+        }
+    }
+
+    REQUIRE(active_span_blend_kernel() == original);
+}
+
+TEST_CASE("RGB565 span blend interpolates in 565 space", "[span_blend]") {
+    const uint16_t black = 0x0000;
+    const uint16_t white = 0xFFFF;
+
+    std::vector<uint16_t> row(256, black);
+    std::vector<uint8_t> coverage(256);
+    for (int i = 0; i < 256; ++i) {
+        coverage[i] = static_cast<uint8_t>(i);
+    }
+    blend_span_rgb565(row.data(), coverage.data(), row.size(), 255, 255, 255, 255);
+
+    REQUIRE(row[0] == black);
+    REQUIRE(row[255] == white);
+    for (int i = 0; i < 256; ++i) {
+        const int r5 = (row[i] >> 11) & 0x1F;
+        const int g6 = (row[i] >> 5) & 0x3F;
+        const int b5 = row[i] & 0x1F;
+        INFO("coverage " << i);
+        // 1/32 alpha steps: allow one step of quantization per channel
+        REQUIRE(std::abs(r5 * 255 - 31 * i) <= 255);
+        REQUIRE(std::abs(g6 * 255 - 63 * i) <= 2 * 255);
+        REQUIRE(b5 == r5);
+        if (i > 0) {
+            REQUIRE(row[i] >= row[i - 1]);
+        }
+    }
+
+    // Opaque coverage writes the source color exactly; zero alpha is a no-op
+    uint16_t px = 0x1234;
+    const uint8_t full = 255;
+    blend_span_rgb565(&px, &full, 1, 200, 100, 50, 0);
+    REQUIRE(px == 0x1234);
+    blend_span_rgb565(&px, &full, 1, 200, 100, 50, 255);
+    REQUIRE(px == rgba_to_rgb565(200, 100, 50));
+}
@@ -0,0 +1,68 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "digidash/spatial_grid.h"
+
+#include <vector>
+
+using namespace digidash;
+
+TEST_CASE("SpatialGrid returns intersecting items in paint order", "[spatial_grid]") {
+    SpatialGrid grid;
+    grid.reset(256.0f, 256.0f, 32.0f);
+
+    grid.insert(0, {0.0f, 0.0f, 255.0f, 255.0f}, SpatialGrid::Layer::Static);     // background
+    grid.insert(1, {10.0f, 10.0f, 20.0f, 20.0f}, SpatialGrid::Layer::Static);      // top-left
+    grid.insert(2, {200.0f, 10.0f, 240.0f, 60.0f}, SpatialGrid::Layer::Dynamic);   // top-right
+    grid.insert(3, {60.0f, 60.0f, 180.0f, 180.0f}, SpatialGrid::Layer::Static);    // spans many cells
+    REQUIRE(grid.size() == 4);
+
+    std::vector<uint32_t> ids;
+    grid.query({0.0f, 0.0f, 255.0f, 63.0f}, SpatialGrid::kAllLayers, ids);
+    REQUIRE(ids == std::vector<uint32_t>{0, 1, 2, 3});
+
+    // Same rows, but only the right half: X culling drops the top-left item
+    grid.query({128.0f, 0.0f, 255.0f, 40.0f}, SpatialGrid::kAllLayers, ids);
+    REQUIRE(ids == std::vector<uint32_t>{0, 2});
+
+    grid.query({0.0f, 0.0f, 255.0f, 63.0f}, SpatialGrid::kDynamicMask, ids);
+    REQUIRE(ids == std::vector<uint32_t>{2});
+
+    grid.query({100.0f, 100.0f, 120.0f, 120.0f}, SpatialGrid::kStaticMask, ids);
+    REQUIRE(ids == std::vector<uint32_t>{0, 3});
+}
+
+TEST_CASE("SpatialGrid moves dynamic items incrementally", "[spatial_grid]") {
+    SpatialGrid grid;
+    grid.reset(256.0f, 256.0f, 32.0f);
+    grid.insert(7, {0.0f, 0.0f, 10.0f, 10.0f}, SpatialGrid::Layer::Dynamic);
+
+    REQUIRE(grid.any({0.0f, 0.0f, 31.0f, 31.0f}, SpatialGrid::Layer::Dynamic));
+    REQUIRE_FALSE(grid.any({0.0f, 0.0f, 31.0f, 31.0f}, SpatialGrid::Layer::Static));
+
+    // Within the same cell range
+    grid.update(7, {2.0f, 2.0f, 12.0f, 12.0f});
+    REQUIRE(grid.any({11.0f, 11.0f, 12.0f, 12.0f}, SpatialGrid::Layer::Dynamic));
+    REQUIRE_FALSE(grid.any({0.0f, 0.0f, 1.0f, 1.0f}, SpatialGrid::Layer::Dynamic));
+
+    // Across cells
+    grid.update(7, {150.0f, 150.0f, 220.0f, 160.0f});
+    REQUIRE_FALSE(grid.any({0.0f, 0.0f, 31.0f, 31.0f}, SpatialGrid::Layer::Dynamic));
+    std::vector<uint32_t> ids;
+    grid.query({200.0f, 155.0f, 210.0f, 158.0f}, SpatialGrid::kAllLayers, ids);
+    REQUIRE(ids == std::vector<uint32_t>{7});
+
+    grid.remove(7);
+    REQUIRE(grid.size() == 0);
+    REQUIRE_FALSE(grid.any({0.0f, 0.0f, 255.0f, 255.0f}, SpatialGrid::Layer::Dynamic));
+}
+
+TEST_CASE("SpatialGrid clamps items outside the grid", "[spatial_grid]") {
+    SpatialGrid grid;
+    grid.reset(100.0f, 100.0f, 32.0f);
+    grid.insert(0, {-50.0f, -50.0f, 5.0f, 5.0f}, SpatialGrid::Layer::Static);
+    grid.insert(1, {300.0f, 300.0f, 400.0f, 400.0f}, SpatialGrid::Layer::Static);
+
+    std::vector<uint32_t> ids;
+    grid.query({0.0f, 0.0f, 99.0f, 99.0f}, SpatialGrid::kAllLayers, ids);
+    REQUIRE(ids == std::vector<uint32_t>{0});
+}
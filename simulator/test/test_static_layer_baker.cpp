@@ -0,0 +1,57 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "static_layer_baker.hpp"
+#include "digidash/color_utils.h"
+#include "digidash/rle565.h"
+#include "v3_gauge_builder.h"
+
+#include <string>
+#include <vector>
+
+using namespace digidash;
+
+namespace {
+
+constexpr int kSize = 100;
+
+// Sectioned v3 file: an opaque red background with a blue box on top
+std::vector<uint8_t> make_gauge() {
+    using namespace gauge_format;
+    using test::command_record;
+    const std::string strings = "bgbox";
+
+    std::vector<PathRecord> paths(2);
+    paths[0].id = {0, 2};
+    paths[0].command_count = 5;
+    paths[0].fill_rgba[0] = 255; paths[0].fill_rgba[3] = 255;
+    paths[0].fill_enabled = 1;
+    paths[1].id = {2, 3};
+    paths[1].command_offset = 5;
+    paths[1].command_count = 5;
+    paths[1].fill_rgba[2] = 255; paths[1].fill_rgba[3] = 255;
+    paths[1].fill_enabled = 1;
+
+    const std::vector<CommandRecord> commands = {
+        command_record(0, 0.0f, 0.0f), command_record(1, 100.0f, 0.0f), command_record(1, 100.0f, 100.0f),
+        command_record(1, 0.0f, 100.0f), command_record(3),
+        command_record(0, 20.0f, 20.0f), command_record(1, 40.0f, 20.0f), command_record(1, 40.0f, 40.0f),
+        command_record(1, 20.0f, 40.0f), command_record(3),
+    };
+
+    return test::layout_v3_gauge({{SectionId::Paths, test::section_bytes(paths)},
+                                  {SectionId::Commands, test::section_bytes(commands)},
+                                  {SectionId::Strings, test::section_bytes(strings)}},
+                                 kSize, kSize);
+}
+
+} // namespace
+
+TEST_CASE("StaticLayerBaker bakes path colours in RGB565 channel order", "[static_layer_baker]") {
+    StaticLayerBaker baker;
+    const std::vector<uint8_t> layer = baker.bake(make_gauge(), kSize, kSize);
+
+    std::vector<uint16_t> pixels(static_cast<size_t>(kSize) * kSize);
+    REQUIRE(rle565_decode(layer.data(), layer.size(), pixels.data(), pixels.size()));
+    REQUIRE(pixels[10 * kSize + 10] == rgba_to_rgb565(255, 0, 0));
+    REQUIRE(pixels[30 * kSize + 30] == rgba_to_rgb565(0, 0, 255));
+}
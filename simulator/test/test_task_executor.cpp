@@ -0,0 +1,61 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "digidash/task_executor.h"
+
+#include <atomic>
+#include <vector>
+
+using namespace digidash;
+
+TEST_CASE("ThreadPoolTaskExecutor runs every task exactly once", "[task_executor]") {
+    ThreadPoolTaskExecutor executor(4);
+    REQUIRE(executor.worker_count() == 4);
+
+    // Several batches back to back exercise the hand-off between jobs
+    for (size_t task_count : {0u, 1u, 3u, 12u, 257u}) {
+        std::vector<std::atomic<int>> runs(task_count);
+        std::atomic<bool> bad_worker{false};
+
+        executor.parallel_for(task_count, [&](size_t task, size_t worker) {
+            if (worker >= executor.worker_count()) {
+                bad_worker = true;
+            }
+            runs[task].fetch_add(1);
+        });
+
+        REQUIRE_FALSE(bad_worker);
+        for (size_t task = 0; task < task_count; ++task) {
+            REQUIRE(runs[task].load() == 1);
+        }
+    }
+}
+
+TEST_CASE("ThreadPoolTaskExecutor keeps per-worker state disjoint", "[task_executor]") {
+    ThreadPoolTaskExecutor executor(3);
+
+    // Unsynchronized per-worker accumulators must add up, which only holds
+    // if no two tasks ever run concurrently under the same worker index
+    std::vector<size_t> sums(executor.worker_count(), 0);
+    const size_t task_count = 1000;
+    executor.parallel_for(task_count, [&](size_t task, size_t worker) {
+        sums[worker] += task;
+    });
+
+    size_t total = 0;
+    for (size_t sum : sums) {
+        total += sum;
+    }
+    REQUIRE(total == task_count * (task_count - 1) / 2);
+}
+
+TEST_CASE("InlineTaskExecutor runs tasks in order on worker 0", "[task_executor]") {
+    InlineTaskExecutor executor;
+    REQUIRE(executor.worker_count() == 1);
+
+    std::vector<size_t> order;
+    executor.parallel_for(5, [&](size_t task, size_t worker) {
+        REQUIRE(worker == 0);
+        order.push_back(task);
+    });
+    REQUIRE(order == std::vector<size_t>{0, 1, 2, 3, 4});
+}
@@ -1,19 +1,134 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include "platform/display/display_driver.h"
+#include "subsystems/rendering/direct_tile_renderer.h"
+#include "subsystems/rendering/render_engine.h"
 #include "subsystems/rendering/tile_height_renderer.h"
 #include "esp_stubs.h"
 #include "digidash/color_utils.h"
+#include "digidash/rle565.h"
+#include "alloc_counter.h"
+#include "v3_gauge_builder.h"
+#include "subsystems/rendering/fps_overlay.h"
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
 
 using namespace digidash;
 
+namespace {
+
+// Sectioned v3 file: filled background plus a polyline arc swept by engine_rpm
+std::vector<uint8_t> make_swept_gauge() {
+    using namespace gauge_format;
+    using test::command_record;
+    const std::string strings = "bgrpm_arcengine_rpm";
+
+    const uint32_t arc_points = 24;
+    std::vector<PathRecord> paths(2);
+    paths[0].id = {0, 2};
+    paths[0].command_count = 5;
+    paths[0].fill_rgba[0] = 20; paths[0].fill_rgba[1] = 20; paths[0].fill_rgba[2] = 30; paths[0].fill_rgba[3] = 255;
+    paths[0].fill_enabled = 1;
+    paths[1].id = {2, 7};
+    paths[1].command_offset = 5;
+    paths[1].command_count = arc_points;
+    paths[1].stroke_width = 4.0f;
+    paths[1].stroke_rgba[0] = 255; paths[1].stroke_rgba[1] = 80; paths[1].stroke_rgba[3] = 255;
+    paths[1].stroke_cap = 1;    // Round
+
+    std::vector<CommandRecord> commands = {
+        command_record(0, 0.0f, 0.0f), command_record(1, 64.0f, 0.0f), command_record(1, 64.0f, 48.0f),
+        command_record(1, 0.0f, 48.0f), command_record(3),
+    };
+    for (uint32_t i = 0; i < arc_points; ++i) {
+        const float angle = 2.4f + 4.6f * i / (arc_points - 1);
+        commands.push_back(command_record(i == 0 ? 0 : 1, 32 + 18 * std::cos(angle), 24 + 18 * std::sin(angle)));
+    }
+
+    std::vector<AnimationRecord> animations(1);
+    animations[0].path_id = {2, 7};
+    animations[0].pid_name = {9, 10};
+    animations[0].type = 1;     // TrimSweep
+    animations[0].max_value = 8000.0f;
+
+    return test::layout_v3_gauge({{SectionId::Paths, test::section_bytes(paths)},
+                                  {SectionId::Commands, test::section_bytes(commands)},
+                                  {SectionId::Animations, test::section_bytes(animations)},
+                                  {SectionId::Strings, test::section_bytes(strings)}},
+                                 64, 48);
+}
+
+// Sectioned v3 file: one filled box over the whole canvas, with a 64x48
+// static layer of @p layer_rgb565 baked in, or a corrupt one
+std::vector<uint8_t> make_baked_gauge(uint16_t layer_rgb565, bool corrupt_layer) {
+    using namespace gauge_format;
+    using test::command_record;
+    const std::string strings = "bg";
+
+    std::vector<PathRecord> paths(1);
+    paths[0].id = {0, 2};
+    paths[0].command_count = 5;
+    paths[0].fill_rgba[0] = 40; paths[0].fill_rgba[1] = 90; paths[0].fill_rgba[2] = 40; paths[0].fill_rgba[3] = 255;
+    paths[0].fill_enabled = 1;
+    const std::vector<CommandRecord> commands = {
+        command_record(0, 0.0f, 0.0f), command_record(1, 64.0f, 0.0f), command_record(1, 64.0f, 48.0f),
+        command_record(1, 0.0f, 48.0f), command_record(3),
+    };
+
+    const std::vector<uint16_t> layer_pixels(64 * 48, layer_rgb565);
+    std::vector<uint8_t> layer;
+    rle565_encode(layer_pixels.data(), layer_pixels.size(), layer);
+    if (corrupt_layer) {
+        layer.resize(layer.size() / 2);
+    }
+    std::vector<StaticLayerRecord> layers(1);
+    layers[0].width = 64;
+    layers[0].height = 48;
+    layers[0].data_size = static_cast<uint32_t>(layer.size());
+
+    return test::layout_v3_gauge({{SectionId::Paths, test::section_bytes(paths)},
+                                  {SectionId::Commands, test::section_bytes(commands)},
+                                  {SectionId::Strings, test::section_bytes(strings)},
+                                  {SectionId::StaticLayers, test::section_bytes(layers)},
+                                  {SectionId::StaticLayerData, layer}},
+                                 64, 48);
+}
+
+constexpr RenderStrategy kStrategies[] = {RenderStrategy::TileHeight, RenderStrategy::DirectRgb565};
+
+// A renderer of @p strategy in 16-row tiles, as RenderEngine sets it up
+// apart from the render worker
+std::unique_ptr<GaugeTileRenderer> make_renderer(RenderStrategy strategy, DisplayDriver& display) {
+    if (strategy == RenderStrategy::DirectRgb565) {
+        return std::make_unique<DirectTileRenderer>(display, 16);
+    }
+    auto renderer = std::make_unique<TileHeightRenderer>(display, 16);
+    renderer->set_pipeline_depth(2);
+    return renderer;
+}
+
+// Area the FPS counter may cover on a width x height panel. It is centered,
+// so the widest count, 1000 at 1 ms frames, bounds every other.
+PixelRect fps_overlay_bounds(int width, int height) {
+    std::vector<uint16_t> scratch(static_cast<size_t>(width) * height);
+    return draw_fps_overlay(scratch.data(), width, height, 1000);
+}
+
+} // namespace
+
 TEST_CASE("TileHeightRenderer renders tiles via test callback", "[renderer]") {
-    DisplayDriver display(4, 6);
+    // Tall enough for rows above and below the FPS counter every frame draws
+    const int width = 4;
+    const int height = 48;
+    DisplayDriver display(width, height);
     REQUIRE(display.initialize());
 
     esp_stub_clear_framebuffer();
 
-    TileHeightRenderer renderer(display, 3); // tile height 3 -> two tiles for height 6
+    TileHeightRenderer renderer(display, 24); // two tiles
     REQUIRE(renderer.initialize());
 
     renderer.set_test_render_callback([](uint8_t* target, int width, int height, int stride, int y_offset) {
@@ -36,22 +151,193 @@ TEST_CASE("TileHeightRenderer renders tiles via test callback", "[renderer]") {
     renderer.render_frame();
 
     const auto& fb = esp_stub_get_framebuffer();
-    REQUIRE(fb.size() == 4 * 6);
+    REQUIRE(fb.size() == static_cast<size_t>(width * height));
 
     uint16_t expected_top = digidash::rgba_to_rgb565(10, 20, 30);
     uint16_t expected_bottom = digidash::rgba_to_rgb565(200, 150, 100);
 
-    // top tile rows 0..2
-    for (int y = 0; y < 3; ++y) {
-        for (int x = 0; x < 4; ++x) {
-            REQUIRE(fb[y * 4 + x] == expected_top);
+    // Rows of both tiles outside the counter
+    const PixelRect overlay = fps_overlay_bounds(width, height);
+    REQUIRE(overlay.y0 > 0);
+    REQUIRE(overlay.y1 < height);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (x >= overlay.x0 && x < overlay.x1 && y >= overlay.y0 && y < overlay.y1) {
+                continue;
+            }
+            REQUIRE(fb[y * width + x] == (y < 24 ? expected_top : expected_bottom));
+        }
+    }
+}
+
+TEST_CASE("TileHeightRenderer pipelined mode matches sequential output", "[renderer]") {
+    // Tall enough for rows above and below the FPS counter every frame draws
+    const int width = 4;
+    const int height = 48;
+    DisplayDriver display(width, height);
+    REQUIRE(display.initialize());
+
+    esp_stub_clear_framebuffer();
+
+    // Three tiles through two staging buffers forces a slot to be reused
+    TileHeightRenderer renderer(display, 16);
+    renderer.set_pipeline_depth(2);
+    REQUIRE(renderer.initialize());
+
+    renderer.set_test_render_callback([](uint8_t* target, int width, int height, int stride, int y_offset) {
+        int pixels_per_row = stride / 4;
+        for (int yy = 0; yy < height; ++yy) {
+            for (int xx = 0; xx < width; ++xx) {
+                int i = yy * pixels_per_row + xx;
+                target[i*4 + 0] = static_cast<uint8_t>(5 * (y_offset + yy));
+                target[i*4 + 1] = static_cast<uint8_t>(30 * xx);
+                target[i*4 + 2] = 77;
+                target[i*4 + 3] = 255;
+            }
+        }
+    });
+
+    renderer.render_frame();
+
+    const auto& fb = esp_stub_get_framebuffer();
+    REQUIRE(fb.size() == static_cast<size_t>(width * height));
+    const PixelRect overlay = fps_overlay_bounds(width, height);
+    int checked = 0;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (x >= overlay.x0 && x < overlay.x1 && y >= overlay.y0 && y < overlay.y1) {
+                continue;
+            }
+            REQUIRE(fb[y * width + x] == digidash::rgba_to_rgb565(5 * y, 30 * x, 77));
+            ++checked;
+        }
+    }
+    // Rows of all three tiles are checked
+    REQUIRE(overlay.y0 > 0);
+    REQUIRE(overlay.y1 < height);
+    REQUIRE(checked >= width * height / 2);
+}
+
+TEST_CASE("Tile renderers' steady-state frames do not allocate", "[renderer]") {
+    const std::vector<uint8_t> gauge = make_swept_gauge();
+    for (RenderStrategy strategy : kStrategies) {
+        DisplayDriver display(64, 48);
+        REQUIRE(display.initialize());
+        esp_stub_clear_framebuffer();
+
+        auto renderer = make_renderer(strategy, display);
+        REQUIRE(renderer->initialize());
+        REQUIRE(renderer->load_gauge(gauge.data(), gauge.size()));
+
+        // One full period of the sweep sizes every scratch buffer
+        const int period = 32;
+        auto run_frames = [&](int first, int count) {
+            for (int f = first; f < first + count; ++f) {
+                renderer->set_pid_value(0, 4000.0f + 3900.0f * std::sin(f * 0.2f));
+                renderer->render_frame();
+            }
+        };
+        run_frames(0, period);
+
+        const size_t before = test::allocation_count();
+        run_frames(period, period);
+        REQUIRE(test::allocation_count() == before);
+    }
+}
+
+TEST_CASE("Tile renderers' damage-limited frames match a full redraw", "[renderer]") {
+    const std::vector<uint8_t> gauge = make_swept_gauge();
+    const PixelRect overlay = fps_overlay_bounds(64, 48);
+    for (RenderStrategy strategy : kStrategies) {
+        // Sweeping back and forth leaves stale arc pixels in either
+        // framebuffer unless every damaged rectangle is restored
+        DisplayDriver display(64, 48);
+        REQUIRE(display.initialize());
+        auto renderer = make_renderer(strategy, display);
+        REQUIRE(renderer->initialize());
+        REQUIRE(renderer->load_gauge(gauge.data(), gauge.size()));
+        for (int f = 0; f < 24; ++f) {
+            renderer->set_pid_value(0, 4000.0f + 3900.0f * std::sin(f * 0.5f));
+            renderer->render_frame();
+        }
+        const float last = 4000.0f + 3900.0f * std::sin(23 * 0.5f);
+
+        DisplayDriver fresh_display(64, 48);
+        REQUIRE(fresh_display.initialize());
+        auto fresh = make_renderer(strategy, fresh_display);
+        REQUIRE(fresh->initialize());
+        REQUIRE(fresh->load_gauge(gauge.data(), gauge.size()));
+        fresh->set_pid_value(0, last);
+        fresh->render_frame();
+
+        // The FPS counter differs with frame timing, so it is left out
+        const auto* damaged = reinterpret_cast<const uint16_t*>(display.lock_framebuffer());
+        const auto* full = reinterpret_cast<const uint16_t*>(fresh_display.lock_framebuffer());
+        for (int y = 0; y < 48; ++y) {
+            for (int x = 0; x < 64; ++x) {
+                if (x >= overlay.x0 && x < overlay.x1 && y >= overlay.y0 && y < overlay.y1) {
+                    continue;
+                }
+                REQUIRE(damaged[y * 64 + x] == full[y * 64 + x]);
+            }
+        }
+    }
+}
+
+TEST_CASE("Tile renderers draw a baked static layer instead of the static paths", "[renderer]") {
+    const uint16_t baked = rgba_to_rgb565(0, 200, 0);
+    for (RenderStrategy strategy : kStrategies) {
+        for (bool corrupt : {false, true}) {
+            const std::vector<uint8_t> gauge = make_baked_gauge(baked, corrupt);
+            DisplayDriver display(64, 48);
+            REQUIRE(display.initialize());
+            auto renderer = make_renderer(strategy, display);
+            REQUIRE(renderer->initialize());
+            REQUIRE(renderer->load_gauge(gauge.data(), gauge.size()));
+            renderer->render_frame();
+
+            // A corrupt layer falls back to rasterizing the box
+            const auto* frame = reinterpret_cast<const uint16_t*>(display.lock_framebuffer());
+            REQUIRE(frame[2 * 64 + 2] == (corrupt ? rgba_to_rgb565(40, 90, 40) : baked));
         }
     }
+}
 
-    // bottom tile rows 3..5
-    for (int y = 3; y < 6; ++y) {
-        for (int x = 0; x < 4; ++x) {
-            REQUIRE(fb[y * 4 + x] == expected_bottom);
+TEST_CASE("Tile renderers show a saved static frame before loading", "[renderer]") {
+    const std::vector<uint8_t> gauge = make_swept_gauge();
+    for (RenderStrategy strategy : kStrategies) {
+        DisplayDriver display(64, 48);
+        REQUIRE(display.initialize());
+        auto renderer = make_renderer(strategy, display);
+        REQUIRE(renderer->initialize());
+
+        std::vector<uint8_t> frame;
+        REQUIRE_FALSE(renderer->save_static_frame(frame));
+        REQUIRE(renderer->load_gauge(gauge.data(), gauge.size()));
+        REQUIRE(renderer->save_static_frame(frame));
+        REQUIRE(frame.size() < 64 * 48 * 2);
+
+        // The next boot puts the static image, background included, in both framebuffers
+        std::vector<uint16_t> composed(64 * 48);
+        REQUIRE(rle565_decode(frame.data(), frame.size(), composed.data(), composed.size()));
+        REQUIRE(composed[2 * 64 + 2] != 0);
+
+        DisplayDriver next_display(64, 48);
+        auto next = make_renderer(strategy, next_display);
+        REQUIRE(next->initialize());
+        REQUIRE_FALSE(next->show_static_frame(frame.data(), frame.size()));   // Panel not up yet
+        REQUIRE(next_display.initialize());
+        REQUIRE(next->show_static_frame(frame.data(), frame.size()));
+        for (const void* buffer : {static_cast<const void*>(next_display.lock_framebuffer()),
+                                   static_cast<const void*>(next_display.acquire_back_buffer())}) {
+            REQUIRE(std::memcmp(buffer, composed.data(), composed.size() * sizeof(uint16_t)) == 0);
         }
+
+        // A frame for another display size is refused
+        DisplayDriver other_display(32, 48);
+        REQUIRE(other_display.initialize());
+        auto other = make_renderer(strategy, other_display);
+        REQUIRE(other->initialize());
+        REQUIRE_FALSE(other->show_static_frame(frame.data(), frame.size()));
     }
 }
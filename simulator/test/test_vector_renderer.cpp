@@ -0,0 +1,310 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "digidash/vector_renderer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <vector>
+
+using namespace digidash;
+
+namespace {
+
+using Point = VectorRenderer::Point;
+
+constexpr int kSize = 32;
+
+struct Shape {
+    std::vector<Point> points;
+    std::vector<uint32_t> contour_starts;
+
+    // Appends a closed contour
+    Shape& contour(std::initializer_list<Point> corners) {
+        contour_starts.push_back(static_cast<uint32_t>(points.size()));
+        points.insert(points.end(), corners.begin(), corners.end());
+        points.push_back(*corners.begin());
+        return *this;
+    }
+
+    // Appends an open contour
+    Shape& polyline(std::initializer_list<Point> vertices) {
+        contour_starts.push_back(static_cast<uint32_t>(points.size()));
+        points.insert(points.end(), vertices.begin(), vertices.end());
+        return *this;
+    }
+
+    VectorRenderer::BezierPath stroke(float width, StrokeLineCap cap = StrokeLineCap::Butt,
+                                      uint32_t color = 0xFFFFFFFF) const {
+        VectorRenderer::BezierPath path;
+        path.control_points = points;
+        path.contour_starts = contour_starts;
+        path.color = color;
+        path.stroke_width = width;
+        path.is_filled = false;
+        path.stroke_cap = cap;
+        return path;
+    }
+
+    VectorRenderer::BezierPath fill(FillRule rule = FillRule::NonZero) const {
+        VectorRenderer::BezierPath path;
+        path.control_points = points;
+        path.contour_starts = contour_starts;
+        path.color = 0xFFFFFFFF;
+        path.stroke_width = 0.0f;
+        path.is_filled = true;
+        path.stroke_cap = StrokeLineCap::Butt;
+        path.fill_rule = rule;
+        return path;
+    }
+};
+
+Shape rect(float x0, float y0, float x1, float y1) {
+    return Shape().contour({{x0, y0}, {x1, y0}, {x1, y1}, {x0, y1}});
+}
+
+// Alpha of @p path rendered over a kSize x kSize RGBA buffer filled with
+// @p background; for an opaque colour over 0 this is its coverage
+std::vector<uint8_t> coverage(VectorRenderer& renderer, const VectorRenderer::BezierPath& path,
+                              uint8_t background = 0) {
+    std::vector<uint8_t> rgba(static_cast<size_t>(kSize) * kSize * 4, background);
+    renderer.render_path(path, rgba.data(), kSize, kSize, kSize * 4);
+    std::vector<uint8_t> mask(static_cast<size_t>(kSize) * kSize);
+    for (size_t i = 0; i < mask.size(); ++i) {
+        mask[i] = rgba[i * 4 + 3];
+    }
+    return mask;
+}
+
+uint8_t at(const std::vector<uint8_t>& mask, int x, int y) {
+    return mask[static_cast<size_t>(y) * kSize + x];
+}
+
+struct Extent {
+    int x0 = kSize, y0 = kSize, x1 = -1, y1 = -1;
+
+    bool operator==(const Extent& other) const {
+        return x0 == other.x0 && y0 == other.y0 && x1 == other.x1 && y1 == other.y1;
+    }
+};
+
+// Smallest pixel rectangle holding every covered pixel
+Extent extent(const std::vector<uint8_t>& mask) {
+    Extent e;
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            if (at(mask, x, y) != 0) {
+                e = {std::min(e.x0, x), std::min(e.y0, y), std::max(e.x1, x), std::max(e.y1, y)};
+            }
+        }
+    }
+    return e;
+}
+
+bool near(int actual, int expected, int tolerance = 1) {
+    return std::abs(actual - expected) <= tolerance;
+}
+
+} // namespace
+
+TEST_CASE("VectorRenderer fills half-covered edge pixels by half", "[vector_renderer]") {
+    VectorRenderer renderer;
+    const Shape shape = rect(2.5f, 4.0f, 10.0f, 12.5f);
+    const std::vector<uint8_t> mask = coverage(renderer, shape.fill());
+
+    REQUIRE(at(mask, 1, 8) == 0);
+    REQUIRE(near(at(mask, 2, 8), 128));
+    REQUIRE(at(mask, 3, 8) == 255);
+    REQUIRE(at(mask, 9, 8) == 255);
+    REQUIRE(at(mask, 10, 8) == 0);
+
+    REQUIRE(at(mask, 5, 3) == 0);
+    REQUIRE(at(mask, 5, 4) == 255);
+    REQUIRE(near(at(mask, 5, 12), 128));
+    REQUIRE(at(mask, 5, 13) == 0);
+
+    // Where both edges cross a pixel the coverages multiply
+    REQUIRE(near(at(mask, 2, 12), 64));
+}
+
+TEST_CASE("VectorRenderer fill rules decide nested contours", "[vector_renderer]") {
+    VectorRenderer renderer;
+    Shape same_way = rect(4.0f, 4.0f, 28.0f, 28.0f);
+    same_way.contour({{12.0f, 12.0f}, {20.0f, 12.0f}, {20.0f, 20.0f}, {12.0f, 20.0f}});
+    Shape reversed = rect(4.0f, 4.0f, 28.0f, 28.0f);
+    reversed.contour({{12.0f, 12.0f}, {12.0f, 20.0f}, {20.0f, 20.0f}, {20.0f, 12.0f}});
+
+    // Winding 2 inside the inner contour: filled under non-zero, a hole
+    // under even-odd; a reversed inner contour cuts a hole either way
+    const std::vector<uint8_t> nonzero = coverage(renderer, same_way.fill(FillRule::NonZero));
+    const std::vector<uint8_t> evenodd = coverage(renderer, same_way.fill(FillRule::EvenOdd));
+    const std::vector<uint8_t> cut = coverage(renderer, reversed.fill(FillRule::NonZero));
+    for (const std::vector<uint8_t>* mask : {&nonzero, &evenodd, &cut}) {
+        REQUIRE(at(*mask, 6, 6) == 255);
+        REQUIRE(at(*mask, 2, 16) == 0);
+    }
+    REQUIRE(at(nonzero, 16, 16) == 255);
+    REQUIRE(at(evenodd, 16, 16) == 0);
+    REQUIRE(at(cut, 16, 16) == 0);
+    REQUIRE(evenodd == cut);
+}
+
+TEST_CASE("VectorRenderer fills tiles exactly like one pass", "[vector_renderer]") {
+    VectorRenderer renderer;
+    Shape shape = Shape().contour({{3.3f, 1.7f}, {29.1f, 9.6f}, {17.2f, 30.4f}, {6.8f, 21.9f}});
+    shape.contour({{10.0f, 10.0f}, {14.5f, 20.25f}, {20.0f, 11.0f}});
+
+    for (const FillRule rule : {FillRule::NonZero, FillRule::EvenOdd}) {
+        std::vector<uint8_t> whole(static_cast<size_t>(kSize) * kSize * 4, 0);
+        renderer.render_path(shape.fill(rule), whole.data(), kSize, kSize, kSize * 4);
+
+        // Tile heights that do and do not divide the area
+        for (const int tile_height : {1, 5, 8}) {
+            std::vector<uint8_t> tiled(whole.size(), 0);
+            for (int y = 0; y < kSize; y += tile_height) {
+                const int rows = std::min(tile_height, kSize - y);
+                renderer.render_path(shape.fill(rule), tiled.data() + static_cast<size_t>(y) * kSize * 4, kSize,
+                                     rows, kSize * 4, y);
+            }
+            REQUIRE(tiled == whole);
+        }
+    }
+}
+
+TEST_CASE("VectorRenderer column clip leaves outside pixels untouched", "[vector_renderer]") {
+    VectorRenderer renderer;
+    const Shape shape = Shape().contour({{1.5f, 2.25f}, {30.5f, 6.75f}, {16.0f, 29.5f}});
+    constexpr uint8_t kBackground = 0x5A;
+    const std::vector<uint8_t> whole = coverage(renderer, shape.fill(), kBackground);
+
+    renderer.set_clip_x(9, 21);
+    const std::vector<uint8_t> clipped = coverage(renderer, shape.fill(), kBackground);
+    renderer.reset_clip_x();
+
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            REQUIRE(at(clipped, x, y) == (x >= 9 && x < 21 ? at(whole, x, y) : kBackground));
+        }
+    }
+    REQUIRE(coverage(renderer, shape.fill(), kBackground) == whole);
+}
+
+TEST_CASE("VectorRenderer quality tiers set the fill's vertical samples", "[vector_renderer]") {
+    // Top edge at y = 2.3 and left edge at x = 2.3: row 2 counts the samples
+    // at (k + 0.5) / n below the edge; column 2 is 70% covered, rounded per
+    // sample, except at NoAA, which snaps span ends to pixel centres
+    const Shape shape = rect(2.3f, 2.3f, 24.0f, 24.0f);
+    struct Tier {
+        RenderQuality quality;
+        int top_row;
+        int left_column;
+    };
+    const Tier tiers[] = {
+        {RenderQuality::NoAA, 255, 255},            // 1 sample, at 2.5
+        {RenderQuality::EdgeAA, 128, 180},          // 1 of 2; 2 x 90
+        {RenderQuality::Analytic, 192, 180},        // 3 of 4; 4 x 45
+        {RenderQuality::Supersampled, 176, 176},    // 11 of 16; 16 x 11
+    };
+
+    for (const Tier& tier : tiers) {
+        VectorRenderer renderer;
+        renderer.set_quality(static_cast<int>(tier.quality));
+        const std::vector<uint8_t> mask = coverage(renderer, shape.fill());
+        REQUIRE(at(mask, 12, 1) == 0);
+        REQUIRE(near(at(mask, 12, 2), tier.top_row));
+        REQUIRE(near(at(mask, 2, 12), tier.left_column));
+        REQUIRE(at(mask, 1, 12) == 0);
+        REQUIRE(at(mask, 12, 12) == 255);
+    }
+}
+
+TEST_CASE("VectorRenderer stroke caps reach as far as their style", "[vector_renderer]") {
+    // 4 pixels wide from x = 8 to 24: butt ends there, round and square
+    // caps reach 2 pixels further, and only square fills the corners
+    const Shape line = Shape().polyline({{8.0f, 16.0f}, {24.0f, 16.0f}});
+    struct Cap {
+        StrokeLineCap cap;
+        Extent extent;
+        int end_pixel;      // (6, 16), 1.6 pixels from the end point
+        int corner_pixel;   // (6, 14)
+    };
+    const Cap caps[] = {
+        {StrokeLineCap::Butt, {8, 14, 23, 17}, 0, 0},
+        {StrokeLineCap::Round, {6, 14, 25, 17}, 234, 97},
+        {StrokeLineCap::Square, {6, 14, 25, 17}, 255, 255},
+    };
+
+    for (const Cap& cap : caps) {
+        VectorRenderer renderer;
+        const std::vector<uint8_t> mask = coverage(renderer, line.stroke(4.0f, cap.cap));
+        REQUIRE(extent(mask) == cap.extent);
+        REQUIRE(near(at(mask, 6, 16), cap.end_pixel));
+        REQUIRE(near(at(mask, 6, 14), cap.corner_pixel));
+        REQUIRE(at(mask, 8, 16) == 255);
+        REQUIRE(at(mask, 23, 16) == 255);
+    }
+}
+
+TEST_CASE("VectorRenderer closed contours join at their seam", "[vector_renderer]") {
+    VectorRenderer renderer;
+    const Shape closed = Shape().contour({{8.0f, 8.0f}, {24.0f, 8.0f}, {24.0f, 24.0f}, {8.0f, 24.0f}});
+    const std::vector<uint8_t> mask = coverage(renderer, closed.stroke(3.0f, StrokeLineCap::Butt));
+
+    // The seam at (8, 8) is a join like every other corner: the stroke
+    // is symmetric about the square's centre
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            REQUIRE(at(mask, x, y) == at(mask, kSize - 1 - x, kSize - 1 - y));
+        }
+    }
+    REQUIRE(at(mask, 7, 6) == at(mask, 24, 6));
+    REQUIRE(at(mask, 7, 6) > 0);
+
+    // Stopped short of its start, the contour gets butt caps there and no corner
+    const Shape open = Shape().polyline({{8.0f, 8.0f}, {24.0f, 8.0f}, {24.0f, 24.0f}, {8.0f, 24.0f}, {8.0f, 10.0f}});
+    REQUIRE(at(coverage(renderer, open.stroke(3.0f, StrokeLineCap::Butt)), 7, 6) == 0);
+}
+
+TEST_CASE("VectorRenderer blends each stroke pixel once, joins included", "[vector_renderer]") {
+    // A half-transparent stroke over nothing leaves its own alpha where it
+    // covers fully; a pixel blended twice would come out more opaque
+    constexpr uint32_t kHalfWhite = 0x80FFFFFF;
+    Shape shape = Shape().polyline({{2.0f, 20.0f}, {10.0f, 20.0f}, {16.0f, 12.0f}, {20.0f, 26.0f}, {29.0f, 14.0f}});
+    shape.contour({{4.0f, 3.0f}, {27.0f, 5.0f}, {14.0f, 9.0f}});
+
+    for (const int quality : {0, 1, 2, 3}) {
+        VectorRenderer renderer;
+        renderer.set_quality(quality);
+        const std::vector<uint8_t> alpha = coverage(renderer, shape.stroke(3.0f, StrokeLineCap::Round, kHalfWhite));
+        const uint8_t straight = at(alpha, 5, 20);
+        REQUIRE(straight == 0x80);
+        REQUIRE(*std::max_element(alpha.begin(), alpha.end()) <= straight);
+    }
+
+    // Coverage at a collinear join matches the straight run beside it
+    VectorRenderer renderer;
+    const Shape collinear = Shape().polyline({{4.0f, 16.0f}, {16.0f, 16.0f}, {28.0f, 16.0f}});
+    const std::vector<uint8_t> mask = coverage(renderer, collinear.stroke(3.0f));
+    REQUIRE(near(at(mask, 10, 17), 128));
+    REQUIRE(at(mask, 16, 17) == at(mask, 10, 17));
+}
+
+TEST_CASE("VectorRenderer NoAA strokes threshold the pixel centre", "[vector_renderer]") {
+    VectorRenderer renderer;
+    renderer.set_quality(static_cast<int>(RenderQuality::NoAA));
+
+    // 3 pixels wide on y = 16: only the centres 0.5 pixel away are inside
+    const Shape line = Shape().polyline({{8.0f, 16.0f}, {24.0f, 16.0f}});
+    const std::vector<uint8_t> mask = coverage(renderer, line.stroke(3.0f));
+    REQUIRE(extent(mask) == Extent{8, 15, 23, 16});
+    for (const uint8_t value : mask) {
+        REQUIRE((value == 0 || value == 255));
+    }
+
+    // Hairlines keep a half-pixel radius so they do not vanish between centres
+    const Shape hairline = Shape().polyline({{4.0f, 16.3f}, {28.0f, 16.3f}});
+    const std::vector<uint8_t> thin = coverage(renderer, hairline.stroke(0.5f));
+    REQUIRE(extent(thin) == Extent{4, 16, 27, 16});
+    REQUIRE(at(thin, 12, 16) == 255);
+}
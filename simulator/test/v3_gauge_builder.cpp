@@ -0,0 +1,60 @@
+#include "v3_gauge_builder.h"
+
+#include <algorithm>
+
+namespace digidash {
+namespace test {
+
+using namespace gauge_format;
+
+namespace {
+
+size_t align(size_t offset) {
+    return (offset + kSectionAlignment - 1) / kSectionAlignment * kSectionAlignment;
+}
+
+} // namespace
+
+std::vector<uint8_t> layout_v3_gauge(const std::vector<GaugeSection>& sections, uint32_t width, uint32_t height) {
+    std::vector<SectionEntry> table;
+    size_t offset = align(sizeof(FileHeader) + sections.size() * sizeof(SectionEntry));
+    for (const GaugeSection& section : sections) {
+        table.push_back({static_cast<uint32_t>(section.first), static_cast<uint32_t>(offset),
+                         static_cast<uint32_t>(section.second.size()), 0});
+        offset = align(offset + section.second.size());
+    }
+
+    std::vector<uint8_t> file(offset, 0);
+    const FileHeader header{kMagic, kSectionedVersion, static_cast<uint16_t>(sections.size()), width, height};
+    std::memcpy(file.data(), &header, sizeof(header));
+    std::memcpy(file.data() + sizeof(header), table.data(), table.size() * sizeof(SectionEntry));
+    for (size_t i = 0; i < sections.size(); ++i) {
+        std::copy(sections[i].second.begin(), sections[i].second.end(), file.begin() + table[i].offset);
+    }
+    return file;
+}
+
+uint32_t section_offset(const std::vector<uint8_t>& file, SectionId id) {
+    FileHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    for (uint16_t i = 0; i < header.section_count; ++i) {
+        SectionEntry entry;
+        std::memcpy(&entry, file.data() + sizeof(header) + i * sizeof(SectionEntry), sizeof(entry));
+        if (entry.id == static_cast<uint32_t>(id)) {
+            return entry.offset;
+        }
+    }
+    return 0;
+}
+
+CommandRecord command_record(uint8_t type, float x1, float y1, float x2, float y2, float x3, float y3) {
+    CommandRecord record{};
+    record.type = type;
+    record.x1 = x1; record.y1 = y1;
+    record.x2 = x2; record.y2 = y2;
+    record.x3 = x3; record.y3 = y3;
+    return record;
+}
+
+} // namespace test
+} // namespace digidash
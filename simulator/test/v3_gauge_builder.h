@@ -0,0 +1,49 @@
+#pragma once
+
+#include "digidash/gauge_format.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace digidash {
+namespace test {
+
+using GaugeSection = std::pair<gauge_format::SectionId, std::vector<uint8_t>>;
+
+/**
+ * @brief Raw bytes of a record array, for one GaugeSection
+ */
+template <typename T>
+std::vector<uint8_t> section_bytes(const std::vector<T>& records) {
+    std::vector<uint8_t> bytes(records.size() * sizeof(T));
+    if (!bytes.empty()) {
+        std::memcpy(bytes.data(), records.data(), bytes.size());
+    }
+    return bytes;
+}
+
+inline std::vector<uint8_t> section_bytes(const std::string& strings) {
+    return std::vector<uint8_t>(strings.begin(), strings.end());
+}
+
+/**
+ * @brief A sectioned (v3) gauge file of @p sections, in the order given
+ *
+ * The header and section table come first, then each section on the next
+ * aligned offset, as svg_preprocessor writes them.
+ */
+std::vector<uint8_t> layout_v3_gauge(const std::vector<GaugeSection>& sections, uint32_t width, uint32_t height);
+
+/**
+ * @brief Offset of section @p id in a file from layout_v3_gauge(), for tests that patch records
+ */
+uint32_t section_offset(const std::vector<uint8_t>& file, gauge_format::SectionId id);
+
+gauge_format::CommandRecord command_record(uint8_t type, float x1 = 0, float y1 = 0, float x2 = 0, float y2 = 0,
+                                           float x3 = 0, float y3 = 0);
+
+} // namespace test
+} // namespace digidash
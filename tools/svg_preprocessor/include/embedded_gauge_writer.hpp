@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace digidash {
+
+// Writes a gauge as a C++ header of constexpr arrays that the firmware
+// compiles in and hands to GaugeScene(const GaugeView&): no storage, no
+// parsing, and the arrays stay in flash rodata. Curves are flattened to
+// display pixels for one size first and the points embedded as they are,
+// so at that size the device draws them in place without flattening.
+// Like StaticLayerBaker, kept apart from types.hpp.
+class EmbeddedGaugeWriter {
+public:
+    // gauge_bytes is a serialized gauge; the arrays are declared in
+    // namespace digidash::embedded::<name>, ending with a GaugeView kView.
+    // The baked static layer for width x height, if any, is embedded too.
+    void write_header(const std::vector<uint8_t>& gauge_bytes, uint16_t width, uint16_t height,
+                      const std::string& name, const std::string& out_path);
+};
+
+} // namespace digidash
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace digidash {
+
+// Renders a gauge's static (non-animated) layer with the engine, exactly
+// as the firmware's tile renderer would build its static cache, and
+// compresses it as RLE RGB565. Kept apart from types.hpp, whose types
+// share names with the engine's.
+class StaticLayerBaker {
+public:
+    // gauge_bytes is a serialized gauge without static layers
+    std::vector<uint8_t> bake(const std::vector<uint8_t>& gauge_bytes, uint16_t width, uint16_t height);
+};
+
+} // namespace digidash
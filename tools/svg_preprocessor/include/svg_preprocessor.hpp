@@ -42,6 +42,7 @@ public:
 
 class GaugeSerializer {
 public:
+    std::vector<uint8_t> serialize(const GaugeDocument& doc);
     void write_binary(const GaugeDocument& doc, const std::string& out_path);
 };
 
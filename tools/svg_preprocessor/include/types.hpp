@@ -6,6 +6,10 @@
 
 namespace digidash {
 
+// The engine has its own Path, Color and so on, and the static layer baker
+// links both; the inline namespace keeps their symbols apart.
+inline namespace preproc {
+
 struct Color {
     uint8_t r{0}, g{0}, b{0}, a{255};
 };
@@ -56,11 +60,20 @@ struct PathAnimationBinding {
     std::string pid;
 };
 
+// Static layer pre-rendered for one display size, RLE RGB565
+struct StaticLayerImage {
+    uint16_t width{0};
+    uint16_t height{0};
+    std::vector<uint8_t> rle565;
+};
+
 struct GaugeDocument {
     float width{0.0f};
     float height{0.0f};
     std::vector<Path> paths;
     std::vector<PathAnimationBinding> animations;
+    std::vector<StaticLayerImage> static_layers;
 };
 
-} // namespace digidash
\ No newline at end of file
+} // namespace preproc
+} // namespace digidash
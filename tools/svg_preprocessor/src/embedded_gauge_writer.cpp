@@ -0,0 +1,337 @@
+#include "embedded_gauge_writer.hpp"
+
+#include "digidash/binary_gauge_loader.h"
+#include "digidash/path_tessellator.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace digidash {
+
+namespace {
+    using Point = VectorRenderer::Point;
+
+    // As GaugeScene flattens curves at a viewport
+    constexpr float kFlattenTolerance = 0.2f;
+    constexpr float kSimplifyTolerance = 0.1f;
+
+    Point lerp(const Point& a, const Point& b, float t) {
+        return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t};
+    }
+
+    // Parameters in (0, 1) where one coordinate of a cubic turns
+    void add_turning_points(float p0, float p1, float p2, float p3, std::vector<float>& out) {
+        const float a = -p0 + 3.0f * p1 - 3.0f * p2 + p3;
+        const float b = 2.0f * (p0 - 2.0f * p1 + p2);
+        const float c = p1 - p0;
+        auto add = [&out](float t) {
+            if (t > 1e-4f && t < 1.0f - 1e-4f) {
+                out.push_back(t);
+            }
+        };
+        if (std::fabs(a) < 1e-6f) {
+            if (std::fabs(b) > 1e-6f) {
+                add(-c / b);
+            }
+            return;
+        }
+        const float discriminant = b * b - 4.0f * a * c;
+        if (discriminant >= 0.0f) {
+            const float root = std::sqrt(discriminant);
+            add((-b + root) / (2.0f * a));
+            add((-b - root) / (2.0f * a));
+        }
+    }
+
+    // Cubics are split where x or y turns, so every extreme of a curve is a
+    // flattened point. GaugeScene fits the viewport to the bounds of the
+    // embedded points, which then match the curves' and give the same fit.
+    std::vector<PathCommand> split_at_extrema(const PathCommand* commands, size_t count) {
+        std::vector<PathCommand> out;
+        Point current{0.0f, 0.0f};
+        Point contour_first = current;
+        for (size_t i = 0; i < count; ++i) {
+            const PathCommand& cmd = commands[i];
+            switch (cmd.type) {
+                case PathCommand::Type::MoveTo:
+                    current = contour_first = {cmd.x1, cmd.y1};
+                    out.push_back(cmd);
+                    break;
+
+                case PathCommand::Type::LineTo:
+                    current = {cmd.x1, cmd.y1};
+                    out.push_back(cmd);
+                    break;
+
+                case PathCommand::Type::Close:
+                    current = contour_first;
+                    out.push_back(cmd);
+                    break;
+
+                case PathCommand::Type::CubicTo: {
+                    std::vector<float> splits;
+                    add_turning_points(current.x, cmd.x1, cmd.x2, cmd.x3, splits);
+                    add_turning_points(current.y, cmd.y1, cmd.y2, cmd.y3, splits);
+                    std::sort(splits.begin(), splits.end());
+
+                    // de Casteljau, cutting the remaining curve at each split
+                    Point p0 = current, p1{cmd.x1, cmd.y1}, p2{cmd.x2, cmd.y2};
+                    const Point p3{cmd.x3, cmd.y3};
+                    float done = 0.0f;
+                    for (const float split : splits) {
+                        const float t = (split - done) / (1.0f - done);
+                        const Point a = lerp(p0, p1, t), b = lerp(p1, p2, t), c = lerp(p2, p3, t);
+                        const Point ab = lerp(a, b, t), bc = lerp(b, c, t);
+                        const Point mid = lerp(ab, bc, t);
+                        out.push_back({PathCommand::Type::CubicTo, a.x, a.y, ab.x, ab.y, mid.x, mid.y});
+                        p0 = mid;
+                        p1 = bc;
+                        p2 = c;
+                        done = split;
+                    }
+                    out.push_back({PathCommand::Type::CubicTo, p1.x, p1.y, p2.x, p2.y, p3.x, p3.y});
+                    current = p3;
+                    break;
+                }
+            }
+        }
+        return out;
+    }
+
+    std::string float_literal(float value) {
+        if (!std::isfinite(value)) {
+            throw std::runtime_error("Embedded gauge: coordinate is not finite");
+        }
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.9g", value);
+        std::string literal = text;
+        if (literal.find_first_of(".e") == std::string::npos) {
+            literal += ".0";
+        }
+        return literal + "f";
+    }
+
+    std::string string_literal(const char* data, size_t size) {
+        std::string literal = "\"";
+        for (size_t i = 0; i < size; ++i) {
+            const unsigned char c = static_cast<unsigned char>(data[i]);
+            if (c == '"' || c == '\\') {
+                literal += '\\';
+                literal += static_cast<char>(c);
+            } else if (std::isprint(c)) {
+                literal += static_cast<char>(c);
+            } else {
+                char escape[8];
+                std::snprintf(escape, sizeof(escape), "\\%03o", c);
+                literal += escape;
+            }
+        }
+        return literal + "\"";
+    }
+
+    std::string rgba_literal(const uint8_t rgba[4]) {
+        std::ostringstream os;
+        os << "{" << unsigned(rgba[0]) << ", " << unsigned(rgba[1]) << ", " << unsigned(rgba[2]) << ", "
+           << unsigned(rgba[3]) << "}";
+        return os.str();
+    }
+
+    std::string ref_literal(const gauge_format::StringRef& ref) {
+        return "{" + std::to_string(ref.offset) + ", " + std::to_string(ref.length) + "}";
+    }
+
+    const char* command_type_name(PathCommand::Type type) {
+        return type == PathCommand::Type::MoveTo ? "MoveTo" : "LineTo";
+    }
+
+    std::string symbol_name(const std::string& name) {
+        std::string symbol;
+        for (const char c : name) {
+            symbol += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+        }
+        if (symbol.empty() || std::isdigit(static_cast<unsigned char>(symbol[0]))) {
+            symbol.insert(symbol.begin(), '_');
+        }
+        return symbol;
+    }
+}
+
+void EmbeddedGaugeWriter::write_header(const std::vector<uint8_t>& gauge_bytes, uint16_t width, uint16_t height,
+                                       const std::string& name, const std::string& out_path) {
+    BinaryGaugeLoader loader;
+    GaugeView view;
+    if (!loader.map_view(gauge_bytes.data(), gauge_bytes.size(), view)) {
+        throw std::runtime_error("Embedded gauge: serialized gauge does not map");
+    }
+
+    // Flatten every path at the display size, with the fit GaugeScene uses
+    std::vector<PathCommand> commands;
+    std::vector<TessellationRange> ranges(view.path_count);
+    for (size_t i = 0; i < view.path_count; ++i) {
+        const gauge_format::PathRecord& record = view.paths[i];
+        const std::vector<PathCommand> split =
+            split_at_extrema(view.commands + record.command_offset, record.command_count);
+        ranges[i] = TessellationRange{static_cast<uint32_t>(commands.size()), static_cast<uint32_t>(split.size()),
+                                      0, 0, 0, 0};
+        commands.insert(commands.end(), split.begin(), split.end());
+    }
+
+    constexpr float kInf = std::numeric_limits<float>::infinity();
+    float min_x = kInf, min_y = kInf, max_x = -kInf, max_y = -kInf;
+    for (const PathCommand& cmd : commands) {
+        if (cmd.type == PathCommand::Type::Close) {
+            continue;
+        }
+        const float x = cmd.type == PathCommand::Type::CubicTo ? cmd.x3 : cmd.x1;
+        const float y = cmd.type == PathCommand::Type::CubicTo ? cmd.y3 : cmd.y1;
+        min_x = std::min(min_x, x);
+        min_y = std::min(min_y, y);
+        max_x = std::max(max_x, x);
+        max_y = std::max(max_y, y);
+    }
+
+    TessellationTransform fit;
+    if (!commands.empty() && view.width != 0 && view.height != 0) {
+        const float source_width = std::max(1.0f, max_x - min_x);
+        const float source_height = std::max(1.0f, max_y - min_y);
+        fit.scale = std::min(width / source_width, height / source_height);
+        fit.min_x = min_x;
+        fit.min_y = min_y;
+        fit.offset_x = (width - source_width * fit.scale) * 0.5f;
+        fit.offset_y = (height - source_height * fit.scale) * 0.5f;
+    }
+
+    std::vector<Point> points;
+    std::vector<uint32_t> contours;
+    tessellate_paths(commands.data(), ranges.data(), ranges.size(), fit, kFlattenTolerance, points, contours);
+    simplify_paths(ranges.data(), ranges.size(), kSimplifyTolerance, points, contours);
+
+    const std::string symbol = symbol_name(name);
+    std::ostringstream os;
+    os << "// Generated by svg_preprocessor: gauge flattened for a " << width << "x" << height
+       << " display. Do not edit.\n"
+       << "#pragma once\n\n"
+       << "#include \"digidash/binary_gauge_loader.h\"\n\n"
+       << "namespace digidash {\n"
+       << "namespace embedded {\n"
+       << "namespace " << symbol << " {\n\n";
+
+    os << "inline constexpr char kStrings[] = " << string_literal(view.strings, view.strings_size) << ";\n\n";
+
+    // Each contour becomes a MoveTo and LineTos through its flattened points
+    size_t command_count = 0;
+    if (view.path_count > 0) {
+        std::ostringstream command_lines;
+        os << "inline constexpr gauge_format::PathRecord kPaths[] = {\n";
+        for (size_t i = 0; i < view.path_count; ++i) {
+            const gauge_format::PathRecord& record = view.paths[i];
+            const TessellationRange& range = ranges[i];
+            const size_t first_command = command_count;
+            for (uint32_t c = 0; c < range.contour_count; ++c) {
+                const uint32_t begin = contours[range.contour_offset + c];
+                const uint32_t end =
+                    c + 1 < range.contour_count ? contours[range.contour_offset + c + 1] : range.point_count;
+                for (uint32_t p = begin; p < end; ++p) {
+                    const Point& point = points[range.point_offset + p];
+                    command_lines << "    {PathCommand::Type::"
+                                  << command_type_name(p == begin ? PathCommand::Type::MoveTo
+                                                                  : PathCommand::Type::LineTo)
+                                  << ", " << float_literal(point.x) << ", " << float_literal(point.y)
+                                  << ", 0.0f, 0.0f, 0.0f, 0.0f},\n";
+                    ++command_count;
+                }
+            }
+            os << "    {" << ref_literal(record.id) << ", " << first_command << ", " << command_count - first_command
+               << ", " << float_literal(record.stroke_width) << ", " << rgba_literal(record.stroke_rgba) << ", "
+               << rgba_literal(record.fill_rgba) << ", " << unsigned(record.stroke_cap) << ", "
+               << unsigned(record.fill_enabled) << ", {0, 0}},\n";
+        }
+        os << "};\n\n";
+        if (command_count > 0) {
+            os << "inline constexpr PathCommand kCommands[] = {\n" << command_lines.str() << "};\n\n";
+        }
+    }
+
+    // The same points as drawn at this size: GaugeScene reads them in place
+    // and only flattens the commands above for another viewport
+    if (view.path_count > 0) {
+        os << "inline constexpr FlattenedPathRange kFlattenedPaths[] = {\n";
+        for (const TessellationRange& range : ranges) {
+            os << "    {" << range.point_offset << ", " << range.point_count << ", " << range.contour_offset << ", "
+               << range.contour_count << "},\n";
+        }
+        os << "};\n\n";
+    }
+    if (!points.empty()) {
+        os << "inline constexpr VectorRenderer::Point kFlattenedPoints[] = {\n";
+        for (const Point& point : points) {
+            os << "    {" << float_literal(point.x) << ", " << float_literal(point.y) << "},\n";
+        }
+        os << "};\n\n";
+    }
+    if (!contours.empty()) {
+        os << "inline constexpr uint32_t kFlattenedContours[] = {";
+        for (size_t i = 0; i < contours.size(); ++i) {
+            os << (i % 16 == 0 ? "\n    " : " ") << contours[i] << ",";
+        }
+        os << "\n};\n\n";
+    }
+
+    if (view.animation_count > 0) {
+        os << "inline constexpr gauge_format::AnimationRecord kAnimations[] = {\n";
+        for (size_t i = 0; i < view.animation_count; ++i) {
+            const gauge_format::AnimationRecord& record = view.animations[i];
+            os << "    {" << ref_literal(record.path_id) << ", " << ref_literal(record.pid_name) << ", "
+               << unsigned(record.type) << ", {0, 0, 0}, " << float_literal(record.min_value) << ", "
+               << float_literal(record.max_value) << "},\n";
+        }
+        os << "};\n\n";
+    }
+
+    const gauge_format::StaticLayerRecord* layer = view.find_static_layer(width, height);
+    if (layer) {
+        os << "inline constexpr gauge_format::StaticLayerRecord kStaticLayers[] = {\n"
+           << "    {" << width << ", " << height << ", 0, " << layer->data_size << ", 0},\n"
+           << "};\n\n"
+           << "alignas(4) inline constexpr uint8_t kStaticLayerData[] = {";
+        const uint8_t* data = view.static_layer_data + layer->data_offset;
+        for (uint32_t i = 0; i < layer->data_size; ++i) {
+            char byte[8];
+            std::snprintf(byte, sizeof(byte), "0x%02x,", data[i]);
+            os << (i % 16 == 0 ? "\n    " : " ") << byte;
+        }
+        os << "\n};\n\n";
+    }
+
+    auto array_or_null = [](bool present, const char* array) { return present ? array : "nullptr"; };
+    os << "inline constexpr GaugeView kView = {\n"
+       << "    " << width << ", " << height << ",\n"
+       << "    " << array_or_null(view.path_count > 0, "kPaths") << ", " << view.path_count << ",\n"
+       << "    " << array_or_null(command_count > 0, "kCommands") << ", " << command_count << ",\n"
+       << "    " << array_or_null(view.animation_count > 0, "kAnimations") << ", " << view.animation_count << ",\n"
+       << "    kStrings, " << view.strings_size << ",\n"
+       << "    " << array_or_null(layer, "kStaticLayers") << ", " << (layer ? 1 : 0) << ",\n"
+       << "    " << array_or_null(layer, "kStaticLayerData") << ", " << (layer ? layer->data_size : 0) << ",\n"
+       << "    " << width << ", " << height << ",\n"
+       << "    " << array_or_null(view.path_count > 0, "kFlattenedPaths") << ",\n"
+       << "    " << array_or_null(!points.empty(), "kFlattenedPoints") << ", " << points.size() << ",\n"
+       << "    " << array_or_null(!contours.empty(), "kFlattenedContours") << ", " << contours.size() << ",\n"
+       << "};\n\n"
+       << "} // namespace " << symbol << "\n"
+       << "} // namespace embedded\n"
+       << "} // namespace digidash\n";
+
+    std::ofstream file(out_path);
+    if (!file) {
+        throw std::runtime_error("Failed to open output file: " + out_path);
+    }
+    file << os.str();
+}
+
+} // namespace digidash
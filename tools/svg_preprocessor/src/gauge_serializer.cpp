@@ -1,71 +1,158 @@
 #include "svg_preprocessor.hpp"
+#include "digidash/gauge_format.h"
+#include <cstring>
 #include <fstream>
 #include <stdexcept>
 
 namespace digidash {
 
 namespace {
-    void write_u8(std::ofstream& os, uint8_t v) { os.write(reinterpret_cast<const char*>(&v), 1); }
-    void write_u16(std::ofstream& os, uint16_t v) { os.write(reinterpret_cast<const char*>(&v), sizeof(v)); }
-    void write_f32(std::ofstream& os, float v) { os.write(reinterpret_cast<const char*>(&v), sizeof(v)); }
-}
+    struct Section {
+        gauge_format::SectionId id;
+        const void* data;
+        size_t size;
+    };
 
-void GaugeSerializer::write_binary(const GaugeDocument& doc, const std::string& out_path) {
-    std::ofstream os(out_path, std::ios::binary);
-    if (!os) {
-        throw std::runtime_error("Failed to open output file: " + out_path);
+    template <typename T>
+    Section section_of(gauge_format::SectionId id, const std::vector<T>& records) {
+        return Section{id, records.data(), records.size() * sizeof(T)};
+    }
+
+    size_t align_section(size_t offset) {
+        const size_t alignment = gauge_format::kSectionAlignment;
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    uint32_t checked_u32(size_t value, const char* what) {
+        if (value > UINT32_MAX) {
+            throw std::runtime_error(std::string(what) + " does not fit a gauge file");
+        }
+        return static_cast<uint32_t>(value);
+    }
+
+    void copy_rgba(const Color& color, uint8_t out[4]) {
+        out[0] = color.r;
+        out[1] = color.g;
+        out[2] = color.b;
+        out[3] = color.a;
     }
+}
+
+std::vector<uint8_t> GaugeSerializer::serialize(const GaugeDocument& doc) {
+    using namespace gauge_format;
+
+    std::string strings;
+    auto add_string = [&strings](const std::string& text) {
+        const StringRef ref{checked_u32(strings.size(), "String table"), checked_u32(text.size(), "String")};
+        strings += text;
+        return ref;
+    };
+
+    // Flat, zero-padded records that the firmware maps in place
+    std::vector<PathRecord> paths(doc.paths.size());
+    std::vector<CommandRecord> commands;
+    for (size_t i = 0; i < doc.paths.size(); ++i) {
+        const Path& path = doc.paths[i];
+        PathRecord& record = paths[i];
+        std::memset(&record, 0, sizeof(record));
+        record.id = add_string(path.id);
+        record.command_offset = checked_u32(commands.size(), "Command count");
+        record.command_count = checked_u32(path.commands.size(), "Path command count");
+        record.stroke_width = path.stroke.width;
+        copy_rgba(path.stroke.color, record.stroke_rgba);
+        copy_rgba(path.fill.color, record.fill_rgba);
+        record.stroke_cap = static_cast<uint8_t>(path.stroke.cap);
+        record.fill_enabled = path.fill.enabled ? 1 : 0;
 
-    // Header: magic + version + path_count + width + height
-    const char magic[4] = {'D', 'G', 'G', 'E'};
-    os.write(magic, 4);
-    uint16_t version = 2;
-    write_u16(os, version);
-    write_u16(os, static_cast<uint16_t>(doc.paths.size()));
-    write_u16(os, static_cast<uint16_t>(doc.width));
-    write_u16(os, static_cast<uint16_t>(doc.height));
-
-    for (const auto& path : doc.paths) {
-        uint8_t id_len = static_cast<uint8_t>(path.id.size());
-        write_u8(os, id_len);
-        os.write(path.id.data(), id_len);
-
-        write_f32(os, path.stroke.width);
-        write_u8(os, path.stroke.color.r);
-        write_u8(os, path.stroke.color.g);
-        write_u8(os, path.stroke.color.b);
-        write_u8(os, path.stroke.color.a);
-        write_u8(os, static_cast<uint8_t>(path.stroke.cap));
-
-        write_u8(os, path.fill.enabled ? 1 : 0);
-        write_u8(os, path.fill.color.r);
-        write_u8(os, path.fill.color.g);
-        write_u8(os, path.fill.color.b);
-        write_u8(os, path.fill.color.a);
-
-        write_u16(os, static_cast<uint16_t>(path.commands.size()));
         for (const auto& cmd : path.commands) {
-            write_u8(os, static_cast<uint8_t>(cmd.type));
-            write_f32(os, cmd.x1);
-            write_f32(os, cmd.y1);
-            write_f32(os, cmd.x2);
-            write_f32(os, cmd.y2);
-            write_f32(os, cmd.x3);
-            write_f32(os, cmd.y3);
+            CommandRecord command;
+            std::memset(&command, 0, sizeof(command));
+            command.type = static_cast<uint8_t>(cmd.type);
+            command.x1 = cmd.x1;
+            command.y1 = cmd.y1;
+            command.x2 = cmd.x2;
+            command.y2 = cmd.y2;
+            command.x3 = cmd.x3;
+            command.y3 = cmd.y3;
+            commands.push_back(command);
         }
     }
 
-    // Animation section (v2+)
-    write_u16(os, static_cast<uint16_t>(doc.animations.size()));
-    for (const auto& anim : doc.animations) {
-        write_u8(os, static_cast<uint8_t>(anim.path_id.size()));
-        os.write(anim.path_id.data(), static_cast<std::streamsize>(anim.path_id.size()));
-        write_u8(os, static_cast<uint8_t>(anim.type));
-        write_f32(os, anim.min_value);
-        write_f32(os, anim.max_value);
-        write_u8(os, static_cast<uint8_t>(anim.pid.size()));
-        os.write(anim.pid.data(), static_cast<std::streamsize>(anim.pid.size()));
+    std::vector<AnimationRecord> animations(doc.animations.size());
+    for (size_t i = 0; i < doc.animations.size(); ++i) {
+        const PathAnimationBinding& anim = doc.animations[i];
+        AnimationRecord& record = animations[i];
+        std::memset(&record, 0, sizeof(record));
+        record.path_id = add_string(anim.path_id);
+        record.pid_name = add_string(anim.pid);
+        record.type = static_cast<uint8_t>(anim.type);
+        record.min_value = anim.min_value;
+        record.max_value = anim.max_value;
+    }
+
+    std::vector<StaticLayerRecord> layers(doc.static_layers.size());
+    std::vector<uint8_t> layer_data;
+    for (size_t i = 0; i < doc.static_layers.size(); ++i) {
+        const StaticLayerImage& layer = doc.static_layers[i];
+        StaticLayerRecord& record = layers[i];
+        std::memset(&record, 0, sizeof(record));
+        record.width = layer.width;
+        record.height = layer.height;
+        record.data_offset = checked_u32(layer_data.size(), "Static layer data");
+        record.data_size = checked_u32(layer.rle565.size(), "Static layer");
+        layer_data.insert(layer_data.end(), layer.rle565.begin(), layer.rle565.end());
+    }
+
+    // Small sections first, then the bulk ones, so the file can be
+    // streamed front to back (GaugeStreamReader)
+    std::vector<Section> sections = {
+        Section{SectionId::Strings, strings.data(), strings.size()},
+        section_of(SectionId::Paths, paths),
+        section_of(SectionId::Animations, animations),
+    };
+    if (!layers.empty()) {
+        sections.push_back(section_of(SectionId::StaticLayers, layers));
+    }
+    sections.push_back(section_of(SectionId::Commands, commands));
+    if (!layers.empty()) {
+        sections.push_back(section_of(SectionId::StaticLayerData, layer_data));
+    }
+
+    // Header: magic + version + section table, then each section aligned
+    FileHeader header{};
+    header.magic = kMagic;
+    header.version = kSectionedVersion;
+    header.section_count = static_cast<uint16_t>(sections.size());
+    header.width = static_cast<uint32_t>(doc.width);
+    header.height = static_cast<uint32_t>(doc.height);
+
+    std::vector<SectionEntry> table(sections.size());
+    size_t offset = align_section(sizeof(FileHeader) + table.size() * sizeof(SectionEntry));
+    for (size_t i = 0; i < sections.size(); ++i) {
+        table[i] = SectionEntry{static_cast<uint32_t>(sections[i].id), checked_u32(offset, "Gauge file"),
+                                checked_u32(sections[i].size, "Section"), 0};
+        offset = align_section(offset + sections[i].size);
+    }
+
+    std::vector<uint8_t> out(offset, 0);
+    std::memcpy(out.data(), &header, sizeof(header));
+    std::memcpy(out.data() + sizeof(header), table.data(), table.size() * sizeof(SectionEntry));
+    for (size_t i = 0; i < sections.size(); ++i) {
+        if (sections[i].size != 0) {
+            std::memcpy(out.data() + table[i].offset, sections[i].data, sections[i].size);
+        }
+    }
+    return out;
+}
+
+void GaugeSerializer::write_binary(const GaugeDocument& doc, const std::string& out_path) {
+    const std::vector<uint8_t> bytes = serialize(doc);
+
+    std::ofstream os(out_path, std::ios::binary);
+    if (!os) {
+        throw std::runtime_error("Failed to open output file: " + out_path);
     }
+    os.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
 }
 
-} // namespace digidash
\ No newline at end of file
+} // namespace digidash
@@ -5,6 +5,9 @@
 #include <fstream>
 #include <regex>
 #include <sstream>
+#include <utility>
+#include "embedded_gauge_writer.hpp"
+#include "static_layer_baker.hpp"
 #include "svg_preprocessor.hpp"
 
 namespace {
@@ -58,17 +61,63 @@ void load_sidecar_animation_config(const std::string& input_svg, digidash::Gauge
               << json_path.string() << "\n";
 }
 
+// "720x720" -> 720, 720
+bool parse_resolution(const std::string& text, uint16_t& width, uint16_t& height) {
+    const std::regex resolution_regex(R"(([0-9]{1,5})x([0-9]{1,5}))");
+    std::smatch match;
+    if (!std::regex_match(text, match, resolution_regex)) {
+        return false;
+    }
+    const unsigned long w = std::stoul(match[1].str());
+    const unsigned long h = std::stoul(match[2].str());
+    if (w == 0 || h == 0 || w > 65535 || h > 65535) {
+        return false;
+    }
+    width = static_cast<uint16_t>(w);
+    height = static_cast<uint16_t>(h);
+    return true;
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
+    const char* usage = "Usage: svg_preprocessor input.svg output.gauge [--static-layer WIDTHxHEIGHT]...\n"
+                        "                        [--embed WIDTHxHEIGHT header.h]\n";
     if (argc < 3) {
-        std::cerr << "Usage: svg_preprocessor input.svg output.gauge\n";
+        std::cerr << usage;
         return 1;
     }
 
     const std::string input_svg = argv[1];
     const std::string output_bin = argv[2];
 
+    // Display sizes to pre-render the static layer at
+    std::vector<std::pair<uint16_t, uint16_t>> static_layer_sizes;
+    // Header to compile the gauge into firmware with, and its display size
+    std::string embed_header;
+    std::pair<uint16_t, uint16_t> embed_size;
+    for (int i = 3; i < argc; ++i) {
+        const std::string arg = argv[i];
+        uint16_t width = 0, height = 0;
+        if (arg == "--static-layer" && i + 1 < argc && parse_resolution(argv[i + 1], width, height)) {
+            static_layer_sizes.emplace_back(width, height);
+            ++i;
+        } else if (arg == "--embed" && i + 2 < argc && parse_resolution(argv[i + 1], width, height)) {
+            embed_size = {width, height};
+            embed_header = argv[i + 2];
+            i += 2;
+        } else {
+            std::cerr << usage;
+            return 1;
+        }
+    }
+
+    // An embedded gauge always carries its static layer
+    if (!embed_header.empty() &&
+        std::find(static_layer_sizes.begin(), static_layer_sizes.end(), embed_size) == static_layer_sizes.end()) {
+        static_layer_sizes.push_back(embed_size);
+    }
+
     try {
         digidash::SvgLoader loader;
         digidash::SvgNormalizer normalizer;
@@ -79,9 +128,33 @@ int main(int argc, char** argv) {
         normalizer.normalize(doc);
         flattener.flatten(doc);
         load_sidecar_animation_config(input_svg, doc);
+
+        if (!static_layer_sizes.empty()) {
+            // Bake from the serialized gauge, so the pixels match what the
+            // device renders from the same file
+            digidash::StaticLayerBaker baker;
+            const std::vector<uint8_t> gauge_bytes = serializer.serialize(doc);
+            for (const auto& size : static_layer_sizes) {
+                digidash::StaticLayerImage layer;
+                layer.width = size.first;
+                layer.height = size.second;
+                layer.rle565 = baker.bake(gauge_bytes, layer.width, layer.height);
+                std::cout << "Baked static layer " << layer.width << "x" << layer.height << ": "
+                          << layer.rle565.size() << " bytes ("
+                          << static_cast<size_t>(layer.width) * layer.height * 2 << " raw)\n";
+                doc.static_layers.push_back(std::move(layer));
+            }
+        }
         serializer.write_binary(doc, output_bin);
 
         std::cout << "Wrote gauge file: " << output_bin << "\n";
+
+        if (!embed_header.empty()) {
+            digidash::EmbeddedGaugeWriter writer;
+            writer.write_header(serializer.serialize(doc), embed_size.first, embed_size.second,
+                                std::filesystem::path(embed_header).stem().string(), embed_header);
+            std::cout << "Wrote embedded gauge header: " << embed_header << "\n";
+        }
     } catch (const std::exception& ex) {
         std::cerr << "Error: " << ex.what() << "\n";
         return 1;
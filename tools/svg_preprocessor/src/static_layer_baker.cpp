@@ -0,0 +1,43 @@
+#include "static_layer_baker.hpp"
+
+#include "digidash/binary_gauge_loader.h"
+#include "digidash/gauge_scene.h"
+#include "digidash/rle565.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace digidash {
+
+std::vector<uint8_t> StaticLayerBaker::bake(const std::vector<uint8_t>& gauge_bytes, uint16_t width,
+                                            uint16_t height) {
+    BinaryGaugeLoader loader;
+    BinaryGaugeLoader::GaugeAsset asset;
+    if (!loader.load_from_buffer(gauge_bytes.data(), gauge_bytes.size(), asset)) {
+        throw std::runtime_error("Static layer bake: serialized gauge does not load");
+    }
+
+    GaugeScene scene;
+    if (!scene.load_gauge(asset)) {
+        throw std::runtime_error("Static layer bake: gauge scene rejected the asset");
+    }
+    scene.set_viewport(width, height);
+
+    // Same steps as the firmware's static cache: straight into RGB565 over
+    // black. The RGBA path is in the simulator's BGR order on the host.
+    const size_t pixel_count = static_cast<size_t>(width) * height;
+    std::vector<uint16_t> rgb565(pixel_count, 0);
+    scene.render_static(reinterpret_cast<uint8_t*>(rgb565.data()), width, height, width * sizeof(uint16_t), 0,
+                        PixelFormat::RGB565);
+
+    std::vector<uint8_t> encoded;
+    rle565_encode(rgb565.data(), pixel_count, encoded);
+    if (encoded.size() > UINT32_MAX) {
+        throw std::runtime_error("Static layer bake: " + std::to_string(width) + "x" +
+                                 std::to_string(height) + " layer is too large");
+    }
+    return encoded;
+}
+
+} // namespace digidash